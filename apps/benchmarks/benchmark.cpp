@@ -0,0 +1,44 @@
+#include "benchmark.hpp"
+
+#include <cstdlib>
+
+namespace Benchmarks
+{
+    float random(float min, float max)
+    {
+        return min + (max - min) * static_cast<float>(std::rand()) / RAND_MAX;
+    }
+
+    CullTraversal::CullTraversal()
+        : mFrameStamp(new osg::FrameStamp)
+        , mCullVisitor(new osgUtil::CullVisitor)
+        , mStateGraph(new osgUtil::StateGraph)
+        , mRenderStage(new osgUtil::RenderStage)
+        , mViewport(new osg::Viewport(0, 0, 1280, 720))
+    {
+        mCullVisitor->setFrameStamp(mFrameStamp);
+        mCullVisitor->setCullingMode(osg::CullSettings::NO_CULLING);
+    }
+
+    void CullTraversal::startFrame(unsigned int frame)
+    {
+        mFrameStamp->setFrameNumber(frame);
+        mCullVisitor->setTraversalNumber(frame);
+    }
+
+    void CullTraversal::cull(osg::Node& root)
+    {
+        mCullVisitor->reset();
+        mStateGraph->clean();
+        mRenderStage->reset();
+        mCullVisitor->setStateGraph(mStateGraph);
+        mCullVisitor->setRenderStage(mRenderStage);
+        mCullVisitor->pushViewport(mViewport);
+        mCullVisitor->pushProjectionMatrix(new osg::RefMatrix(osg::Matrix::perspective(60, 16.0 / 9.0, 1, 10000)));
+        mCullVisitor->pushModelViewMatrix(new osg::RefMatrix(osg::Matrix::identity()), osg::Transform::ABSOLUTE_RF);
+        root.accept(*mCullVisitor);
+        mCullVisitor->popModelViewMatrix();
+        mCullVisitor->popProjectionMatrix();
+        mCullVisitor->popViewport();
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef OPENMW_BENCHMARKS_BENCHMARK_H
+#define OPENMW_BENCHMARKS_BENCHMARK_H
+
+#include <chrono>
+
+#include <osg/FrameStamp>
+#include <osg/Viewport>
+#include <osgUtil/CullVisitor>
+#include <osgUtil/RenderStage>
+#include <osgUtil/StateGraph>
+
+namespace Benchmarks
+{
+    /// Uniformly distributed value in [min, max] from std::rand, seed it with std::srand for repeatable runs.
+    float random(float min, float max);
+
+    /// @brief Cull traversal of a whole scene as the viewer does it, without a window.
+    class CullTraversal
+    {
+    public:
+        CullTraversal();
+
+        /// Set the number of the frame for the following traversals, it must increase with each frame.
+        void startFrame(unsigned int frame);
+
+        void cull(osg::Node& root);
+
+        osg::FrameStamp* getFrameStamp() { return mFrameStamp; }
+
+    private:
+        osg::ref_ptr<osg::FrameStamp> mFrameStamp;
+        osg::ref_ptr<osgUtil::CullVisitor> mCullVisitor;
+        osg::ref_ptr<osgUtil::StateGraph> mStateGraph;
+        osg::ref_ptr<osgUtil::RenderStage> mRenderStage;
+        osg::ref_ptr<osg::Viewport> mViewport;
+    };
+
+    /// Call \a update and then \a measure for each of \a frames frames, starting from frame 1. Only the time of
+    /// \a measure is counted.
+    /// @return the average time of \a measure in milliseconds
+    template <class Update, class Measure>
+    double measureFrames(int frames, Update&& update, Measure&& measure)
+    {
+        std::chrono::steady_clock::duration duration {};
+        for (int frame = 1; frame <= frames; ++frame)
+        {
+            update(frame);
+
+            const auto start = std::chrono::steady_clock::now();
+            measure();
+            duration += std::chrono::steady_clock::now() - start;
+        }
+        return std::chrono::duration<double, std::milli>(duration).count() / frames;
+    }
+}
+
+#endif
@@ -0,0 +1,176 @@
+/// Measures the time it takes to read every file of a BSA archive, through a memory mapping of the archive and
+/// through file reads, and the time it takes to look up every file by its name.
+/// Reads the given archive, or a generated one with about as many files as Morrowind.bsa if there is none.
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <components/bsa/bsa_file.hpp>
+#include <components/files/constrainedfilestream.hpp>
+#include <components/misc/binaryio.hpp>
+
+namespace
+{
+    const int sFiles = 10000;
+    const int sMaxFileSize = 16 * 1024;
+
+    void writeArchive(const std::string& path)
+    {
+        std::vector<std::string> names;
+        std::vector<std::uint32_t> sizes;
+        std::string nameBuffer;
+        std::vector<std::uint32_t> nameOffsets;
+        for (int i = 0; i < sFiles; ++i)
+        {
+            names.push_back("meshes\\x\\generated_" + std::to_string(i) + ".nif");
+            sizes.push_back(static_cast<std::uint32_t>(std::rand() % sMaxFileSize));
+            nameOffsets.push_back(static_cast<std::uint32_t>(nameBuffer.size()));
+            nameBuffer += names.back();
+            nameBuffer += '\0';
+        }
+
+        const std::uint32_t count = static_cast<std::uint32_t>(names.size());
+
+        boost::filesystem::ofstream stream(path, std::ios::binary);
+        Misc::writeBinary<std::uint32_t>(stream, 0x100);
+        Misc::writeBinary<std::uint32_t>(stream, static_cast<std::uint32_t>(12 * count + nameBuffer.size()));
+        Misc::writeBinary<std::uint32_t>(stream, count);
+
+        std::uint32_t offset = 0;
+        for (const std::uint32_t size : sizes)
+        {
+            Misc::writeBinary<std::uint32_t>(stream, size);
+            Misc::writeBinary<std::uint32_t>(stream, offset);
+            offset += size;
+        }
+        for (const std::uint32_t nameOffset : nameOffsets)
+            Misc::writeBinary<std::uint32_t>(stream, nameOffset);
+        stream.write(nameBuffer.data(), nameBuffer.size());
+
+        // hash table, not used by the reader
+        for (std::uint32_t i = 0; i < count; ++i)
+            Misc::writeBinary<std::uint64_t>(stream, 0);
+
+        for (const std::uint32_t size : sizes)
+            stream << std::string(size, static_cast<char>(std::rand()));
+    }
+
+    /// Read every file of the archive like the loaders do, through an istream.
+    /// @return the time it took in milliseconds
+    template <class Open>
+    double readAll(const Bsa::BSAFile::FileList& files, Open&& open, std::size_t& bytes)
+    {
+        std::vector<char> buffer;
+        bytes = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (const Bsa::BSAFile::FileStruct& file : files)
+        {
+            const Files::IStreamPtr stream = open(file);
+            buffer.resize(file.fileSize);
+            stream->read(buffer.data(), buffer.size());
+            bytes += static_cast<std::size_t>(stream->gcount());
+        }
+        const auto duration = std::chrono::steady_clock::now() - start;
+
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    /// Look up every file of the archive by its name \a rounds times, like the VFS does when it opens a file.
+    /// @return the average time per lookup in nanoseconds
+    double lookUpAll(const Bsa::BSAFile& archive, const std::vector<std::string>& names, int rounds)
+    {
+        std::size_t found = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round)
+            for (const std::string& name : names)
+                found += archive.exists(name.c_str());
+        const auto duration = std::chrono::steady_clock::now() - start;
+
+        if (found != names.size() * rounds)
+            throw std::runtime_error("Not every file of the archive was found");
+
+        return std::chrono::duration<double, std::nano>(duration).count() / (names.size() * rounds);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int rounds = argc > 2 ? std::atoi(argv[2]) : 100;
+
+    std::srand(42);
+
+    std::string path;
+    if (argc > 1)
+        path = argv[1];
+    else
+    {
+        path = (boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("openmw-benchmark-%%%%-%%%%.bsa")).string();
+        writeArchive(path);
+    }
+
+    int result = 0;
+    try
+    {
+        Bsa::BSAFile archive;
+        archive.open(path);
+        const Bsa::BSAFile::FileList& files = archive.getList();
+        const Files::MappedFilePtr mapping = std::make_shared<Files::MappedFile>(path);
+
+        const auto mapped = [&] (const Bsa::BSAFile::FileStruct& file)
+        {
+            return Files::openConstrainedFileStream(mapping, file.offset, file.fileSize);
+        };
+        const auto fileBacked = [&] (const Bsa::BSAFile::FileStruct& file)
+        {
+            return Files::openConstrainedFileStream(path.c_str(), file.offset, file.fileSize);
+        };
+
+        // the first pass only brings the archive into the page cache, so both ways read from memory
+        std::size_t bytes = 0;
+        readAll(files, mapped, bytes);
+
+        const double mappedMs = readAll(files, mapped, bytes);
+        const double fileBackedMs = readAll(files, fileBacked, bytes);
+
+        std::cout << "Read " << files.size() << " files, " << bytes / (1024 * 1024) << " MB: "
+            << mappedMs << " ms through a memory mapping, " << fileBackedMs << " ms through file reads" << std::endl;
+
+        // the names are looked up as they are requested, not as they are stored in the archive
+        std::vector<std::string> names;
+        for (const Bsa::BSAFile::FileStruct& file : files)
+        {
+            names.emplace_back(file.name);
+            if (names.size() % 2 == 0)
+                std::transform(names.back().begin(), names.back().end(), names.back().begin(),
+                               [] (unsigned char c) { return static_cast<char>(std::toupper(c)); });
+        }
+
+        const double lookupNs = lookUpAll(archive, names, rounds);
+        std::cout << "Looked up " << files.size() << " files " << rounds << " times: " << lookupNs
+            << " ns per lookup" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        result = 1;
+    }
+
+    if (argc <= 1)
+        boost::filesystem::remove(path);
+
+    return result;
+}
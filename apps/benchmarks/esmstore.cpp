@@ -0,0 +1,114 @@
+/// Measures the throughput of ESMStore lookups by ID, with the IDs cased differently than in the content files, like
+/// scripts and dialogue filters look them up.
+/// Usage: openmw_benchmark_esmstore <content file>... e.g. the paths of Morrowind.esm, Tribunal.esm and Bloodmoon.esm
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <components/esm/esmreader.hpp>
+#include <components/loadinglistener/loadinglistener.hpp>
+
+#include "../openmw/mwworld/esmstore.hpp"
+
+namespace
+{
+    typedef std::vector<std::pair<int, std::string>> IdList;
+
+    template <class T>
+    void collectIds(const MWWorld::ESMStore& esmStore, IdList& ids)
+    {
+        const MWWorld::Store<T>& store = esmStore.get<T>();
+        for (typename MWWorld::Store<T>::iterator it = store.begin(); it != store.end(); ++it)
+        {
+            std::string id = it->mId;
+            std::transform(id.begin(), id.end(), id.begin(),
+                           [] (unsigned char c) { return static_cast<char>(std::toupper(c)); });
+            ids.emplace_back(T::sRecordId, std::move(id));
+        }
+    }
+
+    bool search(const MWWorld::ESMStore& store, const std::pair<int, std::string>& id)
+    {
+        switch (id.first)
+        {
+            case ESM::REC_ACTI: return store.get<ESM::Activator>().search(id.second) != nullptr;
+            case ESM::REC_CONT: return store.get<ESM::Container>().search(id.second) != nullptr;
+            case ESM::REC_CREA: return store.get<ESM::Creature>().search(id.second) != nullptr;
+            case ESM::REC_MISC: return store.get<ESM::Miscellaneous>().search(id.second) != nullptr;
+            case ESM::REC_NPC_: return store.get<ESM::NPC>().search(id.second) != nullptr;
+            case ESM::REC_SPEL: return store.get<ESM::Spell>().search(id.second) != nullptr;
+            case ESM::REC_STAT: return store.get<ESM::Static>().search(id.second) != nullptr;
+            case ESM::REC_WEAP: return store.get<ESM::Weapon>().search(id.second) != nullptr;
+        }
+        return false;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <content file>..." << std::endl;
+        return 1;
+    }
+
+    const int rounds = 20;
+
+    try
+    {
+        Loading::Listener listener;
+        MWWorld::ESMStore esmStore;
+        std::vector<ESM::ESMReader> readers(argc - 1);
+        for (int index = 0; index < argc - 1; ++index)
+        {
+            ESM::ESMReader& esm = readers[index];
+            esm.setEncoder(nullptr);
+            esm.setIndex(index);
+            esm.setGlobalReaderList(&readers);
+            esm.open(argv[index + 1]);
+            esmStore.load(esm, &listener);
+        }
+        esmStore.setUp();
+
+        IdList ids;
+        collectIds<ESM::Activator>(esmStore, ids);
+        collectIds<ESM::Container>(esmStore, ids);
+        collectIds<ESM::Creature>(esmStore, ids);
+        collectIds<ESM::Miscellaneous>(esmStore, ids);
+        collectIds<ESM::NPC>(esmStore, ids);
+        collectIds<ESM::Spell>(esmStore, ids);
+        collectIds<ESM::Static>(esmStore, ids);
+        collectIds<ESM::Weapon>(esmStore, ids);
+
+        std::size_t found = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round)
+            for (const auto& id : ids)
+                found += search(esmStore, id);
+        const auto duration = std::chrono::steady_clock::now() - start;
+
+        if (found != ids.size() * rounds)
+        {
+            std::cerr << "ERROR: only " << found << " of " << ids.size() * rounds << " lookups found a record"
+                << std::endl;
+            return 1;
+        }
+
+        const double nsPerLookup = std::chrono::duration<double, std::nano>(duration).count() / found;
+        std::cout << "Looked up " << ids.size() << " IDs " << rounds << " times: " << nsPerLookup
+            << " ns per lookup" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,310 @@
+/// Measures the time the script interpreter takes to run compiled scripts similar to Morrowind local scripts.
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <components/compiler/context.hpp>
+#include <components/compiler/exception.hpp>
+#include <components/compiler/extensions.hpp>
+#include <components/compiler/extensions0.hpp>
+#include <components/compiler/fileparser.hpp>
+#include <components/compiler/locals.hpp>
+#include <components/compiler/scanner.hpp>
+#include <components/compiler/streamerrorhandler.hpp>
+
+#include <components/interpreter/context.hpp>
+#include <components/interpreter/installopcodes.hpp>
+#include <components/interpreter/interpreter.hpp>
+
+#include <components/misc/rng.hpp>
+
+namespace
+{
+    struct Script
+    {
+        const char* mName;
+        const char* mText;
+    };
+
+    // Scripts use only instructions implemented by the interpreter itself, game functions are out of scope
+    const Script sScripts[] = {
+        {"BenchTimer",
+            "Begin BenchTimer\n"
+            "short doOnce\n"
+            "float timer\n"
+            "if ( doOnce == 0 )\n"
+            "    set doOnce to 1\n"
+            "    set timer to 0\n"
+            "endif\n"
+            "set timer to ( timer + GetSecondsPassed )\n"
+            "if ( timer > 5 )\n"
+            "    set timer to 0\n"
+            "    set GameHour to ( GameHour + 0.01 )\n"
+            "endif\n"
+            "End\n"},
+        {"BenchState",
+            "Begin BenchState\n"
+            "short state\n"
+            "short roll\n"
+            "float waited\n"
+            "if ( state == 0 )\n"
+            "    set roll to Random 100\n"
+            "    if ( roll < 50 )\n"
+            "        set state to 1\n"
+            "    else\n"
+            "        set state to 2\n"
+            "    endif\n"
+            "elseif ( state == 1 )\n"
+            "    set waited to ( waited + GetSecondsPassed )\n"
+            "    if ( waited >= 1 )\n"
+            "        set waited to 0\n"
+            "        set state to 3\n"
+            "    endif\n"
+            "elseif ( state == 2 )\n"
+            "    if ( DaysPassed > 3 )\n"
+            "        set state to 3\n"
+            "    else\n"
+            "        set DaysPassed to ( DaysPassed + 1 )\n"
+            "    endif\n"
+            "else\n"
+            "    set state to 0\n"
+            "endif\n"
+            "End\n"},
+        {"BenchLoop",
+            "Begin BenchLoop\n"
+            "long count\n"
+            "long total\n"
+            "float ratio\n"
+            "set count to 0\n"
+            "set total to 0\n"
+            "while ( count < 50 )\n"
+            "    set total to ( total + count * 3 - 1 )\n"
+            "    if ( total > 1000 )\n"
+            "        set total to ( total / 2 )\n"
+            "    elseif ( total < 0 )\n"
+            "        set total to 0\n"
+            "    endif\n"
+            "    set count to ( count + 1 )\n"
+            "endwhile\n"
+            "set ratio to ( total / 7.5 )\n"
+            "End\n"},
+    };
+
+    class CompilerContext : public Compiler::Context
+    {
+            const std::map<std::string, char>& mGlobalTypes;
+
+        public:
+
+            CompilerContext (const std::map<std::string, char>& globalTypes) : mGlobalTypes (globalTypes) {}
+
+            bool canDeclareLocals() const override { return true; }
+
+            char getGlobalType (const std::string& name) const override
+            {
+                auto it = mGlobalTypes.find (name);
+                return it == mGlobalTypes.end() ? ' ' : it->second;
+            }
+
+            std::pair<char, bool> getMemberType (const std::string&, const std::string&) const override
+            {
+                return std::make_pair (' ', false);
+            }
+
+            bool isId (const std::string&) const override { return false; }
+
+            bool isJournalId (const std::string&) const override { return false; }
+    };
+
+    class InterpreterContext : public Interpreter::Context
+    {
+            std::vector<int> mShorts;
+            std::vector<int> mLongs;
+            std::vector<float> mFloats;
+            std::map<std::string, float> mGlobals;
+
+        public:
+
+            InterpreterContext (const Compiler::Locals& locals)
+            : mShorts (locals.get ('s').size()), mLongs (locals.get ('l').size()),
+              mFloats (locals.get ('f').size())
+            {}
+
+            int getLocalShort (int index) const override { return mShorts[index]; }
+
+            int getLocalLong (int index) const override { return mLongs[index]; }
+
+            float getLocalFloat (int index) const override { return mFloats[index]; }
+
+            void setLocalShort (int index, int value) override { mShorts[index] = value; }
+
+            void setLocalLong (int index, int value) override { mLongs[index] = value; }
+
+            void setLocalFloat (int index, float value) override { mFloats[index] = value; }
+
+            void messageBox (const std::string&, const std::vector<std::string>&) override {}
+
+            void report (const std::string&) override {}
+
+            bool menuMode() override { return false; }
+
+            int getGlobalShort (const std::string& name) const override { return static_cast<int> (getGlobal (name)); }
+
+            int getGlobalLong (const std::string& name) const override { return static_cast<int> (getGlobal (name)); }
+
+            float getGlobalFloat (const std::string& name) const override { return getGlobal (name); }
+
+            void setGlobalShort (const std::string& name, int value) override { mGlobals[name] = static_cast<float> (value); }
+
+            void setGlobalLong (const std::string& name, int value) override { mGlobals[name] = static_cast<float> (value); }
+
+            void setGlobalFloat (const std::string& name, float value) override { mGlobals[name] = value; }
+
+            std::vector<std::string> getGlobals() const override { return std::vector<std::string>(); }
+
+            char getGlobalType (const std::string&) const override { return ' '; }
+
+            std::string getActionBinding (const std::string&) const override { return std::string(); }
+
+            std::string getActorName() const override { return std::string(); }
+
+            std::string getNPCRace() const override { return std::string(); }
+
+            std::string getNPCClass() const override { return std::string(); }
+
+            std::string getNPCFaction() const override { return std::string(); }
+
+            std::string getNPCRank() const override { return std::string(); }
+
+            std::string getPCName() const override { return std::string(); }
+
+            std::string getPCRace() const override { return std::string(); }
+
+            std::string getPCClass() const override { return std::string(); }
+
+            std::string getPCRank() const override { return std::string(); }
+
+            std::string getPCNextRank() const override { return std::string(); }
+
+            int getPCBounty() const override { return 0; }
+
+            std::string getCurrentCellName() const override { return std::string(); }
+
+            bool isScriptRunning (const std::string&) const override { return false; }
+
+            void startScript (const std::string&, const std::string&) override {}
+
+            void stopScript (const std::string&) override {}
+
+            float getDistance (const std::string&, const std::string&) const override { return 0; }
+
+            float getSecondsPassed() const override { return 1.0f / 60; }
+
+            bool isDisabled (const std::string&) const override { return false; }
+
+            void enable (const std::string&) override {}
+
+            void disable (const std::string&) override {}
+
+            int getMemberShort (const std::string&, const std::string&, bool) const override { return 0; }
+
+            int getMemberLong (const std::string&, const std::string&, bool) const override { return 0; }
+
+            float getMemberFloat (const std::string&, const std::string&, bool) const override { return 0; }
+
+            void setMemberShort (const std::string&, const std::string&, int, bool) override {}
+
+            void setMemberLong (const std::string&, const std::string&, int, bool) override {}
+
+            void setMemberFloat (const std::string&, const std::string&, float, bool) override {}
+
+            std::string getTargetId() const override { return std::string(); }
+
+        private:
+
+            float getGlobal (const std::string& name) const
+            {
+                auto it = mGlobals.find (name);
+                return it == mGlobals.end() ? 0 : it->second;
+            }
+    };
+
+    struct CompiledScript
+    {
+        std::vector<Interpreter::Type_Code> mCode;
+        Compiler::Locals mLocals;
+    };
+
+    CompiledScript compile (const Script& script, Compiler::Context& context)
+    {
+        Compiler::StreamErrorHandler errorHandler;
+        errorHandler.setContext (script.mName);
+        Compiler::FileParser parser (errorHandler, context);
+
+        std::istringstream input (script.mText);
+        Compiler::Scanner scanner (errorHandler, input, context.getExtensions());
+        scanner.scan (parser);
+
+        if (!errorHandler.isGood())
+            throw std::runtime_error (std::string ("failed to compile ") + script.mName);
+
+        CompiledScript result;
+        parser.getCode (result.mCode);
+        result.mLocals = parser.getLocals();
+        return result;
+    }
+}
+
+int main (int argc, char** argv)
+{
+    const int runs = argc > 1 ? std::atoi (argv[1]) : 200000;
+
+    Misc::Rng::init();
+
+    Compiler::Extensions extensions;
+    Compiler::registerExtensions (extensions);
+
+    const std::map<std::string, char> globalTypes {{"gamehour", 'f'}, {"dayspassed", 's'}};
+    CompilerContext compilerContext (globalTypes);
+    compilerContext.setExtensions (&extensions);
+
+    Interpreter::Interpreter interpreter;
+    Interpreter::installOpcodes (interpreter);
+
+    std::cout << std::left << std::setw (12) << "script" << std::right << std::setw (14) << "instructions"
+        << std::setw (14) << "ns per run" << '\n';
+
+    try
+    {
+        for (const Script& script : sScripts)
+        {
+            const CompiledScript compiled = compile (script, compilerContext);
+            InterpreterContext context (compiled.mLocals);
+
+            int executed = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < runs; ++i)
+                executed = interpreter.run (compiled.mCode.data(), static_cast<int> (compiled.mCode.size()), context);
+            const auto duration = std::chrono::steady_clock::now() - start;
+
+            const double nsPerRun = std::chrono::duration<double, std::nano> (duration).count() / runs;
+            std::cout << std::left << std::setw (12) << script.mName << std::right
+                << std::setw (14) << executed << std::setw (14) << std::fixed << std::setprecision (1)
+                << nsPerRun << '\n';
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+/// Measures the time keyframe controllers take to animate the skeletons of many NPCs.
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <osg/MatrixTransform>
+#include <osg/NodeVisitor>
+#include <osg/UserDataContainer>
+
+#include <components/nif/data.hpp>
+#include <components/nifosg/controller.hpp>
+#include <components/nifosg/userdata.hpp>
+
+#include "benchmark.hpp"
+
+namespace
+{
+    using Benchmarks::random;
+
+    const int sSkeletons = 100;
+    const int sBones = 64;
+
+    // base_anim.nif has a single track per bone with the keys of all animation groups one after another
+    const float sTrackLength = 150;
+    const float sKeysPerSecond = 15;
+
+    class TimeSource : public SceneUtil::ControllerSource
+    {
+    public:
+        TimeSource(float offset) : mOffset(offset), mTime(0) {}
+
+        virtual float getValue(osg::NodeVisitor*)
+        {
+            return std::fmod(mOffset + mTime, sTrackLength);
+        }
+
+        void setTime(float time) { mTime = time; }
+
+    private:
+        float mOffset;
+        float mTime;
+    };
+
+    std::shared_ptr<Nif::NiKeyframeData> makeKeyframeData(bool translations)
+    {
+        auto data = std::make_shared<Nif::NiKeyframeData>();
+
+        auto rotations = std::make_shared<Nif::QuaternionKeyMap>();
+        const osg::Vec3f axis = osg::Vec3f(random(-1, 1), random(-1, 1), random(-1, 1)) + osg::Vec3f(0, 0, 2);
+        for (float time = 0; time < sTrackLength; time += 1 / sKeysPerSecond)
+            rotations->mKeys[time].mValue = osg::Quat(random(-0.5f, 0.5f), axis);
+        data->mRotations = rotations;
+
+        if (translations)
+        {
+            auto translationKeys = std::make_shared<Nif::Vector3KeyMap>();
+            for (float time = 0; time < sTrackLength; time += 1 / sKeysPerSecond)
+                translationKeys->mKeys[time].mValue = osg::Vec3f(random(-5, 5), random(-5, 5), random(60, 70));
+            data->mTranslations = translationKeys;
+        }
+
+        return data;
+    }
+
+    struct Bone
+    {
+        osg::ref_ptr<osg::MatrixTransform> mNode;
+        osg::ref_ptr<NifOsg::KeyframeController> mController;
+    };
+
+    struct Skeleton
+    {
+        std::shared_ptr<TimeSource> mSource;
+        std::vector<Bone> mBones;
+    };
+}
+
+int main(int argc, char** argv)
+{
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 1000;
+
+    std::srand(42);
+
+    // like loaded animations, the keyframe data is shared by the skeletons and the controllers are copied per skeleton
+    std::vector<osg::ref_ptr<NifOsg::KeyframeController>> templates;
+    for (int i = 0; i < sBones; ++i)
+    {
+        std::shared_ptr<Nif::NiKeyframeData> data = makeKeyframeData(i == 0);
+        templates.push_back(new NifOsg::KeyframeController(data.get()));
+    }
+
+    std::vector<Skeleton> skeletons(sSkeletons);
+    for (Skeleton& skeleton : skeletons)
+    {
+        skeleton.mSource = std::make_shared<TimeSource>(random(0, sTrackLength));
+        for (const auto& controllerTemplate : templates)
+        {
+            Bone bone;
+            bone.mNode = new osg::MatrixTransform;
+            bone.mNode->getOrCreateUserDataContainer()->addUserObject(new NifOsg::NodeUserData(0, 1.f, Nif::Matrix3()));
+            bone.mController = new NifOsg::KeyframeController(*controllerTemplate, osg::CopyOp::SHALLOW_COPY);
+            bone.mController->setSource(skeleton.mSource);
+            skeleton.mBones.push_back(bone);
+        }
+    }
+
+    osg::NodeVisitor visitor;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        for (Skeleton& skeleton : skeletons)
+        {
+            skeleton.mSource->setTime(frame / 60.f);
+            for (Bone& bone : skeleton.mBones)
+                (*bone.mController)(bone.mNode, &visitor);
+        }
+    }
+    const auto duration = std::chrono::steady_clock::now() - start;
+
+    const double msPerFrame = std::chrono::duration<double, std::milli>(duration).count() / frames;
+    std::cout << "Animated " << sSkeletons << " skeletons with " << sBones << " bones over " << frames << " frames: "
+        << msPerFrame << " ms per frame, " << msPerFrame * 1e6 / (sSkeletons * sBones) << " ns per bone" << std::endl;
+
+    return 0;
+}
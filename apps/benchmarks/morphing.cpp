@@ -0,0 +1,92 @@
+/// Measures the time the cull traversal takes to blend the morph targets of many animated heads.
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <osg/Geometry>
+#include <osg/Group>
+
+#include <components/sceneutil/morphgeometry.hpp>
+
+#include "benchmark.hpp"
+
+namespace
+{
+    using Benchmarks::random;
+
+    // roughly the vertices and facial morphs of a head with lip sync and blinking
+    const int sVertices = 1200;
+    const int sTargets = 16;
+    const int sAnimatedTargets = 3;
+    const int sPosedTargets = 2;
+
+    osg::ref_ptr<SceneUtil::MorphGeometry> makeHead()
+    {
+        osg::ref_ptr<osg::Geometry> geometry (new osg::Geometry);
+        osg::ref_ptr<osg::Vec3Array> vertices (new osg::Vec3Array);
+        for (int i = 0; i < sVertices; ++i)
+            vertices->push_back(osg::Vec3f(random(-10, 10), random(-10, 10), random(0, 25)));
+        geometry->setVertexArray(vertices);
+        geometry->addPrimitiveSet(new osg::DrawArrays(GL_TRIANGLES, 0, sVertices));
+
+        osg::ref_ptr<SceneUtil::MorphGeometry> morph (new SceneUtil::MorphGeometry);
+        morph->setSourceGeometry(geometry);
+
+        // each target moves a region of the face, the vertices of which are mostly stored together
+        for (int target = 0; target < sTargets; ++target)
+        {
+            osg::ref_ptr<osg::Vec3Array> offsets (new osg::Vec3Array(sVertices));
+            const int size = 60 + std::rand() % 140;
+            const int begin = std::rand() % (sVertices - size);
+            for (int i = begin; i < begin + size; ++i)
+                (*offsets)[i] = osg::Vec3f(random(-0.5f, 0.5f), random(-0.5f, 0.5f), random(-0.5f, 0.5f));
+            morph->addMorphTarget(offsets, target < sAnimatedTargets + sPosedTargets ? 0.5f : 0.f);
+        }
+
+        return morph;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int heads = argc > 1 ? std::atoi(argv[1]) : 50;
+    const int frames = argc > 2 ? std::atoi(argv[2]) : 1000;
+
+    std::srand(42);
+
+    osg::ref_ptr<osg::Group> root (new osg::Group);
+    std::vector<SceneUtil::MorphGeometry*> morphs;
+    for (int i = 0; i < heads; ++i)
+    {
+        osg::ref_ptr<SceneUtil::MorphGeometry> head = makeHead();
+        morphs.push_back(head);
+        root->addChild(head);
+    }
+
+    Benchmarks::CullTraversal cullTraversal;
+
+    const double msPerFrame = Benchmarks::measureFrames(frames,
+        [&] (int frame)
+        {
+            cullTraversal.startFrame(frame);
+
+            // what GeomMorpherController does in the update traversal
+            for (std::size_t i = 0; i < morphs.size(); ++i)
+            {
+                for (int target = 0; target < sAnimatedTargets; ++target)
+                {
+                    const float weight = 0.5f + 0.5f * std::sin(frame * 0.1f + i + target);
+                    morphs[i]->getMorphTarget(target).setWeight(weight);
+                }
+                morphs[i]->dirty();
+            }
+        },
+        [&] { cullTraversal.cull(*root); });
+
+    std::cout << "Morphed " << heads << " heads of " << sVertices << " vertices with " << sAnimatedTargets
+        << " animated targets over " << frames << " frames: " << msPerFrame << " ms per frame" << std::endl;
+
+    return 0;
+}
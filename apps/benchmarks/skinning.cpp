@@ -0,0 +1,168 @@
+/// Measures the time the cull traversal takes to skin the bodies of many NPCs.
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/MatrixTransform>
+#include <osgUtil/UpdateVisitor>
+
+#include <components/sceneutil/riggeometry.hpp>
+#include <components/sceneutil/skeleton.hpp>
+#include <components/sceneutil/workqueue.hpp>
+
+#include "benchmark.hpp"
+
+namespace
+{
+    using Benchmarks::random;
+
+    // roughly the bones and vertices of a base_anim NPC with its body parts
+    const int sBones = 40;
+    const int sParts = 8;
+    const int sVerticesPerPart = 400;
+
+    std::string getBoneName(int bone)
+    {
+        return "bone " + std::to_string(bone);
+    }
+
+    osg::ref_ptr<SceneUtil::RigGeometry> makeBodyPart()
+    {
+        osg::ref_ptr<osg::Geometry> geometry (new osg::Geometry);
+        osg::ref_ptr<osg::Vec3Array> vertices (new osg::Vec3Array);
+        osg::ref_ptr<osg::Vec3Array> normals (new osg::Vec3Array);
+        for (int i = 0; i < sVerticesPerPart; ++i)
+        {
+            vertices->push_back(osg::Vec3f(random(-20, 20), random(-20, 20), random(0, 120)));
+            osg::Vec3f normal(random(-1, 1), random(-1, 1), random(-1, 1));
+            normal.normalize();
+            normals->push_back(normal);
+        }
+        geometry->setVertexArray(vertices);
+        geometry->setNormalArray(normals, osg::Array::BIND_PER_VERTEX);
+        geometry->addPrimitiveSet(new osg::DrawArrays(GL_TRIANGLES, 0, sVerticesPerPart));
+
+        // most vertices follow a single bone, the ones around joints are blended between two
+        std::vector<SceneUtil::RigGeometry::BoneInfluence> influences(sBones);
+        for (int i = 0; i < sVerticesPerPart; ++i)
+        {
+            const int bone = std::rand() % sBones;
+            if (std::rand() % 10 < 7)
+                influences[bone].mWeights.emplace_back(i, 1.f);
+            else
+            {
+                const float weight = random(0.1f, 0.9f);
+                influences[bone].mWeights.emplace_back(i, weight);
+                influences[(bone + 1) % sBones].mWeights.emplace_back(i, 1.f - weight);
+            }
+        }
+
+        osg::ref_ptr<SceneUtil::RigGeometry::InfluenceMap> influenceMap (new SceneUtil::RigGeometry::InfluenceMap);
+        for (int bone = 0; bone < sBones; ++bone)
+        {
+            influences[bone].mBoundSphere = osg::BoundingSpheref(osg::Vec3f(0, 0, 60), 80);
+            influenceMap->mData.emplace_back(getBoneName(bone), influences[bone]);
+        }
+
+        osg::ref_ptr<SceneUtil::RigGeometry> rig (new SceneUtil::RigGeometry);
+        rig->setSourceGeometry(geometry);
+        rig->setInfluenceMap(influenceMap);
+        return rig;
+    }
+
+    osg::ref_ptr<SceneUtil::Skeleton> makeBody()
+    {
+        osg::ref_ptr<SceneUtil::Skeleton> skeleton (new SceneUtil::Skeleton);
+        osg::Group* parent = skeleton;
+        for (int bone = 0; bone < sBones; ++bone)
+        {
+            osg::ref_ptr<osg::MatrixTransform> node (new osg::MatrixTransform);
+            node->setName(getBoneName(bone));
+            parent->addChild(node);
+            parent = node;
+        }
+
+        osg::ref_ptr<osg::Geode> geode (new osg::Geode);
+        for (int part = 0; part < sParts; ++part)
+            geode->addDrawable(makeBodyPart());
+        skeleton->addChild(geode);
+        return skeleton;
+    }
+
+    class CollectBonesAndRigs : public osg::NodeVisitor
+    {
+    public:
+        CollectBonesAndRigs() : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN) {}
+
+        virtual void apply(osg::MatrixTransform& node)
+        {
+            mBones.push_back(&node);
+            traverse(node);
+        }
+
+        virtual void apply(osg::Drawable& drawable)
+        {
+            if (SceneUtil::RigGeometry* rig = dynamic_cast<SceneUtil::RigGeometry*>(&drawable))
+                mRigs.push_back(rig);
+        }
+
+        std::vector<osg::MatrixTransform*> mBones;
+        std::vector<SceneUtil::RigGeometry*> mRigs;
+    };
+}
+
+int main(int argc, char** argv)
+{
+    const int bodies = argc > 1 ? std::atoi(argv[1]) : 30;
+    const int threads = argc > 2 ? std::atoi(argv[2]) : 1;
+    const int frames = argc > 3 ? std::atoi(argv[3]) : 500;
+
+    std::srand(42);
+
+    if (threads > 0)
+        SceneUtil::RigGeometry::setWorkQueue(new SceneUtil::WorkQueue(threads));
+
+    // the copies share the source data of the template, like the instances of a loaded model
+    osg::ref_ptr<SceneUtil::Skeleton> body = makeBody();
+    osg::ref_ptr<osg::Group> root (new osg::Group);
+    for (int i = 0; i < bodies; ++i)
+        root->addChild(osg::clone(body.get(), osg::CopyOp::DEEP_COPY_NODES | osg::CopyOp::DEEP_COPY_DRAWABLES));
+
+    CollectBonesAndRigs collect;
+    root->accept(collect);
+
+    Benchmarks::CullTraversal cullTraversal;
+    osgUtil::UpdateVisitor updateVisitor;
+    updateVisitor.setFrameStamp(cullTraversal.getFrameStamp());
+
+    const double msPerFrame = Benchmarks::measureFrames(frames,
+        [&] (int frame)
+        {
+            cullTraversal.startFrame(frame);
+            updateVisitor.setTraversalNumber(frame);
+
+            for (std::size_t i = 0; i < collect.mBones.size(); ++i)
+                collect.mBones[i]->setMatrix(osg::Matrix::rotate(0.1f * std::sin(frame * 0.05f + i), osg::Vec3f(0, 1, 0)));
+            root->accept(updateVisitor);
+        },
+        [&]
+        {
+            cullTraversal.cull(*root);
+
+            // drawing would wait for the skinning here
+            for (SceneUtil::RigGeometry* rig : collect.mRigs)
+                rig->waitForSkinning();
+        });
+
+    std::cout << "Skinned " << bodies << " bodies of " << sParts * sVerticesPerPart << " vertices with " << threads
+        << " threads over " << frames << " frames: " << msPerFrame << " ms per frame" << std::endl;
+
+    SceneUtil::RigGeometry::setWorkQueue(nullptr);
+
+    return 0;
+}
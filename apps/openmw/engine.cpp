@@ -1,8 +1,10 @@
 #include "engine.hpp"
 
 #include <iomanip>
+#include <sstream>
 
 #include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
 
 #include <osgViewer/ViewerEventHandlers>
 #include <osgDB/ReadFile>
@@ -25,7 +27,9 @@
 #include <components/resource/stats.hpp>
 
 #include <components/compiler/extensions0.hpp>
+#include <components/compiler/scriptcache.hpp>
 
+#include <components/sceneutil/riggeometry.hpp>
 #include <components/sceneutil/vismask.hpp>
 #include <components/sceneutil/workqueue.hpp>
 
@@ -73,10 +77,40 @@ void OMW::Engine::executeLocalScripts()
 
     localScripts.startIteration();
     std::pair<std::string, MWWorld::Ptr> script;
-    while (localScripts.getNext(script))
+
+    if (mDistantScriptsMaxTime <= 0)
+    {
+        while (localScripts.getNext(script))
+        {
+            MWScript::InterpreterContext interpreterContext (
+                &script.second.getRefData().getLocals(), script.second);
+            mEnvironment.getScriptManager()->run (script.first, interpreterContext);
+        }
+        return;
+    }
+
+    // run the scripts of distant references only as long as the time budget allows, the others in the next frames
+    const osg::Vec3f playerPosition = mEnvironment.getWorld()->getPlayerPtr().getRefData().getPosition().asVec3();
+    const float frameDuration = mEnvironment.getFrameDuration();
+    float secondsPassed = 0;
+
+    while (localScripts.getNextNear(script, secondsPassed, playerPosition, mDistantScriptsDistance, frameDuration))
     {
         MWScript::InterpreterContext interpreterContext (
             &script.second.getRefData().getLocals(), script.second);
+        interpreterContext.setSecondsPassed(secondsPassed);
+        mEnvironment.getScriptManager()->run (script.first, interpreterContext);
+    }
+
+    const osg::Timer_t start = osg::Timer::instance()->tick();
+
+    localScripts.startDeferredIteration();
+    while (osg::Timer::instance()->delta_s(start, osg::Timer::instance()->tick()) < mDistantScriptsMaxTime
+           && localScripts.getNextDeferred(script, secondsPassed))
+    {
+        MWScript::InterpreterContext interpreterContext (
+            &script.second.getRefData().getLocals(), script.second);
+        interpreterContext.setSecondsPassed(secondsPassed);
         mEnvironment.getScriptManager()->run (script.first, interpreterContext);
     }
 }
@@ -87,6 +121,9 @@ bool OMW::Engine::frame(float frametime)
     {
         mStartTick = mViewer->getStartTick();
 
+        // apply the actor movement solved while the previous frame was rendered
+        mEnvironment.getWorld()->collectPhysics();
+
         mEnvironment.setFrameDuration(frametime);
 
         // update input
@@ -113,6 +150,8 @@ bool OMW::Engine::frame(float frametime)
         // update game state
         mEnvironment.getStateManager()->update (frametime);
 
+        mEnvironment.getScriptManager()->precompile();
+
         bool guiActive = mEnvironment.getWindowManager()->isGuiMode();
 
         osg::Timer_t beforeScriptTick = osg::Timer::instance()->tick();
@@ -207,6 +246,10 @@ bool OMW::Engine::frame(float frametime)
             stats->setAttribute(frameNumber, "WorkThread", mWorkQueue->getNumActiveThreads());
 
             mEnvironment.getWorld()->getNavigator()->reportStats(frameNumber, *stats);
+
+            mEnvironment.getWorld()->reportStats(frameNumber, *stats);
+
+            mEnvironment.getScriptManager()->reportStats(frameNumber, *stats);
         }
 
     }
@@ -236,6 +279,8 @@ OMW::Engine::Engine(Files::ConfigurationManager& configurationManager)
   , mFSStrict (false)
   , mScriptBlacklistUse (true)
   , mNewGame (false)
+  , mDistantScriptsMaxTime (0)
+  , mDistantScriptsDistance (0)
   , mCfgMgr(configurationManager)
 {
     MWClass::registerClasses();
@@ -266,6 +311,8 @@ OMW::Engine::~Engine()
 
     mViewer = nullptr;
 
+    SceneUtil::RigGeometry::setWorkQueue(nullptr);
+
     mResourceSystem.reset();
 
     delete mEncoder;
@@ -479,6 +526,9 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
 
     mVFS.reset(new VFS::Manager(mFSStrict));
 
+    mVFS->setArchiveCacheSize(
+        static_cast<std::size_t>(std::max(0, Settings::Manager::getInt("archive cache size", "Cells"))) * 1024 * 1024);
+
     VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true);
 
     mResourceSystem.reset(new Resource::ResourceSystem(mVFS.get()));
@@ -494,6 +544,11 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
     if (numThreads <= 0)
         throw std::runtime_error("Invalid setting: 'preload num threads' must be >0");
     mWorkQueue = new SceneUtil::WorkQueue(numThreads);
+    mResourceSystem->setWorkQueue(mWorkQueue);
+
+    const int skinningThreads = Settings::Manager::getInt("skinning threads", "General");
+    if (skinningThreads > 0)
+        SceneUtil::RigGeometry::setWorkQueue(new SceneUtil::WorkQueue(skinningThreads));
 
     // Create input and UI first to set up a bootstrapping environment for
     // showing a loading screen and keeping the window responsive while doing so
@@ -576,8 +631,39 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
     mScriptContext = new MWScript::CompilerContext (MWScript::CompilerContext::Type_Full);
     mScriptContext->setExtensions (&mExtensions);
 
-    mEnvironment.setScriptManager (new MWScript::ScriptManager (mEnvironment.getWorld()->getStore(), *mScriptContext, mWarningsMode,
-        mScriptBlacklistUse ? mScriptBlacklist : std::vector<std::string>()));
+    MWScript::ScriptManager* scriptManager = new MWScript::ScriptManager (mEnvironment.getWorld()->getStore(),
+        *mScriptContext, mWarningsMode, mScriptBlacklistUse ? mScriptBlacklist : std::vector<std::string>());
+    mEnvironment.setScriptManager (scriptManager);
+
+    mDistantScriptsMaxTime = Settings::Manager::getFloat("distant scripts time per frame", "Scripts");
+    mDistantScriptsDistance = Settings::Manager::getFloat("distant scripts distance", "Scripts");
+
+    if (Settings::Manager::getBool("compiled script cache", "Scripts"))
+    {
+        // compiled code depends on the other records (global variables, object ids, local variables of other scripts)
+        // and on the compiler of this build
+        std::vector<std::string> environment;
+        environment.push_back(Version::getOpenmwVersionDescription(mResDir.string()));
+        for (const std::string& file : mContentFiles)
+        {
+            std::ostringstream description;
+            description << file;
+            const Files::MultiDirCollection& collection =
+                mFileCollections.getCollection(boost::filesystem::path(file).extension().string());
+            if (collection.doesExist(file))
+            {
+                const boost::filesystem::path path = collection.getPath(file);
+                description << ' ' << boost::filesystem::file_size(path) << ' ' << boost::filesystem::last_write_time(path);
+            }
+            environment.push_back(description.str());
+        }
+
+        const float precompileMaxTime = Settings::Manager::getBool("precompile scripts", "Scripts")
+            ? Settings::Manager::getFloat("precompile time per frame", "Scripts") : 0.f;
+        scriptManager->setCache(std::unique_ptr<Compiler::ScriptCache>(new Compiler::ScriptCache(
+            (mCfgMgr.getUserDataPath() / "scripts.cache").string(), mExtensions, environment)),
+            mWorkQueue.get(), precompileMaxTime);
+    }
 
     // Create game mechanics system
     MWMechanics::MechanicsManager* mechanics = new MWMechanics::MechanicsManager;
@@ -761,6 +847,8 @@ void OMW::Engine::go()
 
             mEnvironment.getWorld()->updateWindowManager();
 
+            mEnvironment.getWorld()->submitPhysics();
+
             mViewer->renderingTraversals();
 
             bool guiActive = mEnvironment.getWindowManager()->isGuiMode();
@@ -110,6 +110,8 @@ namespace OMW
             std::vector<std::string> mScriptBlacklist;
             bool mScriptBlacklistUse;
             bool mNewGame;
+            float mDistantScriptsMaxTime;
+            float mDistantScriptsDistance;
 
             osg::Timer_t mStartTick;
 
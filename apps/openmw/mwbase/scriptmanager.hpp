@@ -2,6 +2,7 @@
 #define GAME_MWBASE_SCRIPTMANAGER_H
 
 #include <string>
+#include <vector>
 
 namespace Interpreter
 {
@@ -18,6 +19,11 @@ namespace MWScript
     class GlobalScripts;
 }
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace MWBase
 {
     /// \brief Interface for script manager (implemented in MWScript)
@@ -31,6 +37,15 @@ namespace MWBase
 
         public:
 
+            /// \brief Execution statistics of a script
+            struct ScriptProfile
+            {
+                std::string mName;
+                std::size_t mRuns;
+                std::size_t mInstructions;
+                double mTime; ///< in seconds
+            };
+
             ScriptManager() {}
 
             virtual ~ScriptManager() {}
@@ -46,10 +61,18 @@ namespace MWBase
             ///< Compile all scripts
             /// \return count, success
 
+            virtual void precompile() = 0;
+            ///< Compile some of the scripts not compiled yet, within the time budget for a frame.
+
             virtual const Compiler::Locals& getLocals (const std::string& name) = 0;
             ///< Return locals for script \a name.
 
             virtual MWScript::GlobalScripts& getGlobalScripts() = 0;
+
+            virtual std::vector<ScriptProfile> getProfile (std::size_t count) const = 0;
+            ///< Return the \a count scripts which took the most time to execute so far.
+
+            virtual void reportStats (unsigned int frameNumber, osg::Stats& stats) const = 0;
    };
 }
 
@@ -21,6 +21,7 @@ namespace osg
     class Matrixf;
     class Quat;
     class Image;
+    class Stats;
 }
 
 namespace Loading
@@ -378,6 +379,14 @@ namespace MWBase
             virtual void update (float duration, bool paused) = 0;
             virtual void updatePhysics (float duration, bool paused) = 0;
 
+            /// Start solving the actor movement of this frame while it is rendered.
+            /// Only has an effect if asynchronous physics simulation is enabled.
+            virtual void submitPhysics() = 0;
+
+            /// Move the actors by the results of the previous submitPhysics() call.
+            /// Must be called before the game state is modified in the next frame.
+            virtual void collectPhysics() = 0;
+
             virtual void updateWindowManager () = 0;
 
             virtual MWWorld::Ptr placeObject (const MWWorld::ConstPtr& object, float cursorX, float cursorY, int amount) = 0;
@@ -614,6 +623,8 @@ namespace MWBase
 
             virtual DetourNavigator::Navigator* getNavigator() const = 0;
 
+            virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) const = 0;
+
             virtual void updateActorPath(const MWWorld::ConstPtr& actor, const std::deque<osg::Vec3f>& path,
                     const osg::Vec3f& halfExtents, const osg::Vec3f& start, const osg::Vec3f& end) const = 0;
 
@@ -117,6 +117,9 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
         return false;
     }
 
+    if (mPathFinder.updatePathRequest(actor, getPathGridGraph(actor.getCell())))
+        mRotateOnTheRunChecks = 3;
+
     const float distToTarget = distance(position, dest);
     const bool isDestReached = (distToTarget <= destTolerance);
 
@@ -135,11 +138,14 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
 
         if (!mIsShortcutting)
         {
-            if (wasShortcutting || doesPathNeedRecalc(dest, actor)) // if need to rebuild path
+            // wait for the requested path instead of requesting it again
+            if (!mPathFinder.isPathRequested() && (wasShortcutting || doesPathNeedRecalc(dest, actor)))
             {
                 const auto pathfindingHalfExtents = world->getPathfindingHalfExtents(actor);
-                mPathFinder.buildPath(actor, position, dest, actor.getCell(), getPathGridGraph(actor.getCell()),
-                    pathfindingHalfExtents, getNavigatorFlags(actor));
+                if (!mPathFinder.requestPath(actor, position, dest, actor.getCell(), pathfindingHalfExtents,
+                                             getNavigatorFlags(actor)))
+                    mPathFinder.buildPath(actor, position, dest, actor.getCell(), getPathGridGraph(actor.getCell()),
+                        pathfindingHalfExtents, getNavigatorFlags(actor));
                 mRotateOnTheRunChecks = 3;
 
                 // give priority to go directly on target if there is minimal opportunity
@@ -186,6 +192,12 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
 
     world->updateActorPath(actor, mPathFinder.getPath(), halfExtents, position, dest);
 
+    if (mPathFinder.isPathRequested() && mPathFinder.getPath().empty()) // wait for the first path
+    {
+        actor.getClass().getMovementSettings(actor).mPosition[1] = 0;
+        return false;
+    }
+
     if (mRotateOnTheRunChecks == 0
         || isReachableRotatingOnTheRun(actor, *mPathFinder.getPath().begin())) // to prevent circling around a path point
     {
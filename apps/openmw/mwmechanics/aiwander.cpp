@@ -190,11 +190,17 @@ namespace MWMechanics
                 mPathFinder.buildPathByPathgrid(pos.asVec3(), mDestination, actor.getCell(),
                     getPathGridGraph(actor.getCell()));
             }
+            else if (mPathFinder.isPathRequested())
+            {
+                mPathFinder.updatePathRequest(actor, getPathGridGraph(actor.getCell()));
+            }
             else
             {
                 const osg::Vec3f halfExtents = MWBase::Environment::get().getWorld()->getPathfindingHalfExtents(actor);
-                mPathFinder.buildPath(actor, pos.asVec3(), mDestination, actor.getCell(),
-                    getPathGridGraph(actor.getCell()), halfExtents, getNavigatorFlags(actor));
+                if (!mPathFinder.requestPath(actor, pos.asVec3(), mDestination, actor.getCell(), halfExtents,
+                                             getNavigatorFlags(actor)))
+                    mPathFinder.buildPath(actor, pos.asVec3(), mDestination, actor.getCell(),
+                        getPathGridGraph(actor.getCell()), halfExtents, getNavigatorFlags(actor));
             }
 
             if (mPathFinder.isPathConstructed())
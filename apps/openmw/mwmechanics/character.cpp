@@ -932,48 +932,17 @@ CharacterController::~CharacterController()
     }
 }
 
-void split(const std::string &s, char delim, std::vector<std::string> &elems) {
-    std::stringstream ss(s);
-    std::string item;
-    while (std::getline(ss, item, delim)) {
-        elems.push_back(item);
-    }
-}
-
-void CharacterController::handleTextKey(const std::string &groupname, const std::multimap<float, std::string>::const_iterator &key, const std::multimap<float, std::string> &map)
+void CharacterController::handleTextKey(const std::string &groupname, const NifOsg::TextKeyIndex::Key &key)
 {
-    const std::string &evt = key->second;
-
-    if(evt.compare(0, 7, "sound: ") == 0)
+    if(key.mSoundType == NifOsg::TextKeyIndex::Sound_Sound)
     {
         MWBase::SoundManager *sndMgr = MWBase::Environment::get().getSoundManager();
-        sndMgr->playSound3D(mPtr, evt.substr(7), 1.0f, 1.0f);
+        sndMgr->playSound3D(mPtr, key.mSound, 1.0f, 1.0f);
         return;
     }
-    if(evt.compare(0, 10, "soundgen: ") == 0)
+    if(key.mSoundType == NifOsg::TextKeyIndex::Sound_SoundGen)
     {
-        std::string soundgen = evt.substr(10);
-
-        // The event can optionally contain volume and pitch modifiers
-        float volume=1.f, pitch=1.f;
-        if (soundgen.find(" ") != std::string::npos)
-        {
-            std::vector<std::string> tokens;
-            split(soundgen, ' ', tokens);
-            soundgen = tokens[0];
-            if (tokens.size() >= 2)
-            {
-                std::stringstream stream;
-                stream << tokens[1];
-                stream >> volume;
-            }
-            if (tokens.size() >= 3)
-            {
-                std::stringstream stream;
-                stream << tokens[2];
-                stream >> pitch;
-            }
-        }
+        const std::string &soundgen = key.mSound;
 
         std::string sound = mPtr.getClass().getSoundIdFromSndGen(mPtr, soundgen);
         if(!sound.empty())
@@ -982,41 +951,40 @@ void CharacterController::handleTextKey(const std::string &groupname, const std:
             // NB: landing sound is not played for NPCs here
             if(soundgen == "left" || soundgen == "right" || soundgen == "land")
             {
-                sndMgr->playSound3D(mPtr, sound, volume, pitch, MWSound::Type::Foot,
+                sndMgr->playSound3D(mPtr, sound, key.mVolume, key.mPitch, MWSound::Type::Foot,
                                     MWSound::PlayMode::NoPlayerLocal);
             }
             else
             {
-                sndMgr->playSound3D(mPtr, sound, volume, pitch);
+                sndMgr->playSound3D(mPtr, sound, key.mVolume, key.mPitch);
             }
         }
         return;
     }
 
-    if(evt.compare(0, groupname.size(), groupname) != 0 ||
-       evt.compare(groupname.size(), 2, ": ") != 0)
+    if(key.mGroup == NifOsg::TextKeyIndex::sNone || key.mGroupName != groupname)
     {
         // Not ours, skip it
         return;
     }
-    size_t off = groupname.size()+2;
-    size_t len = evt.size() - off;
 
-    if(groupname == "shield" && evt.compare(off, len, "equip attach") == 0)
+    const NifOsg::TextKeyIndex::Marker marker = key.mMarker;
+
+    if(groupname == "shield" && marker == NifOsg::TextKeyIndex::Marker_EquipAttach)
         mAnimation->showCarriedLeft(true);
-    else if(groupname == "shield" && evt.compare(off, len, "unequip detach") == 0)
+    else if(groupname == "shield" && marker == NifOsg::TextKeyIndex::Marker_UnequipDetach)
         mAnimation->showCarriedLeft(false);
-    else if(evt.compare(off, len, "equip attach") == 0)
+    else if(marker == NifOsg::TextKeyIndex::Marker_EquipAttach)
         mAnimation->showWeapons(true);
-    else if(evt.compare(off, len, "unequip detach") == 0)
+    else if(marker == NifOsg::TextKeyIndex::Marker_UnequipDetach)
         mAnimation->showWeapons(false);
-    else if(evt.compare(off, len, "chop hit") == 0)
+    else if(marker == NifOsg::TextKeyIndex::Marker_ChopHit)
         mPtr.getClass().hit(mPtr, mAttackStrength, ESM::Weapon::AT_Chop);
-    else if(evt.compare(off, len, "slash hit") == 0)
+    else if(marker == NifOsg::TextKeyIndex::Marker_SlashHit)
         mPtr.getClass().hit(mPtr, mAttackStrength, ESM::Weapon::AT_Slash);
-    else if(evt.compare(off, len, "thrust hit") == 0)
+    else if(marker == NifOsg::TextKeyIndex::Marker_ThrustHit)
         mPtr.getClass().hit(mPtr, mAttackStrength, ESM::Weapon::AT_Thrust);
-    else if(evt.compare(off, len, "hit") == 0)
+    else if(marker == NifOsg::TextKeyIndex::Marker_Hit)
     {
         if (groupname == "attack1" || groupname == "swimattack1")
             mPtr.getClass().hit(mPtr, mAttackStrength, ESM::Weapon::AT_Chop);
@@ -1029,24 +997,10 @@ void CharacterController::handleTextKey(const std::string &groupname, const std:
     }
     else if (!groupname.empty()
              && (groupname.compare(0, groupname.size()-1, "attack") == 0 || groupname.compare(0, groupname.size()-1, "swimattack") == 0)
-             && evt.compare(off, len, "start") == 0)
+             && marker == NifOsg::TextKeyIndex::Marker_Start)
     {
-        std::multimap<float, std::string>::const_iterator hitKey = key;
-
         // Not all animations have a hit key defined. If there is none, the hit happens with the start key.
-        bool hasHitKey = false;
-        while (hitKey != map.end())
-        {
-            if (hitKey->second == groupname + ": hit")
-            {
-                hasHitKey = true;
-                break;
-            }
-            if (hitKey->second == groupname + ": stop")
-                break;
-            ++hitKey;
-        }
-        if (!hasHitKey)
+        if (!key.mHasHitKey)
         {
             if (groupname == "attack1" || groupname == "swimattack1")
                 mPtr.getClass().hit(mPtr, mAttackStrength, ESM::Weapon::AT_Chop);
@@ -1056,25 +1010,27 @@ void CharacterController::handleTextKey(const std::string &groupname, const std:
                 mPtr.getClass().hit(mPtr, mAttackStrength, ESM::Weapon::AT_Thrust);
         }
     }
-    else if (evt.compare(off, len, "shoot attach") == 0)
+    else if (marker == NifOsg::TextKeyIndex::Marker_ShootAttach)
         mAnimation->attachArrow();
-    else if (evt.compare(off, len, "shoot release") == 0)
+    else if (marker == NifOsg::TextKeyIndex::Marker_ShootRelease)
         mAnimation->releaseArrow(mAttackStrength);
-    else if (evt.compare(off, len, "shoot follow attach") == 0)
+    else if (marker == NifOsg::TextKeyIndex::Marker_ShootFollowAttach)
         mAnimation->attachArrow();
 
-    else if (groupname == "spellcast" && evt.substr(evt.size()-7, 7) == "release"
+    else if (groupname == "spellcast"
              // Make sure this key is actually for the RangeType we are casting. The flame atronach has
              // the same animation for all range types, so there are 3 "release" keys on the same time, one for each range type.
-             && evt.compare(off, len, mAttackType + " release") == 0)
+             && key.mMarkerName.size() == mAttackType.size() + 8
+             && key.mMarkerName.compare(0, mAttackType.size(), mAttackType) == 0
+             && key.mMarkerName.compare(mAttackType.size(), 8, " release") == 0)
     {
         MWBase::Environment::get().getWorld()->castSpell(mPtr, mCastingManualSpell);
         mCastingManualSpell = false;
     }
 
-    else if (groupname == "shield" && evt.compare(off, len, "block hit") == 0)
+    else if (groupname == "shield" && marker == NifOsg::TextKeyIndex::Marker_BlockHit)
         mPtr.getClass().block(mPtr);
-    else if (groupname == "containeropen" && evt.compare(off, len, "loot") == 0)
+    else if (groupname == "containeropen" && marker == NifOsg::TextKeyIndex::Marker_Loot)
         MWBase::Environment::get().getWindowManager()->pushGuiMode(MWGui::GM_Container, mPtr);
 }
 
@@ -293,6 +293,7 @@ namespace MWMechanics
 
     void PathFinder::buildStraightPath(const osg::Vec3f& endPoint)
     {
+        cancelPathRequest();
         mPath.clear();
         mPath.push_back(endPoint);
         mConstructed = true;
@@ -301,6 +302,7 @@ namespace MWMechanics
     void PathFinder::buildPathByPathgrid(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
         const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph)
     {
+        cancelPathRequest();
         mPath.clear();
         mCell = cell;
 
@@ -312,6 +314,7 @@ namespace MWMechanics
     void PathFinder::buildPathByNavMesh(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
         const osg::Vec3f& endPoint, const osg::Vec3f& halfExtents, const DetourNavigator::Flags flags)
     {
+        cancelPathRequest();
         mPath.clear();
 
         // If it's not possible to build path over navmesh due to disabled navmesh generation fallback to straight path
@@ -325,6 +328,7 @@ namespace MWMechanics
         const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph, const osg::Vec3f& halfExtents,
         const DetourNavigator::Flags flags)
     {
+        cancelPathRequest();
         mPath.clear();
         mCell = cell;
 
@@ -337,6 +341,99 @@ namespace MWMechanics
         mConstructed = true;
     }
 
+    bool PathFinder::requestPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const MWWorld::CellStore* cell, const osg::Vec3f& halfExtents,
+        const DetourNavigator::Flags flags)
+    {
+        if (actor.getClass().isPureWaterCreature(actor) || actor.getClass().isPureFlyingCreature(actor))
+            return false;
+
+        cancelPathRequest();
+
+        const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
+        mPathRequest = navigator->requestPath(halfExtents, getPathStepSize(actor), startPoint, endPoint, flags);
+        mRequestedStart = startPoint;
+        mRequestedEnd = endPoint;
+        mRequestedCell = cell;
+
+        return mPathRequest != 0;
+    }
+
+    bool PathFinder::updatePathRequest(const MWWorld::ConstPtr& actor, const PathgridGraph& pathgridGraph)
+    {
+        if (mPathRequest == 0)
+            return false;
+
+        const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
+        auto result = navigator->takePath(mPathRequest);
+
+        if (!result)
+            return false;
+
+        mPathRequest = 0;
+
+        // Pathgrid fallback needs the cell the path was requested in
+        if (result->mStatus == DetourNavigator::Status::PathRequestNotFound || actor.getCell() != mRequestedCell)
+            return false;
+
+        if (result->mStatus != DetourNavigator::Status::Success
+                && result->mStatus != DetourNavigator::Status::NavMeshNotFound)
+        {
+            Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(result->mStatus)
+                << "\" for \"" << actor.getClass().getName(actor) << "\" (" << actor.getBase()
+                << ") from " << mRequestedStart << " to " << mRequestedEnd;
+        }
+
+        mPath.assign(result->mPath.begin(), result->mPath.end());
+        mCell = mRequestedCell;
+
+        if (mPath.empty())
+            buildPathByPathgridImpl(mRequestedStart, mRequestedEnd, pathgridGraph, std::back_inserter(mPath));
+
+        mConstructed = true;
+        return true;
+    }
+
+    PathFinder::PathFinder(const PathFinder& other)
+        : mConstructed(other.mConstructed)
+        , mPath(other.mPath)
+        , mCell(other.mCell)
+        , mPathRequest(0)
+        , mRequestedStart(other.mRequestedStart)
+        , mRequestedEnd(other.mRequestedEnd)
+        , mRequestedCell(other.mRequestedCell)
+    {
+    }
+
+    PathFinder& PathFinder::operator=(const PathFinder& other)
+    {
+        if (this == &other)
+            return *this;
+
+        cancelPathRequest();
+        mConstructed = other.mConstructed;
+        mPath = other.mPath;
+        mCell = other.mCell;
+        mRequestedStart = other.mRequestedStart;
+        mRequestedEnd = other.mRequestedEnd;
+        mRequestedCell = other.mRequestedCell;
+        return *this;
+    }
+
+    PathFinder::~PathFinder()
+    {
+        cancelPathRequest();
+    }
+
+    void PathFinder::cancelPathRequest()
+    {
+        if (mPathRequest == 0)
+            return;
+
+        MWBase::Environment::get().getWorld()->getNavigator()->cancelPath(mPathRequest);
+        mPathRequest = 0;
+    }
+
     bool PathFinder::buildPathByNavigatorImpl(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
         const osg::Vec3f& endPoint, const osg::Vec3f& halfExtents, const DetourNavigator::Flags flags,
         std::back_insert_iterator<std::deque<osg::Vec3f>> out)
@@ -6,6 +6,7 @@
 #include <iterator>
 
 #include <components/detournavigator/flags.hpp>
+#include <components/detournavigator/pathrequest.hpp>
 #include <components/esm/defs.hpp>
 #include <components/esm/loadpgrd.hpp>
 
@@ -74,11 +75,21 @@ namespace MWMechanics
             PathFinder()
                 : mConstructed(false)
                 , mCell(nullptr)
+                , mPathRequest(0)
+                , mRequestedCell(nullptr)
             {
             }
 
+            /// The request of \a other is not shared, the copy finds its own path when it needs one
+            PathFinder(const PathFinder& other);
+
+            PathFinder& operator=(const PathFinder& other);
+
+            ~PathFinder();
+
             void clearPath()
             {
+                cancelPathRequest();
                 mConstructed = false;
                 mPath.clear();
                 mCell = nullptr;
@@ -96,15 +107,31 @@ namespace MWMechanics
                 const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph, const osg::Vec3f& halfExtents,
                 const DetourNavigator::Flags flags);
 
+            /// Request the same path as buildPath builds to be found by navigator in background. Current path is kept
+            /// until the result is applied by updatePathRequest.
+            /// @return false if navigator doesn't find paths in background, buildPath should be used instead
+            bool requestPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
+                const MWWorld::CellStore* cell, const osg::Vec3f& halfExtents, const DetourNavigator::Flags flags);
+
+            /// Replace current path by the requested one if it's found, fall back to pathgrid like buildPath does
+            /// @return true if path is replaced
+            bool updatePathRequest(const MWWorld::ConstPtr& actor, const PathgridGraph& pathgridGraph);
+
+            bool isPathRequested() const
+            {
+                return mPathRequest != 0;
+            }
+
             void buildPathByNavMeshToNextPoint(const MWWorld::ConstPtr& actor, const osg::Vec3f& halfExtents,
                 const DetourNavigator::Flags flags, const float pointTolerance);
 
             /// Remove front point if exist and within tolerance
             void update(const osg::Vec3f& position, const float pointTolerance, const float destinationTolerance);
 
+            /// Path isn't completed while a new one is requested
             bool checkPathCompleted() const
             {
-                return mConstructed && mPath.empty();
+                return mConstructed && mPath.empty() && mPathRequest == 0;
             }
 
             /// In radians
@@ -198,6 +225,13 @@ namespace MWMechanics
 
             const MWWorld::CellStore* mCell;
 
+            DetourNavigator::PathRequestId mPathRequest;
+            osg::Vec3f mRequestedStart;
+            osg::Vec3f mRequestedEnd;
+            const MWWorld::CellStore* mRequestedCell;
+
+            void cancelPathRequest();
+
             void buildPathByPathgridImpl(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
                 const PathgridGraph& pathgridGraph, std::back_insert_iterator<std::deque<osg::Vec3f>> out);
 
@@ -31,6 +31,11 @@ namespace MWPhysics
 
     public:
         static osg::Vec3f traceDown(const MWWorld::Ptr &ptr, const osg::Vec3f& position, Actor* actor, btCollisionWorld* collisionWorld, float maxHeight);
+        /// Apply the side effects of a jump requested by the actor's movement settings (skill progress, fatigue).
+        /// Not thread safe, must be called before the movement of the actor is solved.
+        static void jump(const MWWorld::Ptr &ptr);
+        /// @note Only modifies \a physicActor and \a standingCollisionTracker, so the movement of different actors
+        /// can be solved in parallel as long as the collision world is not modified.
         static osg::Vec3f move(osg::Vec3f position, const MWWorld::Ptr &ptr, Actor* physicActor, const osg::Vec3f &movement, float time,
                                bool isFlying, float waterlevel, float slowFall, const btCollisionWorld* collisionWorld,
                                std::map<MWWorld::Ptr, MWWorld::Ptr>& standingCollisionTracker);
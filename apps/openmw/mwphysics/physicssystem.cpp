@@ -1,6 +1,10 @@
 #include "physicssystem.hpp"
 
+#include <functional>
+
 #include <osg/Group>
+#include <osg/Stats>
+#include <osg/Timer>
 
 #include <BulletCollision/CollisionShapes/btConeShape.h>
 #include <BulletCollision/CollisionShapes/btSphereShape.h>
@@ -21,6 +25,8 @@
 #include <components/misc/constants.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/unrefqueue.hpp>
+#include <components/sceneutil/workqueue.hpp>
+#include <components/settings/settings.hpp>
 #include <components/misc/convert.hpp>
 
 #include <components/nifosg/particle.hpp> // FindRecIndexVisitor
@@ -61,12 +67,19 @@ namespace MWPhysics
         , mWaterEnabled(false)
         , mParentNode(parentNode)
         , mPhysicsDt(1.f / 60.f)
+        , mNumMovementThreads(0)
+        , mNumSteps(0)
+        , mNumActorsStat(0)
+        , mNumStepsStat(0)
+        , mSolveTime(0)
+        , mWaitTime(0)
     {
         mResourceSystem->addResourceManager(mShapeManager.get());
 
         mCollisionConfiguration = new btDefaultCollisionConfiguration();
         mDispatcher = new btCollisionDispatcher(mCollisionConfiguration);
-        mBroadphase = new btDbvtBroadphase();
+        btDbvtBroadphase* broadphase = new btDbvtBroadphase();
+        mBroadphase = broadphase;
 
         mCollisionWorld = new btCollisionWorld(mDispatcher, mBroadphase, mCollisionConfiguration);
 
@@ -85,10 +98,30 @@ namespace MWPhysics
                 Log(Debug::Warning) << "Warning: using custom physics framerate (" << physFramerate << " FPS).";
             }
         }
+
+        int numThreads = Settings::Manager::getInt("actor movement threads", "Physics");
+        if (numThreads > 0)
+        {
+            // Bullet only allocates a ray test stack per thread when it was built with BT_THREADSAFE,
+            // otherwise concurrent sweep tests against the same broadphase would corrupt each other.
+            if (broadphase->m_rayTestStacks.size() > 1)
+            {
+                mNumMovementThreads = numThreads;
+                mMovementThreads = new SceneUtil::WorkQueue(numThreads);
+            }
+            else
+                Log(Debug::Warning) << "Warning: Bullet was built without multithreading support, actor movement will be solved on the main thread.";
+        }
+
+        if (Settings::Manager::getBool("async simulation", "Physics"))
+            mAsyncThread = new SceneUtil::WorkQueue(1);
     }
 
     PhysicsSystem::~PhysicsSystem()
     {
+        if (mAsyncWork)
+            mAsyncWork->waitTillDone();
+
         mResourceSystem->removeResourceManager(mShapeManager.get());
 
         if (mWaterCollisionObject.get())
@@ -675,26 +708,89 @@ namespace MWPhysics
         mStandingCollisions.clear();
     }
 
-    const PtrVelocityList& PhysicsSystem::applyQueuedMovement(float dt)
+    namespace
     {
-        mMovementResults.clear();
+        /// Solves the movement of every n-th actor of a frame
+        class MovementWorkItem : public SceneUtil::WorkItem
+        {
+        public:
+            MovementWorkItem(std::function<void(size_t)> solve, size_t first, size_t count, size_t stride)
+                : mSolve(solve)
+                , mFirst(first)
+                , mCount(count)
+                , mStride(stride)
+            {
+            }
+
+            virtual void doWork()
+            {
+                for (size_t i = mFirst; i < mCount; i += mStride)
+                    mSolve(i);
+            }
+
+        private:
+            std::function<void(size_t)> mSolve;
+            size_t mFirst;
+            size_t mCount;
+            size_t mStride;
+        };
+
+        /// Solves the queued movement while the main thread renders the frame
+        class AsyncMovementWorkItem : public SceneUtil::WorkItem
+        {
+        public:
+            AsyncMovementWorkItem(std::function<void()> solve)
+                : mSolve(solve)
+            {
+            }
+
+            virtual void doWork()
+            {
+                mSolve();
+            }
+
+        private:
+            std::function<void()> mSolve;
+        };
+    }
+
+    void PhysicsSystem::solveMovement(ActorFrame& frame, int numSteps, bool updateActor) const
+    {
+        for (int i=0; i<numSteps; ++i)
+        {
+            const osg::Vec3f position = MovementSolver::move(frame.mPosition, frame.mActor->getPtr(), frame.mActor, frame.mMovement, mPhysicsDt,
+                                                             frame.mFlying, frame.mWaterlevel, frame.mSlowFall, mCollisionWorld, frame.mStandingCollisions);
+            if (position != frame.mPosition)
+                frame.mPositionChanged = true;
+            frame.mLastStepPosition = frame.mPosition;
+            frame.mPosition = position;
+            if (updateActor)
+                frame.mActor->setPosition(position); // always set even if unchanged to make sure interpolation is correct
+        }
+    }
+
+    void PhysicsSystem::prepareQueuedMovement(float dt)
+    {
+        mFrames.clear();
 
         mTimeAccum += dt;
 
         const int maxAllowedSteps = 20;
-        int numSteps = mTimeAccum / (mPhysicsDt);
-        numSteps = std::min(numSteps, maxAllowedSteps);
+        mNumSteps = mTimeAccum / (mPhysicsDt);
+        mNumSteps = std::min(mNumSteps, maxAllowedSteps);
 
-        mTimeAccum -= numSteps * mPhysicsDt;
+        mTimeAccum -= mNumSteps * mPhysicsDt;
 
-        if (numSteps)
+        if (mNumSteps)
         {
             // Collision events should be available on every frame
             mStandingCollisions.clear();
         }
 
-        const MWWorld::Ptr player = MWMechanics::getPlayer();
         const MWBase::World *world = MWBase::Environment::get().getWorld();
+
+        mFrames.reserve(mMovementQueue.size());
+
         PtrVelocityList::iterator iter = mMovementQueue.begin();
         for(;iter != mMovementQueue.end();++iter)
         {
@@ -724,47 +820,150 @@ namespace MWPhysics
             }
             physicActor->setCanWaterWalk(waterCollision);
 
+            if (mNumSteps && physicActor->getCollisionMode() && iter->first.getClass().isMobile(iter->first))
+                MovementSolver::jump(iter->first);
+
+            ActorFrame frame;
+            frame.mPtr = iter->first;
+            frame.mActor = physicActor;
+            frame.mMovement = iter->second;
+            frame.mWaterlevel = waterlevel;
             // Slow fall reduces fall speed by a factor of (effect magnitude / 200)
-            float slowFall = 1.f - std::max(0.f, std::min(1.f, effects.get(ESM::MagicEffect::SlowFall).getMagnitude() * 0.005f));
+            frame.mSlowFall = 1.f - std::max(0.f, std::min(1.f, effects.get(ESM::MagicEffect::SlowFall).getMagnitude() * 0.005f));
+            frame.mFlying = world->isFlying(iter->first);
+            frame.mSwimming = world->isSwimming(iter->first);
+            frame.mWasOnGround = physicActor->getOnGround();
+            frame.mPosition = physicActor->getPosition();
+            frame.mLastStepPosition = frame.mPosition;
+            frame.mOldHeight = frame.mPosition.z();
+            frame.mPositionChanged = false;
+            mFrames.push_back(frame);
+        }
+
+        mMovementQueue.clear();
+    }
 
-            bool flying = world->isFlying(iter->first);
-            bool swimming = world->isSwimming(iter->first);
+    bool PhysicsSystem::solveQueuedMovement(bool snapshot)
+    {
+        const osg::Timer_t start = osg::Timer::instance()->tick();
 
-            bool wasOnGround = physicActor->getOnGround();
-            osg::Vec3f position = physicActor->getPosition();
-            float oldHeight = position.z();
-            bool positionChanged = false;
-            for (int i=0; i<numSteps; ++i)
+        if (mMovementThreads && mNumSteps && mFrames.size() > 1)
+        {
+            // Solve the movement of all actors against the collision world as it was at the start of the frame,
+            // and apply the results afterwards in queue order, so that the outcome does not depend on thread timing.
+            const size_t numItems = std::min<size_t>(mNumMovementThreads, mFrames.size());
+            std::vector<osg::ref_ptr<SceneUtil::WorkItem> > items;
+            for (size_t i = 0; i < numItems; ++i)
             {
-                position = MovementSolver::move(position, physicActor->getPtr(), physicActor, iter->second, mPhysicsDt,
-                                                flying, waterlevel, slowFall, mCollisionWorld, mStandingCollisions);
-                if (position != physicActor->getPosition())
-                    positionChanged = true;
-                physicActor->setPosition(position); // always set even if unchanged to make sure interpolation is correct
+                osg::ref_ptr<SceneUtil::WorkItem> item = new MovementWorkItem(
+                    [this] (size_t index) { solveMovement(mFrames[index], mNumSteps, false); },
+                    i, mFrames.size(), numItems);
+                mMovementThreads->addWorkItem(item);
+                items.push_back(item);
             }
-            if (positionChanged)
+            for (auto& item : items)
+                item->waitTillDone();
+            snapshot = true;
+        }
+        else
+        {
+            for (ActorFrame& frame : mFrames)
+                solveMovement(frame, mNumSteps, !snapshot);
+        }
+
+        mSolveTime = osg::Timer::instance()->delta_s(start, osg::Timer::instance()->tick());
+
+        return snapshot;
+    }
+
+    const PtrVelocityList& PhysicsSystem::finishQueuedMovement(bool applyPositions)
+    {
+        mMovementResults.clear();
+
+        const MWWorld::Ptr player = MWMechanics::getPlayer();
+
+        for (ActorFrame& frame : mFrames)
+        {
+            Actor* physicActor = frame.mActor;
+            const osg::Vec3f& position = frame.mPosition;
+
+            if (applyPositions && mNumSteps)
+            {
+                physicActor->setPosition(frame.mLastStepPosition);
+                physicActor->setPosition(position);
+            }
+
+            if (frame.mPositionChanged)
                 mCollisionWorld->updateSingleAabb(physicActor->getCollisionObject());
 
+            for (const auto& collision : frame.mStandingCollisions)
+                mStandingCollisions[collision.first] = collision.second;
+
             float interpolationFactor = mTimeAccum / mPhysicsDt;
             osg::Vec3f interpolated = position * interpolationFactor + physicActor->getPreviousPosition() * (1.f - interpolationFactor);
 
-            float heightDiff = position.z() - oldHeight;
+            float heightDiff = position.z() - frame.mOldHeight;
 
-            MWMechanics::CreatureStats& stats = iter->first.getClass().getCreatureStats(iter->first);
-            bool isStillOnGround = (numSteps > 0 && wasOnGround && physicActor->getOnGround());
-            if (isStillOnGround || flying || swimming || slowFall < 1)
-                stats.land(iter->first == player && (flying || swimming));
+            MWMechanics::CreatureStats& stats = frame.mPtr.getClass().getCreatureStats(frame.mPtr);
+            bool isStillOnGround = (mNumSteps > 0 && frame.mWasOnGround && physicActor->getOnGround());
+            if (isStillOnGround || frame.mFlying || frame.mSwimming || frame.mSlowFall < 1)
+                stats.land(frame.mPtr == player && (frame.mFlying || frame.mSwimming));
             else if (heightDiff < 0)
                 stats.addToFallHeight(-heightDiff);
 
-            mMovementResults.push_back(std::make_pair(iter->first, interpolated));
+            mMovementResults.push_back(std::make_pair(frame.mPtr, interpolated));
         }
 
-        mMovementQueue.clear();
+        mNumActorsStat = mFrames.size();
+        mNumStepsStat = mNumSteps;
+        mFrames.clear();
 
         return mMovementResults;
     }
 
+    const PtrVelocityList& PhysicsSystem::applyQueuedMovement(float dt)
+    {
+        prepareQueuedMovement(dt);
+        mWaitTime = 0;
+        return finishQueuedMovement(solveQueuedMovement(false));
+    }
+
+    void PhysicsSystem::submitQueuedMovement(float dt)
+    {
+        prepareQueuedMovement(dt);
+        mAsyncWork = new AsyncMovementWorkItem([this] { solveQueuedMovement(true); });
+        mAsyncThread->addWorkItem(mAsyncWork);
+    }
+
+    const PtrVelocityList& PhysicsSystem::collectQueuedMovement()
+    {
+        if (!mAsyncWork)
+        {
+            mMovementResults.clear();
+            return mMovementResults;
+        }
+
+        const osg::Timer_t start = osg::Timer::instance()->tick();
+        mAsyncWork->waitTillDone();
+        mAsyncWork = nullptr;
+        mWaitTime = osg::Timer::instance()->delta_s(start, osg::Timer::instance()->tick());
+
+        return finishQueuedMovement(true);
+    }
+
+    bool PhysicsSystem::isAsync() const
+    {
+        return mAsyncThread != nullptr;
+    }
+
+    void PhysicsSystem::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Physics Actors", mNumActorsStat);
+        stats.setAttribute(frameNumber, "Physics Steps", mNumStepsStat);
+        stats.setAttribute(frameNumber, "Physics Solve ms", mSolveTime * 1000.0);
+        stats.setAttribute(frameNumber, "Physics Wait ms", mWaitTime * 1000.0);
+    }
+
     void PhysicsSystem::stepSimulation(float dt)
     {
         for (Object* animatedObject :  mAnimatedObjects)
@@ -7,6 +7,7 @@
 #include <algorithm>
 
 #include <osg/Quat>
+#include <osg/Vec3f>
 #include <osg/ref_ptr>
 
 #include "../mwworld/ptr.hpp"
@@ -17,6 +18,7 @@ namespace osg
 {
     class Group;
     class Object;
+    class Stats;
 }
 
 namespace MWRender
@@ -33,6 +35,8 @@ namespace Resource
 namespace SceneUtil
 {
     class UnrefQueue;
+    class WorkItem;
+    class WorkQueue;
 }
 
 class btCollisionWorld;
@@ -150,6 +154,19 @@ namespace MWPhysics
             /// Apply all queued movements, then clear the list.
             const PtrVelocityList& applyQueuedMovement(float dt);
 
+            /// Start solving the queued movements on the physics thread, then clear the list.
+            /// @note Requires asynchronous simulation. The collision world must not be modified until collectQueuedMovement() is called.
+            void submitQueuedMovement(float dt);
+
+            /// Wait for the movements started by submitQueuedMovement() and apply them.
+            /// @return the moved actors, empty if nothing was submitted
+            const PtrVelocityList& collectQueuedMovement();
+
+            /// Is the movement of actors solved while the previous frame is rendered?
+            bool isAsync() const;
+
+            void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
             /// Clear the queued movements list without applying.
             void clearQueuedMovement();
 
@@ -221,8 +238,45 @@ namespace MWPhysics
             // replaces all occurrences of 'old' in the map by 'updated', no matter if it's a key or value
             void updateCollisionMapPtr(CollisionMap& map, const MWWorld::Ptr &old, const MWWorld::Ptr &updated);
 
+            // Input and results of the movement solver for a queued actor
+            struct ActorFrame
+            {
+                MWWorld::Ptr mPtr;
+                Actor* mActor;
+                osg::Vec3f mMovement;
+                float mWaterlevel;
+                float mSlowFall;
+                bool mFlying;
+                bool mSwimming;
+                bool mWasOnGround;
+                float mOldHeight;
+
+                osg::Vec3f mPosition;
+                osg::Vec3f mLastStepPosition; // position before the last simulation step
+                bool mPositionChanged;
+                CollisionMap mStandingCollisions;
+            };
+
+            /// Move the queued actors into mFrames and apply the effects that need the game state (jumping, water walking).
+            void prepareQueuedMovement(float dt);
+
+            /// Run the movement solver for the actors in mFrames. Does not modify the game state, so it can run on another thread.
+            /// @param snapshot Do not move the collision objects, they are moved by finishQueuedMovement().
+            /// @return whether the collision objects still have to be moved
+            bool solveQueuedMovement(bool snapshot);
+
+            /// Run the movement solver for \a numSteps simulation steps.
+            /// @param updateActor Move the actor's collision object after each step. If false, only \a frame is updated
+            /// and the collision world is not modified, so that the movement of several actors can be solved in parallel.
+            void solveMovement(ActorFrame& frame, int numSteps, bool updateActor) const;
+
+            /// Apply the results of the movement solver in queue order.
+            const PtrVelocityList& finishQueuedMovement(bool applyPositions);
+
             PtrVelocityList mMovementQueue;
             PtrVelocityList mMovementResults;
+            std::vector<ActorFrame> mFrames;
+            int mNumSteps;
 
             float mTimeAccum;
 
@@ -238,6 +292,19 @@ namespace MWPhysics
 
             float mPhysicsDt;
 
+            // Optional worker threads solving the movement of actors in parallel
+            osg::ref_ptr<SceneUtil::WorkQueue> mMovementThreads;
+            unsigned int mNumMovementThreads;
+
+            // Solves the queued movement while the frame is rendered, if asynchronous simulation is enabled
+            osg::ref_ptr<SceneUtil::WorkQueue> mAsyncThread;
+            osg::ref_ptr<SceneUtil::WorkItem> mAsyncWork;
+
+            std::size_t mNumActorsStat;
+            int mNumStepsStat;
+            double mSolveTime;
+            double mWaitTime;
+
             PhysicsSystem (const PhysicsSystem&);
             PhysicsSystem& operator= (const PhysicsSystem&);
     };
@@ -148,25 +148,13 @@ namespace
         }
     };
 
-    NifOsg::TextKeyMap::const_iterator findGroupStart(const NifOsg::TextKeyMap &keys, const std::string &groupname)
-    {
-        NifOsg::TextKeyMap::const_iterator iter(keys.begin());
-        for(;iter != keys.end();++iter)
-        {
-            if(iter->second.compare(0, groupname.size(), groupname) == 0 &&
-               iter->second.compare(groupname.size(), 2, ": ") == 0)
-                break;
-        }
-        return iter;
-    }
-
-    float calcAnimVelocity(const std::multimap<float, std::string>& keys,
+    float calcAnimVelocity(const NifOsg::TextKeyIndex& keys,
                                       NifOsg::KeyframeController *nonaccumctrl, const osg::Vec3f& accum, const std::string &groupname)
     {
-        const std::string start = groupname+": start";
-        const std::string loopstart = groupname+": loop start";
-        const std::string loopstop = groupname+": loop stop";
-        const std::string stop = groupname+": stop";
+        const NifOsg::TextKeyIndex::Group* group = keys.findGroup(groupname);
+        if (!group)
+            return 0.0f;
+
         float starttime = std::numeric_limits<float>::max();
         float stoptime = 0.0f;
 
@@ -176,24 +164,24 @@ namespace
         // but the animation velocity calculation uses the second one.
         // As result the animation velocity calculation is not correct, and this incorrect velocity must be replicated,
         // because otherwise the Creature's Speed (dagoth uthol) would not be sufficient to move fast enough.
-        NifOsg::TextKeyMap::const_reverse_iterator keyiter(keys.rbegin());
-        while(keyiter != keys.rend())
+        std::vector<NifOsg::TextKeyIndex::GroupKey>::const_reverse_iterator keyiter(group->mKeys.rbegin());
+        while(keyiter != group->mKeys.rend())
         {
-            if(keyiter->second == start || keyiter->second == loopstart)
+            if(keyiter->mMarker == NifOsg::TextKeyIndex::Marker_Start || keyiter->mMarker == NifOsg::TextKeyIndex::Marker_LoopStart)
             {
-                starttime = keyiter->first;
+                starttime = keys.getKeys()[keyiter->mKey].mTime;
                 break;
             }
             ++keyiter;
         }
-        keyiter = keys.rbegin();
-        while(keyiter != keys.rend())
+        keyiter = group->mKeys.rbegin();
+        while(keyiter != group->mKeys.rend())
         {
-            if (keyiter->second == stop)
-                stoptime = keyiter->first;
-            else if (keyiter->second == loopstop)
+            if (keyiter->mMarker == NifOsg::TextKeyIndex::Marker_Stop)
+                stoptime = keys.getKeys()[keyiter->mKey].mTime;
+            else if (keyiter->mMarker == NifOsg::TextKeyIndex::Marker_LoopStop)
             {
-                stoptime = keyiter->first;
+                stoptime = keys.getKeys()[keyiter->mKey].mTime;
                 break;
             }
             ++keyiter;
@@ -545,7 +533,7 @@ namespace MWRender
 
         ControllerMap mControllerMap[Animation::sNumBlendMasks];
 
-        const std::multimap<float, std::string>& getTextKeys() const;
+        const NifOsg::TextKeyIndex& getTextKeys() const;
     };
 
     void UpdateVfxCallback::operator()(osg::Node* node, osg::NodeVisitor* nv)
@@ -694,9 +682,9 @@ namespace MWRender
         return 0;
     }
 
-    const std::multimap<float, std::string> &Animation::AnimSource::getTextKeys() const
+    const NifOsg::TextKeyIndex &Animation::AnimSource::getTextKeys() const
     {
-        return mKeyframes->mTextKeys;
+        return mKeyframes->mTextKeyIndex;
     }
 
     void Animation::loadAllAnimationsInFolder(const std::string &model, const std::string &baseModel)
@@ -816,8 +804,7 @@ namespace MWRender
         AnimSourceList::const_iterator iter(mAnimSources.begin());
         for(;iter != mAnimSources.end();++iter)
         {
-            const NifOsg::TextKeyMap &keys = (*iter)->getTextKeys();
-            if(findGroupStart(keys, anim) != keys.end())
+            if((*iter)->getTextKeys().findGroup(anim))
                 return true;
         }
 
@@ -828,11 +815,11 @@ namespace MWRender
     {
         for(AnimSourceList::const_reverse_iterator iter(mAnimSources.rbegin()); iter != mAnimSources.rend(); ++iter)
         {
-            const NifOsg::TextKeyMap &keys = (*iter)->getTextKeys();
+            const NifOsg::TextKeyIndex &keys = (*iter)->getTextKeys();
 
-            NifOsg::TextKeyMap::const_iterator found = findGroupStart(keys, groupname);
-            if(found != keys.end())
-                return found->first;
+            const NifOsg::TextKeyIndex::Group* found = keys.findGroup(groupname);
+            if(found)
+                return keys.getKeys()[found->mKeys.front().mKey].mTime;
         }
         return -1.f;
     }
@@ -841,44 +828,33 @@ namespace MWRender
     {
         for(AnimSourceList::const_reverse_iterator iter(mAnimSources.rbegin()); iter != mAnimSources.rend(); ++iter)
         {
-            const NifOsg::TextKeyMap &keys = (*iter)->getTextKeys();
-
-            for(NifOsg::TextKeyMap::const_iterator iterKey(keys.begin()); iterKey != keys.end(); ++iterKey)
-            {
-                if(iterKey->second.compare(0, textKey.size(), textKey) == 0)
-                    return iterKey->first;
-            }
+            const NifOsg::TextKeyIndex::Key* found = (*iter)->getTextKeys().findKey(textKey);
+            if(found)
+                return found->mTime;
         }
 
         return -1.f;
     }
 
-    void Animation::handleTextKey(AnimState &state, const std::string &groupname, const std::multimap<float, std::string>::const_iterator &key,
-                       const std::multimap<float, std::string>& map)
+    void Animation::handleTextKey(AnimState &state, const std::string &groupname, const NifOsg::TextKeyIndex::Key &key)
     {
-        const std::string &evt = key->second;
-
-        size_t off = groupname.size()+2;
-        size_t len = evt.size() - off;
-
-        if(evt.compare(0, groupname.size(), groupname) == 0 &&
-           evt.compare(groupname.size(), 2, ": ") == 0)
+        if(key.mGroup == state.mGroup)
         {
-            if(evt.compare(off, len, "loop start") == 0)
-                state.mLoopStartTime = key->first;
-            else if(evt.compare(off, len, "loop stop") == 0)
-                state.mLoopStopTime = key->first;
+            if(key.mMarker == NifOsg::TextKeyIndex::Marker_LoopStart)
+                state.mLoopStartTime = key.mTime;
+            else if(key.mMarker == NifOsg::TextKeyIndex::Marker_LoopStop)
+                state.mLoopStopTime = key.mTime;
         }
 
         if (mTextKeyListener)
         {
             try
             {
-                mTextKeyListener->handleTextKey(groupname, key, map);
+                mTextKeyListener->handleTextKey(groupname, key);
             }
             catch (std::exception& e)
             {
-                Log(Debug::Error) << "Error handling text key " << evt << ": " << e.what();
+                Log(Debug::Error) << "Error handling text key " << key.mText << ": " << e.what();
             }
         }
     }
@@ -917,7 +893,7 @@ namespace MWRender
         AnimSourceList::reverse_iterator iter(mAnimSources.rbegin());
         for(;iter != mAnimSources.rend();++iter)
         {
-            const NifOsg::TextKeyMap &textkeys = (*iter)->getTextKeys();
+            const NifOsg::TextKeyIndex &textkeys = (*iter)->getTextKeys();
             if(reset(state, textkeys, groupname, start, stop, startpoint, loopfallback))
             {
                 state.mSource = *iter;
@@ -931,10 +907,10 @@ namespace MWRender
 
                 if (state.mPlaying)
                 {
-                    NifOsg::TextKeyMap::const_iterator textkey(textkeys.lower_bound(state.getTime()));
-                    while(textkey != textkeys.end() && textkey->first <= state.getTime())
+                    std::vector<NifOsg::TextKeyIndex::Key>::const_iterator textkey(textkeys.getKeys().begin() + textkeys.lowerBound(state.getTime()));
+                    while(textkey != textkeys.getKeys().end() && textkey->mTime <= state.getTime())
                     {
-                        handleTextKey(state, groupname, textkey, textkeys);
+                        handleTextKey(state, groupname, *textkey);
                         ++textkey;
                     }
                 }
@@ -947,10 +923,10 @@ namespace MWRender
                     if(state.getTime() >= state.mLoopStopTime)
                         break;
 
-                    NifOsg::TextKeyMap::const_iterator textkey(textkeys.lower_bound(state.getTime()));
-                    while(textkey != textkeys.end() && textkey->first <= state.getTime())
+                    std::vector<NifOsg::TextKeyIndex::Key>::const_iterator textkey(textkeys.getKeys().begin() + textkeys.lowerBound(state.getTime()));
+                    while(textkey != textkeys.getKeys().end() && textkey->mTime <= state.getTime())
                     {
-                        handleTextKey(state, groupname, textkey, textkeys);
+                        handleTextKey(state, groupname, *textkey);
                         ++textkey;
                     }
                 }
@@ -962,76 +938,60 @@ namespace MWRender
         resetActiveGroups();
     }
 
-    bool Animation::reset(AnimState &state, const NifOsg::TextKeyMap &keys, const std::string &groupname, const std::string &start, const std::string &stop, float startpoint, bool loopfallback)
+    bool Animation::reset(AnimState &state, const NifOsg::TextKeyIndex &keys, const std::string &groupname, const std::string &start, const std::string &stop, float startpoint, bool loopfallback)
     {
+        const NifOsg::TextKeyIndex::Group* group = keys.findGroup(groupname);
+        if(!group)
+            return false;
+
         // Look for text keys in reverse. This normally wouldn't matter, but for some reason undeadwolf_2.nif has two
         // separate walkforward keys, and the last one is supposed to be used.
-        NifOsg::TextKeyMap::const_reverse_iterator groupend(keys.rbegin());
-        for(;groupend != keys.rend();++groupend)
-        {
-            if(groupend->second.compare(0, groupname.size(), groupname) == 0 &&
-               groupend->second.compare(groupname.size(), 2, ": ") == 0)
-                break;
-        }
-
-        std::string starttag = groupname+": "+start;
-        NifOsg::TextKeyMap::const_reverse_iterator startkey(groupend);
-        while(startkey != keys.rend() && startkey->second != starttag)
-            ++startkey;
-        if(startkey == keys.rend() && start == "loop start")
-        {
-            starttag = groupname+": start";
-            startkey = groupend;
-            while(startkey != keys.rend() && startkey->second != starttag)
-                ++startkey;
-        }
-        if(startkey == keys.rend())
+        size_t startkey = group->findLast(start);
+        if(startkey == NifOsg::TextKeyIndex::sNone && start == "loop start")
+            startkey = group->findLast("start");
+        if(startkey == NifOsg::TextKeyIndex::sNone)
             return false;
 
-        const std::string stoptag = groupname+": "+stop;
-        NifOsg::TextKeyMap::const_reverse_iterator stopkey(groupend);
-        while(stopkey != keys.rend()
-              // We have to ignore extra garbage at the end.
-              // The Scrib's idle3 animation has "Idle3: Stop." instead of "Idle3: Stop".
-              // Why, just why? :(
-              && (stopkey->second.size() < stoptag.size() || stopkey->second.compare(0,stoptag.size(), stoptag) != 0))
-            ++stopkey;
-        if(stopkey == keys.rend())
+        // We have to ignore extra garbage at the end.
+        // The Scrib's idle3 animation has "Idle3: Stop." instead of "Idle3: Stop".
+        // Why, just why? :(
+        const size_t stopkey = group->findLastPrefix(stop);
+        if(stopkey == NifOsg::TextKeyIndex::sNone)
             return false;
 
-        if(startkey->first > stopkey->first)
+        const float starttime = keys.getKeys()[group->mKeys[startkey].mKey].mTime;
+        const float stoptime = keys.getKeys()[group->mKeys[stopkey].mKey].mTime;
+        if(starttime > stoptime)
             return false;
 
-        state.mStartTime = startkey->first;
+        state.mGroup = group->mId;
+        state.mStartTime = starttime;
         if (loopfallback)
         {
-            state.mLoopStartTime = startkey->first;
-            state.mLoopStopTime = stopkey->first;
+            state.mLoopStartTime = starttime;
+            state.mLoopStopTime = stoptime;
         }
         else
         {
-            state.mLoopStartTime = startkey->first;
+            state.mLoopStartTime = starttime;
             state.mLoopStopTime = std::numeric_limits<float>::max();
         }
-        state.mStopTime = stopkey->first;
+        state.mStopTime = stoptime;
 
         state.setTime(state.mStartTime + ((state.mStopTime - state.mStartTime) * startpoint));
 
         // mLoopStartTime and mLoopStopTime normally get assigned when encountering these keys while playing the animation
         // (see handleTextKey). But if startpoint is already past these keys, or start time is == stop time, we need to assign them now.
-        const std::string loopstarttag = groupname+": loop start";
-        const std::string loopstoptag = groupname+": loop stop";
-
-        NifOsg::TextKeyMap::const_reverse_iterator key(groupend);
-        for (; key != startkey && key != keys.rend(); ++key)
+        for (size_t key = group->mKeys.size() - 1; key > startkey; --key)
         {
-            if (key->first > state.getTime())
+            const float time = keys.getKeys()[group->mKeys[key].mKey].mTime;
+            if (time > state.getTime())
                 continue;
 
-            if (key->second == loopstarttag)
-                state.mLoopStartTime = key->first;
-            else if (key->second == loopstoptag)
-                state.mLoopStopTime = key->first;
+            if (group->mKeys[key].mMarker == NifOsg::TextKeyIndex::Marker_LoopStart)
+                state.mLoopStartTime = time;
+            else if (group->mKeys[key].mMarker == NifOsg::TextKeyIndex::Marker_LoopStop)
+                state.mLoopStopTime = time;
         }
 
         return true;
@@ -1192,15 +1152,14 @@ namespace MWRender
         AnimSourceList::const_reverse_iterator animsrc(mAnimSources.rbegin());
         for(;animsrc != mAnimSources.rend();++animsrc)
         {
-            const NifOsg::TextKeyMap &keys = (*animsrc)->getTextKeys();
-            if(findGroupStart(keys, groupname) != keys.end())
+            if((*animsrc)->getTextKeys().findGroup(groupname))
                 break;
         }
         if(animsrc == mAnimSources.rend())
             return 0.0f;
 
         float velocity = 0.0f;
-        const NifOsg::TextKeyMap &keys = (*animsrc)->getTextKeys();
+        const NifOsg::TextKeyIndex &keys = (*animsrc)->getTextKeys();
 
         const AnimSource::ControllerMap& ctrls = (*animsrc)->mControllerMap[0];
         for (AnimSource::ControllerMap::const_iterator it = ctrls.begin(); it != ctrls.end(); ++it)
@@ -1221,7 +1180,7 @@ namespace MWRender
 
             while(!(velocity > 1.0f) && ++animiter != mAnimSources.rend())
             {
-                const NifOsg::TextKeyMap &keys2 = (*animiter)->getTextKeys();
+                const NifOsg::TextKeyIndex &keys2 = (*animiter)->getTextKeys();
 
                 const AnimSource::ControllerMap& ctrls2 = (*animiter)->mControllerMap[0];
                 for (AnimSource::ControllerMap::const_iterator it = ctrls2.begin(); it != ctrls2.end(); ++it)
@@ -1271,8 +1230,8 @@ namespace MWRender
                 continue;
             }
 
-            const NifOsg::TextKeyMap &textkeys = state.mSource->getTextKeys();
-            NifOsg::TextKeyMap::const_iterator textkey(textkeys.upper_bound(state.getTime()));
+            const NifOsg::TextKeyIndex &textkeys = state.mSource->getTextKeys();
+            std::vector<NifOsg::TextKeyIndex::Key>::const_iterator textkey(textkeys.getKeys().begin() + textkeys.upperBound(state.getTime()));
 
             float timepassed = duration * state.mSpeedMult;
             while(state.mPlaying)
@@ -1280,7 +1239,7 @@ namespace MWRender
                 if (!state.shouldLoop())
                 {
                     float targetTime = state.getTime() + timepassed;
-                    if(textkey == textkeys.end() || textkey->first > targetTime)
+                    if(textkey == textkeys.getKeys().end() || textkey->mTime > targetTime)
                     {
                         if(mAccumCtrl && state.mTime == mAnimationTimePtr[0]->getTimePtr())
                             updatePosition(state.getTime(), targetTime, movement);
@@ -1289,16 +1248,16 @@ namespace MWRender
                     else
                     {
                         if(mAccumCtrl && state.mTime == mAnimationTimePtr[0]->getTimePtr())
-                            updatePosition(state.getTime(), textkey->first, movement);
-                        state.setTime(textkey->first);
+                            updatePosition(state.getTime(), textkey->mTime, movement);
+                        state.setTime(textkey->mTime);
                     }
 
                     state.mPlaying = (state.getTime() < state.mStopTime);
                     timepassed = targetTime - state.getTime();
 
-                    while(textkey != textkeys.end() && textkey->first <= state.getTime())
+                    while(textkey != textkeys.getKeys().end() && textkey->mTime <= state.getTime())
                     {
-                        handleTextKey(state, stateiter->first, textkey, textkeys);
+                        handleTextKey(state, stateiter->first, *textkey);
                         ++textkey;
                     }
                 }
@@ -1308,10 +1267,10 @@ namespace MWRender
                     state.setTime(state.mLoopStartTime);
                     state.mPlaying = true;
 
-                    textkey = textkeys.lower_bound(state.getTime());
-                    while(textkey != textkeys.end() && textkey->first <= state.getTime())
+                    textkey = textkeys.getKeys().begin() + textkeys.lowerBound(state.getTime());
+                    while(textkey != textkeys.getKeys().end() && textkey->mTime <= state.getTime())
                     {
-                        handleTextKey(state, stateiter->first, textkey, textkeys);
+                        handleTextKey(state, stateiter->first, *textkey);
                         ++textkey;
                     }
 
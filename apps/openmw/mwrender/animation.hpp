@@ -3,6 +3,7 @@
 
 #include "../mwworld/ptr.hpp"
 
+#include <components/nifosg/textkeyindex.hpp>
 #include <components/sceneutil/controller.hpp>
 #include <components/sceneutil/util.hpp>
 
@@ -147,8 +148,7 @@ public:
     class TextKeyListener
     {
     public:
-        virtual void handleTextKey(const std::string &groupname, const std::multimap<float, std::string>::const_iterator &key,
-                           const std::multimap<float, std::string>& map) = 0;
+        virtual void handleTextKey(const std::string &groupname, const NifOsg::TextKeyIndex::Key &key) = 0;
 
         virtual ~TextKeyListener() = default;
     };
@@ -186,6 +186,8 @@ protected:
 
     struct AnimState {
         std::shared_ptr<AnimSource> mSource;
+        // Id of the played group in the text key index of mSource
+        size_t mGroup;
         float mStartTime;
         float mLoopStartTime;
         float mLoopStopTime;
@@ -203,7 +205,7 @@ protected:
         int mBlendMask;
         bool mAutoDisable;
 
-        AnimState() : mStartTime(0.0f), mLoopStartTime(0.0f), mLoopStopTime(0.0f), mStopTime(0.0f),
+        AnimState() : mGroup(NifOsg::TextKeyIndex::sNone), mStartTime(0.0f), mLoopStartTime(0.0f), mLoopStopTime(0.0f), mStopTime(0.0f),
                       mTime(new float), mSpeedMult(1.0f), mPlaying(false), mLoopingEnabled(true),
                       mLoopCount(0), mPriority(0), mBlendMask(0), mAutoDisable(true)
         {
@@ -296,12 +298,11 @@ protected:
      * the marker is not found, or if the markers are the same, it returns
      * false.
      */
-    bool reset(AnimState &state, const std::multimap<float, std::string> &keys,
+    bool reset(AnimState &state, const NifOsg::TextKeyIndex &keys,
                const std::string &groupname, const std::string &start, const std::string &stop,
                float startpoint, bool loopfallback);
 
-    void handleTextKey(AnimState &state, const std::string &groupname, const std::multimap<float, std::string>::const_iterator &key,
-                       const std::multimap<float, std::string>& map);
+    void handleTextKey(AnimState &state, const std::string &groupname, const NifOsg::TextKeyIndex::Key &key);
 
     /** Sets the root model of the object.
      *
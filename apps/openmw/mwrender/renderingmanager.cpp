@@ -1264,6 +1264,8 @@ namespace MWRender
             stats->setAttribute(frameNumber, "UnrefQueue", mUnrefQueue->getNumItems());
 
             mTerrain->reportStats(frameNumber, stats);
+
+            static_cast<SceneUtil::LightManager*>(mSceneRoot.get())->reportStats(frameNumber, stats);
         }
     }
 
@@ -137,7 +137,7 @@ namespace MWScript
 
     InterpreterContext::InterpreterContext (
         MWScript::Locals *locals, const MWWorld::Ptr& reference, const std::string& targetId)
-    : mLocals (locals), mReference (reference), mTargetId (targetId)
+    : mLocals (locals), mReference (reference), mTargetId (targetId), mSecondsPassed (-1)
     {
         // If we run on a reference (local script, dialogue script or console with object
         // selected), store the ID of that reference store it so it can be inherited by
@@ -146,6 +146,11 @@ namespace MWScript
             mTargetId = reference.getCellRef().getRefId();
     }
 
+    void InterpreterContext::setSecondsPassed (float secondsPassed)
+    {
+        mSecondsPassed = secondsPassed;
+    }
+
     int InterpreterContext::getLocalShort (int index) const
     {
         if (!mLocals)
@@ -494,6 +499,9 @@ namespace MWScript
 
     float InterpreterContext::getSecondsPassed() const
     {
+        if (mSecondsPassed>=0)
+            return mSecondsPassed;
+
         return MWBase::Environment::get().getFrameDuration();
     }
 
@@ -26,6 +26,8 @@ namespace MWScript
 
             std::string mTargetId;
 
+            float mSecondsPassed;
+
             /// If \a id is empty, a reference the script is run from is returned or in case
             /// of a non-local script the reference derived from the target ID.
             MWWorld::Ptr getReferenceImp (const std::string& id = "", bool activeOnly = false,
@@ -52,6 +54,10 @@ namespace MWScript
                 const std::string& targetId = "");
             ///< The ownership of \a locals is not transferred. 0-pointer allowed.
 
+            void setSecondsPassed (float secondsPassed);
+            ///< Return \a secondsPassed instead of the frame duration from getSecondsPassed, for a
+            /// script which was not run in every frame.
+
             virtual int getLocalShort (int index) const;
 
             virtual int getLocalLong (int index) const;
@@ -1,7 +1,9 @@
 #include "miscextensions.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iomanip>
+#include <sstream>
 
 #include <components/compiler/opcodes.hpp>
 #include <components/compiler/locals.hpp>
@@ -1454,6 +1456,41 @@ namespace MWScript
                 }
         };
 
+        class OpShowScriptProfile : public Interpreter::Opcode1
+        {
+            public:
+
+                virtual void execute (Interpreter::Runtime& runtime, unsigned int arg0)
+                {
+                    int count = 10;
+                    if (arg0==1)
+                    {
+                        count = runtime[0].mInteger;
+                        runtime.pop();
+                    }
+
+                    const std::vector<MWBase::ScriptManager::ScriptProfile> profile =
+                        MWBase::Environment::get().getScriptManager()->getProfile (static_cast<std::size_t> (std::max (count, 0)));
+
+                    if (profile.empty())
+                    {
+                        runtime.getContext().report ("No scripts have been run");
+                        return;
+                    }
+
+                    runtime.getContext().report ("Script: runs, total ms, us per run, instructions per run");
+
+                    for (const MWBase::ScriptManager::ScriptProfile& script : profile)
+                    {
+                        std::ostringstream line;
+                        line << std::fixed << std::setprecision (1) << script.mName << ": " << script.mRuns << ", "
+                            << script.mTime * 1000 << ", " << script.mTime * 1e6 / script.mRuns << ", "
+                            << script.mInstructions / script.mRuns;
+                        runtime.getContext().report (line.str());
+                    }
+                }
+        };
+
         void installOpcodes (Interpreter::Interpreter& interpreter)
         {
             interpreter.installSegment5 (Compiler::Misc::opcodeXBox, new OpXBox);
@@ -1560,6 +1597,7 @@ namespace MWScript
             interpreter.installSegment5 (Compiler::Misc::opcodeRepairedOnMe, new OpRepairedOnMe<ImplicitRef>);
             interpreter.installSegment5 (Compiler::Misc::opcodeRepairedOnMeExplicit, new OpRepairedOnMe<ExplicitRef>);
             interpreter.installSegment5 (Compiler::Misc::opcodeToggleRecastMesh, new OpToggleRecastMesh);
+            interpreter.installSegment3 (Compiler::Misc::opcodeShowScriptProfile, new OpShowScriptProfile);
         }
     }
 }
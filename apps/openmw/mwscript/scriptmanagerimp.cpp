@@ -15,11 +15,37 @@
 #include <components/compiler/context.hpp>
 #include <components/compiler/exception.hpp>
 #include <components/compiler/quickfileparser.hpp>
+#include <components/compiler/scriptcache.hpp>
+
+#include <components/sceneutil/workqueue.hpp>
+
+#include <osg/Stats>
+#include <osg/Timer>
 
 #include "../mwworld/esmstore.hpp"
 
 #include "extensions.hpp"
 
+namespace
+{
+    class LoadScriptCacheWorkItem : public SceneUtil::WorkItem
+    {
+    public:
+        LoadScriptCacheWorkItem(Compiler::ScriptCache& cache)
+            : mCache(cache)
+        {
+        }
+
+        virtual void doWork()
+        {
+            mCache.load();
+        }
+
+    private:
+        Compiler::ScriptCache& mCache;
+    };
+}
+
 namespace MWScript
 {
     ScriptManager::ScriptManager (const MWWorld::ESMStore& store,
@@ -27,7 +53,8 @@ namespace MWScript
         const std::vector<std::string>& scriptBlacklist)
     : mErrorHandler(), mStore (store),
       mCompilerContext (compilerContext), mParser (mErrorHandler, mCompilerContext),
-      mOpcodesInstalled (false), mGlobalScripts (store)
+      mOpcodesInstalled (false), mGlobalScripts (store), mPrecompileMaxTime (0), mRuns (0), mInstructions (0),
+      mReportedRuns (0), mReportedInstructions (0)
     {
         mErrorHandler.setWarningsMode (warningsMode);
 
@@ -38,13 +65,67 @@ namespace MWScript
         std::sort (mScriptBlacklist.begin(), mScriptBlacklist.end());
     }
 
+    ScriptManager::~ScriptManager()
+    {
+        if (mCacheLoading)
+            mCacheLoading->waitTillDone();
+
+        if (mCache)
+            mCache->save();
+    }
+
+    void ScriptManager::setCache (std::unique_ptr<Compiler::ScriptCache>&& cache, SceneUtil::WorkQueue* workQueue,
+        float precompileMaxTime)
+    {
+        mCache = std::move (cache);
+        mCacheLoading = new LoadScriptCacheWorkItem (*mCache);
+        workQueue->addWorkItem (mCacheLoading);
+
+        mPrecompileMaxTime = precompileMaxTime;
+        mPrecompileQueue.clear();
+
+        if (mPrecompileMaxTime<=0)
+            return;
+
+        const MWWorld::Store<ESM::Script>& scripts = mStore.get<ESM::Script>();
+
+        for (MWWorld::Store<ESM::Script>::iterator iter = scripts.begin();
+            iter != scripts.end(); ++iter)
+            if (!isBlacklisted (iter->mId))
+                mPrecompileQueue.push_back (iter->mId);
+    }
+
+    bool ScriptManager::isBlacklisted (const std::string& name) const
+    {
+        return std::binary_search (mScriptBlacklist.begin(), mScriptBlacklist.end(),
+            Misc::StringUtils::lowerCase (name));
+    }
+
     bool ScriptManager::compile (const std::string& name)
+    {
+        return compileScript (name, true);
+    }
+
+    bool ScriptManager::compileScript (const std::string& name, bool useCache)
     {
         mParser.reset();
         mErrorHandler.reset();
 
         if (const ESM::Script *script = mStore.get<ESM::Script>().find (name))
         {
+            // compile from source rather than wait for the cache to be loaded
+            if (mCache && useCache && mCacheLoading->isDone())
+            {
+                std::vector<Interpreter::Type_Code> code;
+                Compiler::Locals locals;
+
+                if (mCache->get (name, script->mScriptText, code, locals))
+                {
+                    mScripts.insert (std::make_pair (name, CompiledScript (code, locals)));
+                    return true;
+                }
+            }
+
             mErrorHandler.setContext(name);
 
             bool Success = true;
@@ -79,7 +160,10 @@ namespace MWScript
             {
                 std::vector<Interpreter::Type_Code> code;
                 mParser.getCode (code);
-                mScripts.insert (std::make_pair (name, std::make_pair (code, mParser.getLocals())));
+                mScripts.insert (std::make_pair (name, CompiledScript (code, mParser.getLocals())));
+
+                if (mCache)
+                    mCache->put (name, script->mScriptText, code, mParser.getLocals());
 
                 return true;
             }
@@ -99,7 +183,7 @@ namespace MWScript
             {
                 // failed -> ignore script from now on.
                 std::vector<Interpreter::Type_Code> empty;
-                mScripts.insert (std::make_pair (name, std::make_pair (empty, Compiler::Locals())));
+                mScripts.insert (std::make_pair (name, CompiledScript (empty, Compiler::Locals())));
                 return;
             }
 
@@ -108,7 +192,7 @@ namespace MWScript
         }
 
         // execute script
-        if (!iter->second.first.empty())
+        if (!iter->second.mByteCode.empty())
             try
             {
                 if (!mOpcodesInstalled)
@@ -117,14 +201,23 @@ namespace MWScript
                     mOpcodesInstalled = true;
                 }
 
-                mInterpreter.run (&iter->second.first[0], iter->second.first.size(), interpreterContext);
+                const osg::Timer_t start = osg::Timer::instance()->tick();
+
+                const int instructions = mInterpreter.run (&iter->second.mByteCode[0],
+                    iter->second.mByteCode.size(), interpreterContext);
+
+                iter->second.mTime += osg::Timer::instance()->delta_s (start, osg::Timer::instance()->tick());
+                ++iter->second.mRuns;
+                iter->second.mInstructions += instructions;
+                ++mRuns;
+                mInstructions += instructions;
             }
             catch (const std::exception& e)
             {
                 Log(Debug::Error) << "Execution of script " << name << " failed:";
                 Log(Debug::Error) << e.what();
 
-                iter->second.first.clear(); // don't execute again.
+                iter->second.mByteCode.clear(); // don't execute again.
             }
     }
 
@@ -137,18 +230,50 @@ namespace MWScript
 
         for (MWWorld::Store<ESM::Script>::iterator iter = scripts.begin();
             iter != scripts.end(); ++iter)
-            if (!std::binary_search (mScriptBlacklist.begin(), mScriptBlacklist.end(),
-                Misc::StringUtils::lowerCase (iter->mId)))
+            if (!isBlacklisted (iter->mId))
             {
                 ++count;
 
-                if (compile (iter->mId))
+                // always compile from source, to report all errors and warnings
+                if (compileScript (iter->mId, false))
                     ++success;
             }
 
         return std::make_pair (count, success);
     }
 
+    void ScriptManager::precompile()
+    {
+        // don't block the frame waiting for the cache
+        if (mPrecompileQueue.empty() || !mCacheLoading->isDone())
+            return;
+
+        const osg::Timer_t start = osg::Timer::instance()->tick();
+
+        while (!mPrecompileQueue.empty()
+            && osg::Timer::instance()->delta_s (start, osg::Timer::instance()->tick())<mPrecompileMaxTime)
+        {
+            const std::string name = mPrecompileQueue.back();
+            mPrecompileQueue.pop_back();
+
+            if (mScripts.find (name)!=mScripts.end())
+                continue;
+
+            if (!compile (name))
+            {
+                // failed -> ignore script from now on, like run() does.
+                std::vector<Interpreter::Type_Code> empty;
+                mScripts.insert (std::make_pair (name, CompiledScript (empty, Compiler::Locals())));
+            }
+        }
+
+        if (mPrecompileQueue.empty())
+        {
+            Log(Debug::Verbose) << "Precompiled " << mScripts.size() << " scripts";
+            mCache->save();
+        }
+    }
+
     const Compiler::Locals& ScriptManager::getLocals (const std::string& name)
     {
         std::string name2 = Misc::StringUtils::lowerCase (name);
@@ -157,7 +282,7 @@ namespace MWScript
             ScriptCollection::iterator iter = mScripts.find (name2);
 
             if (iter!=mScripts.end())
-                return iter->second.second;
+                return iter->second.mLocals;
         }
 
         {
@@ -191,4 +316,41 @@ namespace MWScript
     {
         return mGlobalScripts;
     }
+
+    std::vector<MWBase::ScriptManager::ScriptProfile> ScriptManager::getProfile (std::size_t count) const
+    {
+        std::vector<ScriptProfile> profile;
+
+        for (ScriptCollection::const_iterator iter (mScripts.begin()); iter!=mScripts.end(); ++iter)
+            if (iter->second.mRuns>0)
+            {
+                ScriptProfile script;
+                script.mName = iter->first;
+                script.mRuns = iter->second.mRuns;
+                script.mInstructions = iter->second.mInstructions;
+                script.mTime = iter->second.mTime;
+                profile.push_back (script);
+            }
+
+        const auto slower = [] (const ScriptProfile& lhs, const ScriptProfile& rhs) { return lhs.mTime>rhs.mTime; };
+
+        if (profile.size()>count)
+        {
+            std::partial_sort (profile.begin(), profile.begin()+count, profile.end(), slower);
+            profile.resize (count);
+        }
+        else
+            std::sort (profile.begin(), profile.end(), slower);
+
+        return profile;
+    }
+
+    void ScriptManager::reportStats (unsigned int frameNumber, osg::Stats& stats) const
+    {
+        // report the scripts run since the last report, which is usually the last frame
+        stats.setAttribute (frameNumber, "Script Runs", mRuns - mReportedRuns);
+        stats.setAttribute (frameNumber, "Script Instructions", mInstructions - mReportedInstructions);
+        mReportedRuns = mRuns;
+        mReportedInstructions = mInstructions;
+    }
 }
@@ -2,8 +2,11 @@
 #define GAME_SCRIPT_SCRIPTMANAGER_H
 
 #include <map>
+#include <memory>
 #include <string>
 
+#include <osg/ref_ptr>
+
 #include <components/compiler/streamerrorhandler.hpp>
 #include <components/compiler/fileparser.hpp>
 
@@ -22,6 +25,13 @@ namespace MWWorld
 namespace Compiler
 {
     class Context;
+    class ScriptCache;
+}
+
+namespace SceneUtil
+{
+    class WorkItem;
+    class WorkQueue;
 }
 
 namespace Interpreter
@@ -41,13 +51,37 @@ namespace MWScript
             Interpreter::Interpreter mInterpreter;
             bool mOpcodesInstalled;
 
-            typedef std::pair<std::vector<Interpreter::Type_Code>, Compiler::Locals> CompiledScript;
+            struct CompiledScript
+            {
+                std::vector<Interpreter::Type_Code> mByteCode;
+                Compiler::Locals mLocals;
+                std::size_t mRuns;
+                std::size_t mInstructions;
+                double mTime;
+
+                CompiledScript (const std::vector<Interpreter::Type_Code>& code, const Compiler::Locals& locals)
+                : mByteCode (code), mLocals (locals), mRuns (0), mInstructions (0), mTime (0)
+                {}
+            };
+
             typedef std::map<std::string, CompiledScript> ScriptCollection;
 
             ScriptCollection mScripts;
             GlobalScripts mGlobalScripts;
             std::map<std::string, Compiler::Locals> mOtherLocals;
             std::vector<std::string> mScriptBlacklist;
+            std::unique_ptr<Compiler::ScriptCache> mCache;
+            osg::ref_ptr<SceneUtil::WorkItem> mCacheLoading;
+            std::vector<std::string> mPrecompileQueue;
+            float mPrecompileMaxTime;
+            std::size_t mRuns;
+            std::size_t mInstructions;
+            mutable std::size_t mReportedRuns;
+            mutable std::size_t mReportedInstructions;
+
+            bool isBlacklisted (const std::string& name) const;
+
+            bool compileScript (const std::string& name, bool useCache);
 
         public:
 
@@ -55,6 +89,14 @@ namespace MWScript
                 Compiler::Context& compilerContext, int warningsMode,
                 const std::vector<std::string>& scriptBlacklist);
 
+            ~ScriptManager();
+
+            void setCache (std::unique_ptr<Compiler::ScriptCache>&& cache, SceneUtil::WorkQueue* workQueue,
+                float precompileMaxTime);
+            ///< Use compiled scripts stored in \a cache, which is loaded on \a workQueue.
+            /// \param precompileMaxTime Time per frame precompile() may spend on compiling scripts missing
+            /// from the cache (0: disabled).
+
             virtual void run (const std::string& name, Interpreter::Context& interpreterContext);
             ///< Run the script with the given name (compile first, if not compiled yet)
 
@@ -66,10 +108,18 @@ namespace MWScript
             ///< Compile all scripts
             /// \return count, success
 
+            virtual void precompile();
+            ///< Compile some of the scripts missing from the cache.
+
             virtual const Compiler::Locals& getLocals (const std::string& name);
             ///< Return locals for script \a name.
 
             virtual GlobalScripts& getGlobalScripts();
+
+            virtual std::vector<ScriptProfile> getProfile (std::size_t count) const;
+            ///< Return the \a count scripts which took the most time to execute so far.
+
+            virtual void reportStats (unsigned int frameNumber, osg::Stats& stats) const;
     };
 }
 
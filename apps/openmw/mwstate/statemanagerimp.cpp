@@ -4,20 +4,37 @@
 
 #include <components/esm/esmwriter.hpp>
 #include <components/esm/esmreader.hpp>
+#include <components/esm/savedgamestream.hpp>
 #include <components/esm/cellid.hpp>
 #include <components/esm/loadcell.hpp>
 
+#include <components/files/memorystream.hpp>
+
 #include <components/loadinglistener/loadinglistener.hpp>
 
 #include <components/settings/settings.hpp>
 
+#include <components/sceneutil/workqueue.hpp>
+
 #include <osg/Image>
 
 #include <osgDB/Registry>
 
-#include <boost/filesystem/fstream.hpp>
 #include <boost/filesystem/operations.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
 #include "../mwbase/journal.hpp"
@@ -40,6 +57,119 @@
 
 #include "quicksavemanager.hpp"
 
+namespace
+{
+    void writeFile (const boost::filesystem::path& path, const std::string& data, bool compress,
+        std::atomic<std::size_t>& written)
+    {
+#ifdef _WIN32
+        std::FILE* file = _wfopen (path.c_str(), L"wb");
+#else
+        std::FILE* file = std::fopen (path.c_str(), "wb");
+#endif
+        if (!file)
+            throw std::runtime_error ("Failed to open \"" + path.string() + "\" for writing");
+
+        bool good = true;
+        const auto sink = [&] (const char* piece, std::size_t size)
+        {
+            good = good && std::fwrite (piece, 1, size, file) == size;
+        };
+
+        try
+        {
+            // The data is compressed piece by piece, there is never a compressed copy of the whole save in memory
+            std::unique_ptr<ESM::SavedGameCompressor> compressor;
+            if (compress)
+                compressor.reset (new ESM::SavedGameCompressor (sink));
+
+            const std::size_t chunkSize = 1 << 20;
+            for (std::size_t offset = 0; good && offset < data.size(); offset += chunkSize)
+            {
+                const std::size_t size = std::min (chunkSize, data.size() - offset);
+                if (compressor)
+                    compressor->write (data.data() + offset, size);
+                else
+                    sink (data.data() + offset, size);
+                written = offset + size;
+            }
+
+            if (compressor)
+                compressor->finish();
+        }
+        catch (...)
+        {
+            std::fclose (file);
+            throw;
+        }
+
+        // Make sure the new save is on the disk before it replaces the old one
+        good = good && std::fflush (file) == 0;
+#ifdef _WIN32
+        good = good && _commit (_fileno (file)) == 0;
+#else
+        good = good && fsync (fileno (file)) == 0;
+#endif
+        good = std::fclose (file) == 0 && good;
+
+        if (!good)
+            throw std::runtime_error ("Write operation failed (file stream)");
+    }
+}
+
+/// Writes an encoded saved game to its file. The file is replaced only once the new one is completely written.
+class MWState::StateManager::SaveWorkItem : public SceneUtil::WorkItem
+{
+    public:
+
+        SaveWorkItem (Character *character, const boost::filesystem::path& path, std::string&& data, bool compress)
+        : mCharacter (character), mPath (path), mData (std::move (data)), mSize (mData.size()), mCompress (compress)
+        , mWritten (0)
+        {}
+
+        virtual void doWork()
+        {
+            boost::filesystem::path tempPath = mPath;
+            tempPath += ".tmp";
+
+            try
+            {
+                writeFile (tempPath, mData, mCompress, mWritten);
+                boost::filesystem::rename (tempPath, mPath);
+            }
+            catch (const std::exception& e)
+            {
+                mError = e.what();
+                boost::system::error_code ec;
+                boost::filesystem::remove (tempPath, ec);
+            }
+
+            mData.clear();
+            mData.shrink_to_fit();
+        }
+
+        Character *getCharacter() const { return mCharacter; }
+
+        const boost::filesystem::path& getPath() const { return mPath; }
+
+        std::size_t getSize() const { return mSize; }
+
+        std::size_t getWritten() const { return mWritten; }
+
+        /// @note Valid once the work is done.
+        const std::string& getError() const { return mError; }
+
+    private:
+
+        Character *mCharacter;
+        const boost::filesystem::path mPath;
+        std::string mData;
+        const std::size_t mSize;
+        const bool mCompress;
+        std::atomic<std::size_t> mWritten;
+        std::string mError;
+};
+
 void MWState::StateManager::cleanup (bool force)
 {
     if (mState!=State_NoGame || force)
@@ -88,10 +218,22 @@ std::map<int, int> MWState::StateManager::buildContentFileIndexMap (const ESM::E
 
 MWState::StateManager::StateManager (const boost::filesystem::path& saves, const std::string& game)
 : mQuitRequest (false), mAskLoadRecent(false), mState (State_NoGame), mCharacterManager (saves, game), mTimePlayed (0)
+, mSaveQueue (new SceneUtil::WorkQueue (1))
 {
 
 }
 
+MWState::StateManager::~StateManager()
+{
+    // The work queue drops pending items when it is destroyed
+    if (mSaveWork)
+    {
+        mSaveWork->waitTillDone();
+        if (!mSaveWork->getError().empty())
+            Log(Debug::Error) << "Failed to save game: " << mSaveWork->getError();
+    }
+}
+
 void MWState::StateManager::requestQuit()
 {
     mQuitRequest = true;
@@ -181,6 +323,8 @@ void MWState::StateManager::resumeGame()
 
 void MWState::StateManager::saveGame (const std::string& description, const Slot *slot)
 {
+    finishSave();
+
     MWState::Character* character = getCurrentCharacter();
 
     try
@@ -232,7 +376,7 @@ void MWState::StateManager::saveGame (const std::string& description, const Slot
 
         // Write to a memory stream first. If there is an exception during the save process, we don't want to trash the
         // existing save file we are overwriting.
-        std::stringstream stream;
+        Files::OMemStream stream;
 
         ESM::ESMWriter writer;
 
@@ -292,32 +436,72 @@ void MWState::StateManager::saveGame (const std::string& description, const Slot
         if (stream.fail())
             throw std::runtime_error("Write operation failed (memory stream)");
 
-        // All good, write to file
-        boost::filesystem::ofstream filestream (slot->mPath, std::ios::binary);
-        filestream << stream.rdbuf();
+        // The encoded records are the snapshot of the game. The records are encoded here because they are written from
+        // the live game objects, only the compression and the writing to the disk are done in the background.
+        mSaveWork = new SaveWorkItem(character, slot->mPath, stream.release(), Settings::Manager::getBool("compress", "Saves"));
+        mSaveQueue->addWorkItem(mSaveWork);
+    }
+    catch (const std::exception& e)
+    {
+        reportSaveError(e.what(), character, slot ? slot->mPath : boost::filesystem::path());
+    }
+}
+
+void MWState::StateManager::finishSave()
+{
+    if (!mSaveWork)
+        return;
+
+    if (!mSaveWork->isDone())
+    {
+        Loading::Listener& listener = *MWBase::Environment::get().getWindowManager()->getLoadingScreen();
+        listener.setProgressRange(mSaveWork->getSize());
+        listener.setLabel("#{sNotifyMessage4}");
 
-        if (filestream.fail())
-            throw std::runtime_error("Write operation failed (file stream)");
+        Loading::ScopedLoad load(&listener);
 
-        Settings::Manager::setString ("character", "Saves",
-            slot->mPath.parent_path().filename().string());
+        while (!mSaveWork->isDone())
+        {
+            listener.setProgress(mSaveWork->getWritten());
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
     }
-    catch (const std::exception& e)
+
+    osg::ref_ptr<SaveWorkItem> work;
+    work.swap(mSaveWork);
+
+    if (!work->getError().empty())
     {
-        std::stringstream error;
-        error << "Failed to save game: " << e.what();
+        reportSaveError(work->getError(), work->getCharacter(), work->getPath());
+        return;
+    }
 
-        Log(Debug::Error) << error.str();
+    Settings::Manager::setString ("character", "Saves",
+        work->getPath().parent_path().filename().string());
+}
 
-        std::vector<std::string> buttons;
-        buttons.push_back("#{sOk}");
-        MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
+void MWState::StateManager::reportSaveError (const std::string& what, Character *character, const boost::filesystem::path& path)
+{
+    std::stringstream error;
+    error << "Failed to save game: " << what;
+
+    Log(Debug::Error) << error.str();
+
+    std::vector<std::string> buttons;
+    buttons.push_back("#{sOk}");
+    MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
 
-        // If no file was written, clean up the slot
-        if (character && slot && !boost::filesystem::exists(slot->mPath))
+    // If no file was written, clean up the slot
+    if (character && !path.empty() && !boost::filesystem::exists(path))
+    {
+        for (Character::SlotIterator it = character->begin(); it != character->end(); ++it)
         {
-            character->deleteSlot(slot);
-            character->cleanup();
+            if (it->mPath == path)
+            {
+                character->deleteSlot(&*it);
+                character->cleanup();
+                break;
+            }
         }
     }
 }
@@ -376,6 +560,8 @@ void MWState::StateManager::loadGame(const std::string& filepath)
 
 void MWState::StateManager::loadGame (const Character *character, const std::string& filepath)
 {
+    finishSave();
+
     try
     {
         cleanup();
@@ -575,6 +761,8 @@ void MWState::StateManager::quickLoad()
 
 void MWState::StateManager::deleteGame(const MWState::Character *character, const MWState::Slot *slot)
 {
+    finishSave();
+
     mCharacterManager.deleteSlot(character, slot);
 }
 
@@ -597,6 +785,9 @@ void MWState::StateManager::update (float duration)
 {
     mTimePlayed += duration;
 
+    if (mSaveWork && mSaveWork->isDone())
+        finishSave();
+
     // Note: It would be nicer to trigger this from InputManager, i.e. the very beginning of the frame update.
     if (mAskLoadRecent)
     {
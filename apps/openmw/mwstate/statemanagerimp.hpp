@@ -7,22 +7,38 @@
 
 #include <boost/filesystem/path.hpp>
 
+#include <osg/ref_ptr>
+
 #include "charactermanager.hpp"
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWState
 {
     class StateManager : public MWBase::StateManager
     {
+            class SaveWorkItem;
+
             bool mQuitRequest;
             bool mAskLoadRecent;
             State mState;
             CharacterManager mCharacterManager;
             double mTimePlayed;
+            osg::ref_ptr<SceneUtil::WorkQueue> mSaveQueue;
+            osg::ref_ptr<SaveWorkItem> mSaveWork;
 
         private:
 
             void cleanup (bool force = false);
 
+            void finishSave();
+            ///< Wait for the save game being written in the background, if any, and report its result.
+
+            void reportSaveError (const std::string& what, Character *character, const boost::filesystem::path& path);
+
             bool verifyProfile (const ESM::SavedGame& profile) const;
 
             void writeScreenshot (std::vector<char>& imageData) const;
@@ -33,6 +49,8 @@ namespace MWState
 
             StateManager (const boost::filesystem::path& saves, const std::string& game);
 
+            virtual ~StateManager();
+
             virtual void requestQuit();
 
             virtual bool hasQuitRequest() const;
@@ -57,6 +75,8 @@ namespace MWState
             ///< Write a saved game to \a slot or create a new slot if \a slot == 0.
             ///
             /// \note Slot must belong to the current character.
+            ///
+            /// \note The game state is encoded right away, the file is written in the background.
 
             ///Saves a file, using supplied filename, overwritting if needed
             /** This is mostly used for quicksaving and autosaving, for they use the same name over and over again
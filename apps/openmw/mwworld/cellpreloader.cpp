@@ -64,6 +64,9 @@ namespace MWWorld
         {
             mTerrainView = mTerrain->createView();
 
+            // let the worker thread read the references of the cell as well, for CellStore::load to take over
+            mRefBatch = cell->prepareRefBatch();
+
             ListModelsVisitor visitor (mMeshes);
             if (cell->getState() == MWWorld::CellStore::State_Loaded)
             {
@@ -89,9 +92,21 @@ namespace MWWorld
             mAbort = true;
         }
 
+        /// @note Must not be called once the item is queued.
+        const std::vector<std::string>& getMeshes() const
+        {
+            return mMeshes;
+        }
+
         /// Preload work to be called from the worker thread.
         virtual void doWork()
         {
+            if (mRefBatch && !mAbort)
+            {
+                MWWorld::CellStore::readRefBatch(*mRefBatch);
+                mRefBatch = nullptr;
+            }
+
             if (mIsExterior)
             {
                 try
@@ -163,6 +178,8 @@ namespace MWWorld
 
         std::atomic<bool> mAbort;
 
+        std::shared_ptr<MWWorld::CellRefBatch> mRefBatch;
+
         osg::ref_ptr<Terrain::View> mTerrainView;
 
         // keep a ref to the loaded objects to make sure it stays loaded as long as this cell is in the preloaded state
@@ -310,6 +327,11 @@ namespace MWWorld
         }
 
         osg::ref_ptr<PreloadItem> item (new PreloadItem(cell, mResourceSystem->getSceneManager(), mBulletShapeManager, mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
+
+        // Inflate the compressed meshes on all threads, so the item finds them in the archive caches. The mesh names
+        // are copied before the item is queued, it corrects them in place once it runs.
+        mResourceSystem->prefetchFiles(item->getMeshes());
+
         mWorkQueue->addWorkItem(item);
 
         mPreloadCells[cell] = PreloadEntry(timestamp, item);
@@ -1,6 +1,7 @@
 #include "cellstore.hpp"
 
 #include <algorithm>
+#include <unordered_set>
 
 #include <components/debug/debuglog.hpp>
 
@@ -30,6 +31,94 @@
 
 namespace
 {
+    struct RefNumHash
+    {
+        std::size_t operator()(const ESM::RefNum& refNum) const
+        {
+            return (static_cast<std::size_t>(refNum.mIndex) << 8) ^ static_cast<std::size_t>(refNum.mContentFile);
+        }
+    };
+
+    typedef std::unordered_set<ESM::RefNum, RefNumHash> RefNumSet;
+
+    /// Collect the references that were moved out of the cell, so that they can be skipped in O(1) while
+    /// iterating over the cell's references.
+    RefNumSet getMovedRefNums(const ESM::Cell& cell)
+    {
+        RefNumSet result;
+        result.reserve(cell.mMovedRefs.size());
+        for (const ESM::MovedCellRef& movedRef : cell.mMovedRefs)
+            result.insert(movedRef.mRefNum);
+        return result;
+    }
+
+    /// Call \a function (ESM::CellRef&, bool deleted) for each reference of \a cell in its content files, except for
+    /// those that were moved to a different cell.
+    template <class Function>
+    void forEachRef(const ESM::Cell& cell, std::vector<ESM::ESMReader>& esm, const char* action, Function&& function)
+    {
+        const RefNumSet movedRefs = getMovedRefNums(cell);
+
+        // Load references from all plugins that do something with this cell.
+        for (size_t i = 0; i < cell.mContextList.size(); i++)
+        {
+            try
+            {
+                // Reopen the ESM reader and seek to the right position.
+                int index = cell.mContextList.at(i).index;
+                cell.restore (esm[index], i);
+
+                ESM::CellRef ref;
+                ref.mRefNum.mContentFile = ESM::RefNum::RefNum_NoContentFile;
+
+                // Get each reference in turn
+                bool deleted = false;
+                while (ESM::Cell::getNextRef (esm[index], ref, deleted))
+                {
+                    // Don't use reference if it was moved to a different cell.
+                    if (movedRefs.count(ref.mRefNum))
+                        continue;
+
+                    function(ref, deleted);
+                }
+            }
+            catch (std::exception& e)
+            {
+                Log(Debug::Error) << "An error occurred " << action << " references for cell " << cell.getDescription() << ": " << e.what();
+            }
+        }
+    }
+
+    /// Readers of the content files for the calling thread, each with a stream of its own. They are opened on first
+    /// use for the files \a cell has references in.
+    std::vector<ESM::ESMReader>& getThreadReaders(const ESM::Cell& cell, const std::vector<ESM::ESMReader>& readers)
+    {
+        // Strings in content files are converted with the encoder of the readers, which keeps a buffer of its own
+        static thread_local std::unique_ptr<ToUTF8::Utf8Encoder> encoder;
+        static thread_local std::vector<ESM::ESMReader> threadReaders;
+
+        if (threadReaders.size() != readers.size())
+        {
+            threadReaders.clear();
+            threadReaders.resize(readers.size());
+            encoder.reset();
+            if (!readers.empty() && readers.front().getEncoder())
+                encoder.reset(new ToUTF8::Utf8Encoder(*readers.front().getEncoder()));
+        }
+
+        for (const ESM::ESM_Context& context : cell.mContextList)
+        {
+            ESM::ESMReader& reader = threadReaders.at(context.index);
+            if (reader.getName() != context.filename)
+            {
+                reader.openCopy(readers.at(context.index), context.filename);
+                reader.setEncoder(encoder.get());
+            }
+        }
+
+        return threadReaders;
+    }
+
     template<typename T>
     MWWorld::Ptr searchInContainerList (MWWorld::CellRefList<T>& containerList, const std::string& id)
     {
@@ -476,48 +565,46 @@ namespace MWWorld
         }
     }
 
-    void CellStore::listRefs()
+    CellRefBatch::CellRefBatch(const ESM::Cell* cell, const std::vector<ESM::ESMReader>* readers)
+        : mCell(cell)
+        , mReaders(readers)
+        , mReady(false)
     {
-        std::vector<ESM::ESMReader>& esm = mReader;
+    }
 
-        assert (mCell);
+    std::shared_ptr<CellRefBatch> CellStore::prepareRefBatch()
+    {
+        if (mState == State_Loaded || mCell->mContextList.empty())
+            return nullptr;
 
-        if (mCell->mContextList.empty())
-            return; // this is a dynamically generated cell -> skipping.
+        mRefBatch = std::make_shared<CellRefBatch>(mCell, &mReader);
+        return mRefBatch;
+    }
 
-        // Load references from all plugins that do something with this cell.
-        for (size_t i = 0; i < mCell->mContextList.size(); i++)
+    void CellStore::readRefBatch(CellRefBatch& batch)
+    {
+        std::vector<ESM::ESMReader>& esm = getThreadReaders(*batch.mCell, *batch.mReaders);
+
+        forEachRef(*batch.mCell, esm, "reading", [&] (const ESM::CellRef& ref, bool deleted)
         {
-            try
-            {
-                // Reopen the ESM reader and seek to the right position.
-                int index = mCell->mContextList.at(i).index;
-                mCell->restore (esm[index], i);
+            batch.mRefs.emplace_back(ref, deleted);
+        });
 
-                ESM::CellRef ref;
+        batch.mReady = true;
+    }
 
-                // Get each reference in turn
-                bool deleted = false;
-                while (mCell->getNextRef (esm[index], ref, deleted))
-                {
-                    if (deleted)
-                        continue;
+    void CellStore::listRefs()
+    {
+        assert (mCell);
 
-                    // Don't list reference if it was moved to a different cell.
-                    ESM::MovedCellRefTracker::const_iterator iter =
-                        std::find(mCell->mMovedRefs.begin(), mCell->mMovedRefs.end(), ref.mRefNum);
-                    if (iter != mCell->mMovedRefs.end()) {
-                        continue;
-                    }
+        if (mCell->mContextList.empty())
+            return; // this is a dynamically generated cell -> skipping.
 
-                    mIds.push_back (Misc::StringUtils::lowerCase (ref.mRefID));
-                }
-            }
-            catch (std::exception& e)
-            {
-                Log(Debug::Error) << "An error occurred listing references for cell " << getCell()->getDescription() << ": " << e.what();
-            }
-        }
+        forEachRef(*mCell, mReader, "listing", [this] (const ESM::CellRef& ref, bool deleted)
+        {
+            if (!deleted)
+                mIds.push_back (Misc::StringUtils::lowerCase (ref.mRefID));
+        });
 
         // List moved references, from separately tracked list.
         for (ESM::CellRefTracker::const_iterator it = mCell->mLeasedRefs.begin(); it != mCell->mLeasedRefs.end(); ++it)
@@ -534,45 +621,27 @@ namespace MWWorld
 
     void CellStore::loadRefs()
     {
-        std::vector<ESM::ESMReader>& esm = mReader;
-
         assert (mCell);
 
+        // The batch may still be read by a worker thread if it is not ready, then it is just dropped
+        const std::shared_ptr<CellRefBatch> batch = std::move(mRefBatch);
+
         if (mCell->mContextList.empty())
             return; // this is a dynamically generated cell -> skipping.
 
         std::map<ESM::RefNum, std::string> refNumToID; // used to detect refID modifications
 
-        // Load references from all plugins that do something with this cell.
-        for (size_t i = 0; i < mCell->mContextList.size(); i++)
+        if (batch && batch->mReady)
         {
-            try
-            {
-                // Reopen the ESM reader and seek to the right position.
-                int index = mCell->mContextList.at(i).index;
-                mCell->restore (esm[index], i);
-
-                ESM::CellRef ref;
-                ref.mRefNum.mContentFile = ESM::RefNum::RefNum_NoContentFile;
-
-                // Get each reference in turn
-                bool deleted = false;
-                while(mCell->getNextRef(esm[index], ref, deleted))
-                {
-                    // Don't load reference if it was moved to a different cell.
-                    ESM::MovedCellRefTracker::const_iterator iter =
-                        std::find(mCell->mMovedRefs.begin(), mCell->mMovedRefs.end(), ref.mRefNum);
-                    if (iter != mCell->mMovedRefs.end()) {
-                        continue;
-                    }
-
-                    loadRef (ref, deleted, refNumToID);
-                }
-            }
-            catch (std::exception& e)
+            for (std::pair<ESM::CellRef, bool>& ref : batch->mRefs)
+                loadRef (ref.first, ref.second, refNumToID);
+        }
+        else
+        {
+            forEachRef(*mCell, mReader, "loading", [&] (ESM::CellRef& ref, bool deleted)
             {
-                Log(Debug::Error) << "An error occurred loading references for cell " << getCell()->getDescription() << ": " << e.what();
-            }
+                loadRef (ref, deleted, refNumToID);
+            });
         }
 
         // Load moved references, from separately tracked list.
@@ -2,6 +2,7 @@
 #define GAME_MWWORLD_CELLSTORE_H
 
 #include <algorithm>
+#include <atomic>
 #include <stdexcept>
 #include <string>
 #include <typeinfo>
@@ -47,6 +48,25 @@ namespace MWWorld
 {
     class ESMStore;
 
+    /// @brief References of a cell, read from the content files ahead of CellStore::load.
+    /// @par Set up by CellStore::prepareRefBatch on the main thread and filled by CellStore::readRefBatch, which may
+    /// run on any thread.
+    struct CellRefBatch
+    {
+        CellRefBatch(const ESM::Cell* cell, const std::vector<ESM::ESMReader>* readers);
+
+        const ESM::Cell* mCell;
+
+        /// The readers of the main thread, only used to take over the headers of the content files.
+        const std::vector<ESM::ESMReader>* mReaders;
+
+        /// The references in the order they are inserted, and whether they are deleted.
+        std::vector<std::pair<ESM::CellRef, bool> > mRefs;
+
+        /// Set once mRefs is complete.
+        std::atomic<bool> mReady;
+    };
+
     /// \brief Mutable state of a cell
     class CellStore
     {
@@ -71,6 +91,7 @@ namespace MWWorld
             State mState;
             bool mHasState;
             std::vector<std::string> mIds;
+            std::shared_ptr<CellRefBatch> mRefBatch;
             float mWaterLevel;
 
             MWWorld::TimeStamp mLastRespawn;
@@ -262,6 +283,15 @@ namespace MWWorld
             void preload ();
             ///< Build ID list from content file.
 
+            std::shared_ptr<CellRefBatch> prepareRefBatch();
+            ///< Set up a batch for reading the references of this cell ahead of load(), see readRefBatch().
+            /// load() takes the references over if the batch is ready by then, and reads them itself otherwise.
+            /// @return nullptr if the cell is loaded already or has no references in content files.
+
+            static void readRefBatch(CellRefBatch& batch);
+            ///< Read the references of \a batch with ESMReaders of the calling thread.
+            /// @note May be called from any thread.
+
             /// Call visitor (MWWorld::Ptr) for each reference. visitor must return a bool. Returning
             /// false will abort the iteration.
             /// \note Prefer using forEachConst when possible.
@@ -1,18 +1,40 @@
 #include "esmloader.hpp"
 #include "esmstore.hpp"
 
+#include <algorithm>
+
 #include <components/esm/esmreader.hpp>
+#include <components/to_utf8/to_utf8.hpp>
 
 namespace MWWorld
 {
 
 EsmLoader::EsmLoader(MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& readers,
-  ToUTF8::Utf8Encoder* encoder, Loading::Listener& listener)
+  ToUTF8::Utf8Encoder* encoder, Loading::Listener& listener, unsigned threads)
   : ContentLoader(listener)
   , mEsm(readers)
   , mStore(store)
   , mEncoder(encoder)
+  , mShouldStop(false)
 {
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+
+  for (unsigned i = 0; i < threads; ++i)
+    mThreads.emplace_back([this] { run(); });
+}
+
+EsmLoader::~EsmLoader()
+{
+  {
+    const std::lock_guard<std::mutex> lock(mMutex);
+    mShouldStop = true;
+    mJobs.clear();
+  }
+  mHasJob.notify_all();
+
+  for (auto& thread : mThreads)
+    thread.join();
 }
 
 void EsmLoader::load(const boost::filesystem::path& filepath, int& index)
@@ -25,7 +47,63 @@ void EsmLoader::load(const boost::filesystem::path& filepath, int& index)
   lEsm.setGlobalReaderList(&mEsm);
   lEsm.open(filepath.string());
   mEsm[index] = lEsm;
-  mStore.load(mEsm[index], &mListener);
+
+  // The encoder keeps an internal buffer, each worker needs its own copy.
+  std::unique_ptr<Job> job(new Job);
+  job->mPath = filepath.string();
+  job->mIndex = index;
+  if (mEncoder)
+    job->mEncoder.reset(new ToUTF8::Utf8Encoder(*mEncoder));
+  mLoading.emplace_back(index, job->mResult.get_future());
+
+  {
+    const std::lock_guard<std::mutex> lock(mMutex);
+    mJobs.push_back(std::move(job));
+  }
+  mHasJob.notify_one();
+}
+
+void EsmLoader::finishLoading()
+{
+  for (auto& loading : mLoading)
+  {
+    ESM::ESMReader& esm = mEsm[loading.first];
+    mListener.setLabel(MyGUI::TextIterator::toTagsString(esm.getName()));
+
+    ESMStore::ParsedRecords records = loading.second.get();
+    mStore.load(esm, records, &mListener);
+  }
+
+  mLoading.clear();
+}
+
+void EsmLoader::run()
+{
+  while (true)
+  {
+    std::unique_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mHasJob.wait(lock, [this] { return mShouldStop || !mJobs.empty(); });
+      if (mShouldStop)
+        return;
+      job = std::move(mJobs.front());
+      mJobs.pop_front();
+    }
+
+    try
+    {
+      ESM::ESMReader esm;
+      esm.setEncoder(job->mEncoder.get());
+      esm.setIndex(job->mIndex);
+      esm.open(job->mPath);
+      job->mResult.set_value(mStore.parse(esm));
+    }
+    catch (...)
+    {
+      job->mResult.set_exception(std::current_exception());
+    }
+  }
 }
 
 } /* namespace MWWorld */
@@ -1,9 +1,16 @@
 #ifndef ESMLOADER_HPP
 #define ESMLOADER_HPP
 
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "contentloader.hpp"
+#include "esmstore.hpp"
 
 namespace ToUTF8
 {
@@ -18,19 +25,44 @@ namespace ESM
 namespace MWWorld
 {
 
-class ESMStore;
-
+/// Loads content files in two phases: the records of all files are read concurrently on worker threads,
+/// then merged into the store in load order by finishLoading(), so that overrides work like with sequential loading.
 struct EsmLoader : public ContentLoader
 {
+    /// @param threads number of worker threads reading content files, 0 to use one per CPU core
     EsmLoader(MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& readers,
-      ToUTF8::Utf8Encoder* encoder, Loading::Listener& listener);
+      ToUTF8::Utf8Encoder* encoder, Loading::Listener& listener, unsigned threads = 0);
+
+    ~EsmLoader();
 
     void load(const boost::filesystem::path& filepath, int& index);
 
+    /// Merge the records of all content files passed to load() into the store.
+    /// Must be called after the last load().
+    void finishLoading();
+
     private:
+      struct Job
+      {
+          std::string mPath;
+          int mIndex;
+          std::unique_ptr<ToUTF8::Utf8Encoder> mEncoder;
+          std::promise<ESMStore::ParsedRecords> mResult;
+      };
+
+      void run();
+
       std::vector<ESM::ESMReader>& mEsm;
       MWWorld::ESMStore& mStore;
       ToUTF8::Utf8Encoder* mEncoder;
+
+      std::vector<std::pair<int, std::future<ESMStore::ParsedRecords>>> mLoading;
+
+      std::mutex mMutex;
+      std::condition_variable mHasJob;
+      std::deque<std::unique_ptr<Job>> mJobs;
+      bool mShouldStop;
+      std::vector<std::thread> mThreads;
 };
 
 } /* namespace MWWorld */
@@ -26,12 +26,10 @@ static bool isCacheableRecord(int id)
     return false;
 }
 
-void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
+void ESMStore::startLoad(ESM::ESMReader &esm, Loading::Listener* listener)
 {
     listener->setProgressRange(1000);
 
-    ESM::Dialogue *dialogue = 0;
-
     // Land texture loading needs to use a separate internal store for each plugin.
     // We set the number of plugins here to avoid continual resizes during loading,
     // and so we can properly verify if valid plugin indices are being passed to the
@@ -65,6 +63,60 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
         }
         mast.index = index;
     }
+}
+
+void ESMStore::loadRecord(ESM::ESMReader &esm, ESM::NAME n, ESM::Dialogue*& dialogue)
+{
+    // Look up the record type.
+    std::map<int, StoreBase *>::iterator it = mStores.find(n.intval);
+
+    if (it == mStores.end()) {
+        if (n.intval == ESM::REC_INFO) {
+            if (dialogue)
+            {
+                dialogue->readInfo(esm, esm.getIndex() != 0);
+            }
+            else
+            {
+                Log(Debug::Error) << "Error: info record without dialog";
+                esm.skipRecord();
+            }
+        } else if (n.intval == ESM::REC_MGEF) {
+            mMagicEffects.load (esm);
+        } else if (n.intval == ESM::REC_SKIL) {
+            mSkills.load (esm);
+        }
+        else if (n.intval==ESM::REC_FILT || n.intval == ESM::REC_DBGP)
+        {
+            // ignore project file only records
+            esm.skipRecord();
+        }
+        else {
+            std::stringstream error;
+            error << "Unknown record: " << n.toString();
+            throw std::runtime_error(error.str());
+        }
+    } else {
+        RecordId id = it->second->load(esm);
+        if (id.mIsDeleted)
+        {
+            it->second->eraseStatic(id.mId);
+            return;
+        }
+
+        if (n.intval==ESM::REC_DIAL) {
+            dialogue = const_cast<ESM::Dialogue*>(mDialogs.find(id.mId));
+        } else {
+            dialogue = 0;
+        }
+    }
+}
+
+void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
+{
+    startLoad(esm, listener);
+
+    ESM::Dialogue *dialogue = 0;
 
     // Loop through all records
     while(esm.hasMoreRecs())
@@ -72,50 +124,70 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
         ESM::NAME n = esm.getRecName();
         esm.getRecHeader();
 
-        // Look up the record type.
-        std::map<int, StoreBase *>::iterator it = mStores.find(n.intval);
+        loadRecord(esm, n, dialogue);
+
+        listener->setProgress(static_cast<size_t>(esm.getFileOffset() / (float)esm.getFileSize() * 1000));
+    }
+}
+
+ESMStore::ParsedRecords ESMStore::parse(ESM::ESMReader &esm) const
+{
+    ParsedRecords result;
+
+    while(esm.hasMoreRecs())
+    {
+        ParsedRecords::Record record;
+        record.mContext = esm.getContext();
+
+        ESM::NAME n = esm.getRecName();
+        esm.getRecHeader();
+        record.mType = n.intval;
+
+        std::map<int, StoreBase *>::const_iterator it = mStores.find(n.intval);
+        if (it != mStores.end())
+            record.mParsed = it->second->parse(esm);
+
+        if (!record.mParsed)
+            esm.skipRecord();
+
+        result.mRecords.push_back(std::move(record));
+    }
+
+    return result;
+}
+
+void ESMStore::load(ESM::ESMReader &esm, ParsedRecords &records, Loading::Listener* listener)
+{
+    startLoad(esm, listener);
+
+    ESM::Dialogue *dialogue = 0;
+
+    for (size_t i = 0; i < records.mRecords.size(); ++i)
+    {
+        ParsedRecords::Record& record = records.mRecords[i];
+
+        if (record.mParsed)
+        {
+            StoreBase* store = mStores.find(record.mType)->second;
+            RecordId id = store->insertParsed(*record.mParsed);
+            record.mParsed.reset();
 
-        if (it == mStores.end()) {
-            if (n.intval == ESM::REC_INFO) {
-                if (dialogue)
-                {
-                    dialogue->readInfo(esm, esm.getIndex() != 0);
-                }
-                else
-                {
-                    Log(Debug::Error) << "Error: info record without dialog";
-                    esm.skipRecord();
-                }
-            } else if (n.intval == ESM::REC_MGEF) {
-                mMagicEffects.load (esm);
-            } else if (n.intval == ESM::REC_SKIL) {
-                mSkills.load (esm);
-            }
-            else if (n.intval==ESM::REC_FILT || n.intval == ESM::REC_DBGP)
-            {
-                // ignore project file only records
-                esm.skipRecord();
-            }
-            else {
-                std::stringstream error;
-                error << "Unknown record: " << n.toString();
-                throw std::runtime_error(error.str());
-            }
-        } else {
-            RecordId id = it->second->load(esm);
             if (id.mIsDeleted)
-            {
-                it->second->eraseStatic(id.mId);
-                continue;
-            }
+                store->eraseStatic(id.mId);
+            else
+                dialogue = 0; // dialogues are never parsed in advance
+        }
+        else
+        {
+            esm.restoreContext(record.mContext);
 
-            if (n.intval==ESM::REC_DIAL) {
-                dialogue = const_cast<ESM::Dialogue*>(mDialogs.find(id.mId));
-            } else {
-                dialogue = 0;
-            }
+            ESM::NAME n = esm.getRecName();
+            esm.getRecHeader();
+
+            loadRecord(esm, n, dialogue);
         }
-        listener->setProgress(static_cast<size_t>(esm.getFileOffset() / (float)esm.getFileSize() * 1000));
+
+        listener->setProgress(static_cast<size_t>((i + 1) / (float)records.mRecords.size() * 1000));
     }
 }
 
@@ -4,6 +4,7 @@
 #include <sstream>
 #include <stdexcept>
 
+#include <components/esm/esmcommon.hpp>
 #include <components/esm/records.hpp>
 #include "store.hpp"
 
@@ -77,6 +78,12 @@ namespace MWWorld
         /// Validate entries in store after setup
         void validate();
 
+        /// Prepare loading of the content file opened in \a esm
+        void startLoad(ESM::ESMReader &esm, Loading::Listener* listener);
+
+        /// Load the record whose header has just been read from \a esm
+        void loadRecord(ESM::ESMReader &esm, ESM::NAME name, ESM::Dialogue*& dialogue);
+
     public:
         /// \todo replace with SharedIterator<StoreBase>
         typedef std::map<int, StoreBase *>::const_iterator iterator;
@@ -163,6 +170,32 @@ namespace MWWorld
 
         void load(ESM::ESMReader &esm, Loading::Listener* listener);
 
+        /// Records of a content file read by parse(), to be merged into the store by load().
+        struct ParsedRecords
+        {
+            struct Record
+            {
+                int mType;
+
+                /// Read by parse(), or nullptr if the record depends on previously loaded records.
+                /// Such records are read again by load(), starting from mContext.
+                std::unique_ptr<StoreBase::ParsedRecord> mParsed;
+
+                /// Reader state at the beginning of the record
+                ESM::ESM_Context mContext;
+            };
+
+            std::vector<Record> mRecords;
+        };
+
+        /// Read the records of a content file that don't depend on other content files, without modifying the store.
+        /// @note Thread safe, may be called for several content files concurrently and while load() merges another one.
+        ParsedRecords parse(ESM::ESMReader &esm) const;
+
+        /// Merge records read by parse() from the content file opened in \a esm.
+        /// The result is identical to load(esm, listener).
+        void load(ESM::ESMReader &esm, ParsedRecords &records, Loading::Listener* listener);
+
         template <class T>
         const Store<T> &get() const {
             throw std::runtime_error("Storage for this type not exist");
@@ -64,7 +64,8 @@ namespace
 
 }
 
-MWWorld::LocalScripts::LocalScripts (const MWWorld::ESMStore& store) : mStore (store)
+MWWorld::LocalScripts::LocalScripts (const MWWorld::ESMStore& store)
+: mNumRemaining (0), mNumDeferred (0), mStore (store)
 {
     mIter = mScripts.end();
 }
@@ -72,19 +73,75 @@ MWWorld::LocalScripts::LocalScripts (const MWWorld::ESMStore& store) : mStore (s
 void MWWorld::LocalScripts::startIteration()
 {
     mIter = mScripts.begin();
+    mNumDeferred = 0;
 }
 
 bool MWWorld::LocalScripts::getNext(std::pair<std::string, Ptr>& script)
 {
     while (mIter!=mScripts.end())
     {
-        std::list<std::pair<std::string, Ptr> >::iterator iter = mIter++;
-        script = *iter;
+        std::list<Script>::iterator iter = mIter++;
+        script = std::make_pair (iter->mName, iter->mPtr);
         return true;
     }
     return false;
 }
 
+bool MWWorld::LocalScripts::getNextNear(std::pair<std::string, Ptr>& script, float& secondsPassed,
+    const osg::Vec3f& position, float maxDistance, float duration)
+{
+    while (mIter!=mScripts.end())
+    {
+        std::list<Script>::iterator iter = mIter++;
+
+        if (iter->mPtr.isInCell() &&
+            (iter->mPtr.getRefData().getPosition().asVec3() - position).length2() > maxDistance * maxDistance)
+        {
+            iter->mDeferredTime += duration;
+            ++mNumDeferred;
+            continue;
+        }
+
+        script = std::make_pair (iter->mName, iter->mPtr);
+        secondsPassed = iter->mDeferredTime + duration;
+        iter->mDeferredTime = 0;
+        return true;
+    }
+    return false;
+}
+
+void MWWorld::LocalScripts::startDeferredIteration()
+{
+    mIter = mScripts.begin();
+    mNumRemaining = mScripts.size();
+}
+
+bool MWWorld::LocalScripts::getNextDeferred(std::pair<std::string, Ptr>& script, float& secondsPassed)
+{
+    // scripts moved to the end are not visited again, they aren't deferred anymore
+    while (mIter!=mScripts.end() && mNumRemaining > 0)
+    {
+        std::list<Script>::iterator iter = mIter++;
+        --mNumRemaining;
+
+        if (iter->mDeferredTime == 0)
+            continue;
+
+        script = std::make_pair (iter->mName, iter->mPtr);
+        secondsPassed = iter->mDeferredTime;
+        iter->mDeferredTime = 0;
+        --mNumDeferred;
+        mScripts.splice (mScripts.end(), mScripts, iter);
+        return true;
+    }
+    return false;
+}
+
+std::size_t MWWorld::LocalScripts::getNumDeferred() const
+{
+    return mNumDeferred;
+}
+
 void MWWorld::LocalScripts::add (const std::string& scriptName, const Ptr& ptr)
 {
     if (const ESM::Script *script = mStore.get<ESM::Script>().search (scriptName))
@@ -93,15 +150,15 @@ void MWWorld::LocalScripts::add (const std::string& scriptName, const Ptr& ptr)
         {
             ptr.getRefData().setLocals (*script);
 
-            for (std::list<std::pair<std::string, Ptr> >::iterator iter = mScripts.begin(); iter!=mScripts.end(); ++iter)
-                if (iter->second==ptr)
+            for (std::list<Script>::iterator iter = mScripts.begin(); iter!=mScripts.end(); ++iter)
+                if (iter->mPtr==ptr)
                 {
                     Log(Debug::Warning) << "Error: tried to add local script twice for " << ptr.getCellRef().getRefId();
                     remove(ptr);
                     break;
                 }
 
-            mScripts.push_back (std::make_pair (scriptName, ptr));
+            mScripts.push_back (Script {scriptName, ptr, 0});
         }
         catch (const std::exception& exception)
         {
@@ -134,11 +191,11 @@ void MWWorld::LocalScripts::clear()
 
 void MWWorld::LocalScripts::clearCell (CellStore *cell)
 {
-    std::list<std::pair<std::string, Ptr> >::iterator iter = mScripts.begin();
+    std::list<Script>::iterator iter = mScripts.begin();
 
     while (iter!=mScripts.end())
     {
-        if (iter->second.mCell==cell)
+        if (iter->mPtr.mCell==cell)
         {
             if (iter==mIter)
                ++mIter;
@@ -152,9 +209,9 @@ void MWWorld::LocalScripts::clearCell (CellStore *cell)
 
 void MWWorld::LocalScripts::remove (RefData *ref)
 {
-    for (std::list<std::pair<std::string, Ptr> >::iterator iter = mScripts.begin();
+    for (std::list<Script>::iterator iter = mScripts.begin();
         iter!=mScripts.end(); ++iter)
-        if (&(iter->second.getRefData()) == ref)
+        if (&(iter->mPtr.getRefData()) == ref)
         {
             if (iter==mIter)
                 ++mIter;
@@ -166,9 +223,9 @@ void MWWorld::LocalScripts::remove (RefData *ref)
 
 void MWWorld::LocalScripts::remove (const Ptr& ptr)
 {
-    for (std::list<std::pair<std::string, Ptr> >::iterator iter = mScripts.begin();
+    for (std::list<Script>::iterator iter = mScripts.begin();
         iter!=mScripts.end(); ++iter)
-        if (iter->second==ptr)
+        if (iter->mPtr==ptr)
         {
             if (iter==mIter)
                 ++mIter;
@@ -4,6 +4,8 @@
 #include <list>
 #include <string>
 
+#include <osg/Vec3f>
+
 #include "ptr.hpp"
 
 namespace MWWorld
@@ -15,8 +17,17 @@ namespace MWWorld
     /// \brief List of active local scripts
     class LocalScripts
     {
-            std::list<std::pair<std::string, Ptr> > mScripts;
-            std::list<std::pair<std::string, Ptr> >::iterator mIter;
+            struct Script
+            {
+                std::string mName;
+                Ptr mPtr;
+                float mDeferredTime; ///< time since the script was deferred, 0 if it was not
+            };
+
+            std::list<Script> mScripts;
+            std::list<Script>::iterator mIter;
+            std::size_t mNumRemaining;
+            std::size_t mNumDeferred;
             const MWWorld::ESMStore& mStore;
 
         public:
@@ -30,6 +41,25 @@ namespace MWWorld
             ///< Get next local script
             /// @return Did we get a script?
 
+            bool getNextNear(std::pair<std::string, Ptr>& script, float& secondsPassed,
+                const osg::Vec3f& position, float maxDistance, float duration);
+            ///< Get next local script of a reference within \a maxDistance of \a position or in a container.
+            /// Scripts of other references are deferred, \a duration is added to the time since they were run.
+            /// @param secondsPassed time since the returned script was run
+            /// @return Did we get a script?
+
+            void startDeferredIteration();
+            ///< Set the iterator to the begin of the script list, to run deferred scripts.
+
+            bool getNextDeferred(std::pair<std::string, Ptr>& script, float& secondsPassed);
+            ///< Get next deferred local script. The returned script is moved to the end of the list, so the
+            /// scripts which aren't run in this frame come first in the next one.
+            /// @param secondsPassed time since the returned script was run
+            /// @return Did we get a script?
+
+            std::size_t getNumDeferred() const;
+            ///< Number of scripts deferred and not run since the last startIteration().
+
             void add (const std::string& scriptName, const Ptr& ptr);
             ///< Add script to collection of active local scripts.
 
@@ -0,0 +1,172 @@
+#ifndef OPENMW_MWWORLD_RECORDINDEX_H
+#define OPENMW_MWWORLD_RECORDINDEX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <components/misc/hash.hpp>
+#include <components/misc/stringops.hpp>
+
+namespace MWWorld
+{
+    /// Case insensitive hash of a record ID (64-bit FNV-1a of the lower case characters).
+    inline std::uint64_t hashRecordId(const char *id, std::size_t size)
+    {
+        Misc::Hash hash;
+        for (std::size_t i = 0; i < size; ++i)
+            hash.add(Misc::StringUtils::toLower(id[i]));
+        return hash.getValue();
+    }
+
+    /// \brief Open addressing hash table mapping record IDs to records owned by a Store
+    ///
+    /// IDs are compared case insensitively, so lookups do not have to lower case (and copy) the ID first.
+    /// The table does not own the records; the pointers must stay valid while they are in the table.
+    template <class T>
+    class RecordIndex
+    {
+        struct Entry
+        {
+            std::uint64_t mHash;
+            T *mRecord;
+        };
+
+        std::vector<Entry> mEntries;
+        std::size_t mSize;
+
+        std::size_t mask() const
+        {
+            return mEntries.size() - 1;
+        }
+
+        static bool matches(const Entry &entry, std::uint64_t hash, const char *id, std::size_t size)
+        {
+            if (entry.mRecord == nullptr || entry.mHash != hash || entry.mRecord->mId.size() != size)
+                return false;
+            return ciEqual(entry.mRecord->mId.data(), id, size);
+        }
+
+        static bool ciEqual(const char *x, const char *y, std::size_t size)
+        {
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                if (Misc::StringUtils::toLower(x[i]) != Misc::StringUtils::toLower(y[i]))
+                    return false;
+            }
+            return true;
+        }
+
+        void rehash(std::size_t capacity)
+        {
+            std::vector<Entry> entries(capacity, Entry {0, nullptr});
+            entries.swap(mEntries);
+
+            for (const Entry &entry : entries)
+            {
+                if (entry.mRecord == nullptr)
+                    continue;
+                std::size_t slot = entry.mHash & mask();
+                while (mEntries[slot].mRecord != nullptr)
+                    slot = (slot + 1) & mask();
+                mEntries[slot] = entry;
+            }
+        }
+
+    public:
+        RecordIndex()
+          : mSize(0)
+        {
+        }
+
+        // The records are owned by the store the index was built for, a copy would point into that store
+        RecordIndex(const RecordIndex &) = delete;
+        RecordIndex &operator=(const RecordIndex &) = delete;
+
+        void clear()
+        {
+            mEntries.clear();
+            mSize = 0;
+        }
+
+        std::size_t size() const
+        {
+            return mSize;
+        }
+
+        /// Add \a record to the table, replacing a record with the same ID.
+        void insert(T *record)
+        {
+            // keep the load factor at or below 1/2 so that probe sequences stay short
+            if ((mSize + 1) * 2 > mEntries.size())
+                rehash(mEntries.empty() ? 16 : mEntries.size() * 2);
+
+            const std::uint64_t hash = hashRecordId(record->mId.data(), record->mId.size());
+            std::size_t slot = hash & mask();
+            for (; mEntries[slot].mRecord != nullptr; slot = (slot + 1) & mask())
+            {
+                if (matches(mEntries[slot], hash, record->mId.data(), record->mId.size()))
+                {
+                    mEntries[slot].mRecord = record;
+                    return;
+                }
+            }
+
+            mEntries[slot] = Entry {hash, record};
+            ++mSize;
+        }
+
+        T *find(const char *id, std::size_t size) const
+        {
+            if (mEntries.empty())
+                return nullptr;
+
+            const std::uint64_t hash = hashRecordId(id, size);
+            for (std::size_t slot = hash & mask(); mEntries[slot].mRecord != nullptr; slot = (slot + 1) & mask())
+            {
+                if (matches(mEntries[slot], hash, id, size))
+                    return mEntries[slot].mRecord;
+            }
+            return nullptr;
+        }
+
+        /// @return was a record with this ID removed?
+        bool erase(const char *id, std::size_t size)
+        {
+            if (mEntries.empty())
+                return false;
+
+            const std::uint64_t hash = hashRecordId(id, size);
+            std::size_t slot = hash & mask();
+            while (!matches(mEntries[slot], hash, id, size))
+            {
+                if (mEntries[slot].mRecord == nullptr)
+                    return false;
+                slot = (slot + 1) & mask();
+            }
+
+            // Shift the following entries of the probe sequence back, so that lookups don't need tombstones
+            std::size_t next = slot;
+            while (true)
+            {
+                next = (next + 1) & mask();
+                if (mEntries[next].mRecord == nullptr)
+                    break;
+
+                const std::size_t home = mEntries[next].mHash & mask();
+                const bool movable = slot <= next ? (home <= slot || home > next) : (home <= slot && home > next);
+                if (movable)
+                {
+                    mEntries[slot] = mEntries[next];
+                    slot = next;
+                }
+            }
+
+            mEntries[slot] = Entry {0, nullptr};
+            --mSize;
+            return true;
+        }
+    };
+}
+
+#endif
@@ -13,6 +13,7 @@
 #include <components/resource/scenemanager.hpp>
 #include <components/resource/bulletshape.hpp>
 #include <components/sceneutil/unrefqueue.hpp>
+#include <components/vfs/manager.hpp>
 #include <components/detournavigator/navigator.hpp>
 #include <components/detournavigator/debug.hpp>
 #include <components/misc/convert.hpp>
@@ -761,6 +762,8 @@ namespace MWWorld
         mPhysics->setUnrefQueue(rendering.getUnrefQueue());
 
         rendering.getResourceSystem()->setExpiryDelay(Settings::Manager::getFloat("cache expiry delay", "Cells"));
+        rendering.getResourceSystem()->setMemoryBudget(
+            static_cast<std::size_t>(std::max(0, Settings::Manager::getInt("cache memory budget", "Cells"))) * 1024 * 1024);
 
         mPreloader->setExpiryDelay(Settings::Manager::getFloat("preload cell expiry delay", "Cells"));
         mPreloader->setMinCacheSize(Settings::Manager::getInt("preload cell cache min", "Cells"));
@@ -941,29 +944,6 @@ namespace MWWorld
         return Ptr();
     }
 
-    class PreloadMeshItem : public SceneUtil::WorkItem
-    {
-    public:
-        PreloadMeshItem(const std::string& mesh, Resource::SceneManager* sceneManager)
-            : mMesh(mesh), mSceneManager(sceneManager)
-        {
-        }
-
-        virtual void doWork()
-        {
-            try
-            {
-                mSceneManager->getTemplate(mMesh);
-            }
-            catch (std::exception& e)
-            {
-            }
-        }
-    private:
-        std::string mMesh;
-        Resource::SceneManager* mSceneManager;
-    };
-
     void Scene::preload(const std::string &mesh, bool useAnim)
     {
         std::string mesh_ = mesh;
@@ -971,7 +951,11 @@ namespace MWWorld
             mesh_ = Misc::ResourceHelpers::correctActorModelPath(mesh_, mRendering.getResourceSystem()->getVFS());
 
         if (!mRendering.getResourceSystem()->getSceneManager()->checkLoaded(mesh_, mRendering.getReferenceTime()))
-            mRendering.getWorkQueue()->addWorkItem(new PreloadMeshItem(mesh_, mRendering.getResourceSystem()->getSceneManager()));
+        {
+            // getAsync() expects the key the scene is cached under
+            mRendering.getResourceSystem()->getVFS()->normalizeFilename(mesh_);
+            mRendering.getResourceSystem()->getSceneManager()->getAsync(mesh_);
+        }
     }
 
     void Scene::preloadCells(float dt)
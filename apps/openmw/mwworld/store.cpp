@@ -122,6 +122,8 @@ namespace MWWorld
     Store<T>::Store(const Store<T>& orig)
         : mStatic(orig.mStatic)
     {
+        for (typename Static::iterator it = mStatic.begin(); it != mStatic.end(); ++it)
+            mStaticIndex.insert(&it->second);
     }
 
     template<typename T>
@@ -131,31 +133,26 @@ namespace MWWorld
         assert(mShared.size() >= mStatic.size());
         mShared.erase(mShared.begin() + mStatic.size(), mShared.end());
         mDynamic.clear();
+        mDynamicIndex.clear();
     }
 
     template<typename T>
     const T *Store<T>::search(const std::string &id) const
     {
-        std::string idLower = Misc::StringUtils::lowerCase(id);
-
-        typename Dynamic::const_iterator dit = mDynamic.find(idLower);
-        if (dit != mDynamic.end()) {
-            return &dit->second;
-        }
-
-        typename std::map<std::string, T>::const_iterator it = mStatic.find(idLower);
-
-        if (it != mStatic.end() && Misc::StringUtils::ciEqual(it->second.mId, id)) {
-            return &(it->second);
-        }
+        return search(id.data(), id.size());
+    }
+    template<typename T>
+    const T *Store<T>::search(const char *id, size_t size) const
+    {
+        if (const T *record = mDynamicIndex.find(id, size))
+            return record;
 
-        return 0;
+        return mStaticIndex.find(id, size);
     }
     template<typename T>
     bool Store<T>::isDynamic(const std::string &id) const
     {
-        typename Dynamic::const_iterator dit = mDynamic.find(id);
-        return (dit != mDynamic.end());
+        return mDynamicIndex.find(id.data(), id.size()) != nullptr;
     }
     template<typename T>
     const T *Store<T>::searchRandom(const std::string &id) const
@@ -169,10 +166,15 @@ namespace MWWorld
     template<typename T>
     const T *Store<T>::find(const std::string &id) const
     {
-        const T *ptr = search(id);
+        return find(id.data(), id.size());
+    }
+    template<typename T>
+    const T *Store<T>::find(const char *id, size_t size) const
+    {
+        const T *ptr = search(id, size);
         if (ptr == 0)
         {
-            const std::string msg = T::getRecordType() + " '" + id + "' not found";
+            const std::string msg = T::getRecordType() + " '" + std::string(id, size) + "' not found";
             throw std::runtime_error(msg);
         }
         return ptr;
@@ -191,19 +193,37 @@ namespace MWWorld
     template<typename T>
     RecordId Store<T>::load(ESM::ESMReader &esm)
     {
-        T record;
-        bool isDeleted = false;
+        return insertParsed(*parse(esm));
+    }
+    template<typename T>
+    std::unique_ptr<StoreBase::ParsedRecord> Store<T>::parse(ESM::ESMReader &esm) const
+    {
+        Parsed* parsed = new Parsed;
+        std::unique_ptr<ParsedRecord> result(parsed);
 
-        record.load(esm, isDeleted);
-        Misc::StringUtils::lowerCaseInPlace(record.mId);
+        parsed->mRecord.load(esm, parsed->mIsDeleted);
+        Misc::StringUtils::lowerCaseInPlace(parsed->mRecord.mId);
 
-        std::pair<typename Static::iterator, bool> inserted = mStatic.insert(std::make_pair(record.mId, record));
-        if (inserted.second)
-            mShared.push_back(&inserted.first->second);
+        return result;
+    }
+    template<typename T>
+    RecordId Store<T>::insertParsed(ParsedRecord &parsed)
+    {
+        Parsed& record = static_cast<Parsed&>(parsed);
+        RecordId id(record.mRecord.mId, record.mIsDeleted);
+
+        // The parsed record is not needed any more, so move it into the store
+        typename Static::iterator found = mStatic.find(id.mId);
+        if (found == mStatic.end())
+        {
+            found = mStatic.emplace(id.mId, std::move(record.mRecord)).first;
+            mShared.push_back(&found->second);
+            mStaticIndex.insert(&found->second);
+        }
         else
-            inserted.first->second = record;
+            found->second = std::move(record.mRecord);
 
-        return RecordId(record.mId, isDeleted);
+        return id;
     }
     template<typename T>
     void Store<T>::setUp()
@@ -250,6 +270,7 @@ namespace MWWorld
         T *ptr = &result.first->second;
         if (result.second) {
             mShared.push_back(ptr);
+            mDynamicIndex.insert(ptr);
         } else {
             *ptr = item;
         }
@@ -264,6 +285,7 @@ namespace MWWorld
         T *ptr = &result.first->second;
         if (result.second) {
             mShared.push_back(ptr);
+            mStaticIndex.insert(ptr);
         } else {
             *ptr = item;
         }
@@ -288,6 +310,7 @@ namespace MWWorld
                 }
                 ++sharedIter;
             }
+            mStaticIndex.erase(id.data(), id.size());
             mStatic.erase(it);
         }
 
@@ -302,6 +325,7 @@ namespace MWWorld
         if (it == mDynamic.end()) {
             return false;
         }
+        mDynamicIndex.erase(id.data(), id.size());
         mDynamic.erase(it);
 
         // have to reinit the whole shared part
@@ -1088,7 +1112,8 @@ namespace MWWorld
         if (found == mStatic.end())
         {
             dialogue.loadData(esm, isDeleted);
-            mStatic.insert(std::make_pair(idLower, dialogue));
+            found = mStatic.insert(std::make_pair(idLower, dialogue)).first;
+            mStaticIndex.insert(&found->second);
         }
         else
         {
@@ -1099,12 +1124,20 @@ namespace MWWorld
         return RecordId(dialogue.mId, isDeleted);
     }
 
+    template <>
+    std::unique_ptr<StoreBase::ParsedRecord> Store<ESM::Dialogue>::parse(ESM::ESMReader &esm) const
+    {
+        // Dialogues are merged with the ones of previous content files, they have to be loaded in order.
+        return nullptr;
+    }
+
     template<>
     bool Store<ESM::Dialogue>::eraseStatic(const std::string &id)
     {
         auto it = mStatic.find(Misc::StringUtils::lowerCase(id));
 
         if (it != mStatic.end() && Misc::StringUtils::ciEqual(it->second.mId, id)) {
+            mStaticIndex.erase(id.data(), id.size());
             mStatic.erase(it);
         }
 
@@ -4,8 +4,10 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 
 #include "recordcmp.hpp"
+#include "recordindex.hpp"
 
 namespace ESM
 {
@@ -41,6 +43,20 @@ namespace MWWorld
         virtual int getDynamicSize() const { return 0; }
         virtual RecordId load(ESM::ESMReader &esm) = 0;
 
+        /// A record read by parse(), to be inserted by insertParsed().
+        struct ParsedRecord
+        {
+            virtual ~ParsedRecord() {}
+        };
+
+        /// Read a record without modifying the store, so that content files can be read concurrently.
+        /// @return nullptr if the record depends on previously loaded records and has to be load()ed in order instead.
+        /// @note Must be thread safe.
+        virtual std::unique_ptr<ParsedRecord> parse(ESM::ESMReader &esm) const { return nullptr; }
+
+        /// Insert a record returned by parse(), with the same result as load() of that record.
+        virtual RecordId insertParsed(ParsedRecord &record) { return RecordId(); }
+
         virtual bool eraseStatic(const std::string &id) {return false;}
         virtual void clearDynamic() {}
 
@@ -154,12 +170,25 @@ namespace MWWorld
         typedef std::map<std::string, T> Dynamic;
         typedef std::map<std::string, T> Static;
 
+        // Case insensitive lookup tables for the records in mStatic and mDynamic
+        RecordIndex<T> mStaticIndex;
+        RecordIndex<T> mDynamicIndex;
+
         friend class ESMStore;
 
+        struct Parsed : ParsedRecord
+        {
+            T mRecord;
+            bool mIsDeleted = false;
+        };
+
     public:
         Store();
         Store(const Store<T> &orig);
 
+        // The record indices and mShared point into the maps of the store they were built for
+        Store<T> &operator=(const Store<T> &orig) = delete;
+
         typedef SharedIterator<T> iterator;
 
         // setUp needs to be called again after
@@ -167,6 +196,8 @@ namespace MWWorld
         void setUp();
 
         const T *search(const std::string &id) const;
+        /// Look up a record without copying the ID. The ID is compared case insensitively.
+        const T *search(const char *id, size_t size) const;
 
         /**
          * Does the record with this ID come from the dynamic store?
@@ -177,6 +208,7 @@ namespace MWWorld
         const T *searchRandom(const std::string &id) const;
 
         const T *find(const std::string &id) const;
+        const T *find(const char *id, size_t size) const;
 
         /** Returns a random record that starts with the named ID. An exception is thrown if none
          * are found. */
@@ -199,6 +231,8 @@ namespace MWWorld
         bool erase(const T &item);
 
         RecordId load(ESM::ESMReader &esm);
+        std::unique_ptr<ParsedRecord> parse(ESM::ESMReader &esm) const;
+        RecordId insertParsed(ParsedRecord &record);
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const;
         RecordId read(ESM::ESMReader& reader);
     };
@@ -2,6 +2,7 @@
 
 #include <osg/Group>
 #include <osg/ComputeBoundsVisitor>
+#include <osg/Stats>
 
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 #include <BulletCollision/CollisionShapes/btCompoundShape.h>
@@ -167,14 +168,16 @@ namespace MWWorld
       mActivationDistanceOverride (activationDistanceOverride),
       mStartCell (startCell), mDistanceToFacedObject(-1), mTeleportEnabled(true),
       mLevitationEnabled(true), mGoToJail(false), mDaysInPrison(0),
-      mPlayerTraveling(false), mPlayerInJail(false), mSpellPreloadTimer(0.f)
+      mPlayerTraveling(false), mPlayerInJail(false), mSpellPreloadTimer(0.f),
+      mShouldSubmitPhysics(false), mPhysicsDuration(0.f)
     {
         mEsm.resize(contentFiles.size());
         Loading::Listener* listener = MWBase::Environment::get().getWindowManager()->getLoadingScreen();
         listener->loadingOn();
 
         GameContentLoader gameContentLoader(*listener);
-        EsmLoader esmLoader(mStore, mEsm, encoder, *listener);
+        EsmLoader esmLoader(mStore, mEsm, encoder, *listener,
+            std::max(0, Settings::Manager::getInt("content load threads", "General")));
 
         gameContentLoader.addLoader(".esm", &esmLoader);
         gameContentLoader.addLoader(".esp", &esmLoader);
@@ -183,6 +186,7 @@ namespace MWWorld
         gameContentLoader.addLoader(".project", &esmLoader);
 
         loadContentFiles(fileCollections, contentFiles, gameContentLoader);
+        esmLoader.finishLoading();
 
         listener->loadingOff();
 
@@ -204,6 +208,7 @@ namespace MWWorld
             navigatorSettings->mMaxClimb = MWPhysics::sStepSizeUp;
             navigatorSettings->mMaxSlope = MWPhysics::sMaxSlope;
             navigatorSettings->mSwimHeightScale = mSwimHeightScale;
+            navigatorSettings->mNavMeshDbPath = mUserDataPath + "/navmesh.db";
             DetourNavigator::RecastGlobalAllocator::init();
             mNavigator.reset(new DetourNavigator::NavigatorImpl(*navigatorSettings));
         }
@@ -1584,7 +1589,19 @@ namespace MWWorld
 
         mProjectileManager->update(duration);
 
-        const MWPhysics::PtrVelocityList &results = mPhysics->applyQueuedMovement(duration);
+        if (mPhysics->isAsync())
+        {
+            // the movement is solved while the frame is rendered, see submitPhysics()
+            mShouldSubmitPhysics = true;
+            mPhysicsDuration = duration;
+            return;
+        }
+
+        moveActors(mPhysics->applyQueuedMovement(duration));
+    }
+
+    void World::moveActors(const MWPhysics::PtrVelocityList& results)
+    {
         MWPhysics::PtrVelocityList::const_iterator player(results.end());
         for(MWPhysics::PtrVelocityList::const_iterator iter(results.begin());iter != results.end();++iter)
         {
@@ -1611,11 +1628,15 @@ namespace MWWorld
             if (const auto object = mPhysics->getObject(door.first))
                 mShouldUpdateNavigator = updateNavigatorObject(object) || mShouldUpdateNavigator;
 
+        const osg::Vec3f playerPosition = getPlayerPtr().getRefData().getPosition().asVec3();
+
         if (mShouldUpdateNavigator)
         {
-            mNavigator->update(getPlayerPtr().getRefData().getPosition().asVec3());
+            mNavigator->update(playerPosition);
             mShouldUpdateNavigator = false;
         }
+
+        mNavigator->updatePathRequests(playerPosition);
     }
 
     bool World::updateNavigatorObject(const MWPhysics::Object* object)
@@ -1895,6 +1916,20 @@ namespace MWWorld
         }
     }
 
+    void World::submitPhysics()
+    {
+        if (!mShouldSubmitPhysics)
+            return;
+
+        mShouldSubmitPhysics = false;
+        mPhysics->submitQueuedMovement(mPhysicsDuration);
+    }
+
+    void World::collectPhysics()
+    {
+        moveActors(mPhysics->collectQueuedMovement());
+    }
+
     void World::updatePlayer()
     {
         MWWorld::Ptr player = getPlayerPtr();
@@ -3861,6 +3896,12 @@ namespace MWWorld
         return mNavigator.get();
     }
 
+    void World::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        mPhysics->reportStats(frameNumber, stats);
+        stats.setAttribute(frameNumber, "Script Deferred", mLocalScripts.getNumDeferred());
+    }
+
     void World::updateActorPath(const MWWorld::ConstPtr& actor, const std::deque<osg::Vec3f>& path,
             const osg::Vec3f& halfExtents, const osg::Vec3f& start, const osg::Vec3f& end) const
     {
@@ -91,13 +91,15 @@ namespace MWWorld
             ESM::Variant* mYear;
             ESM::Variant* mTimeScale;
 
+            // Destroyed after the cells and the player, AI cancels its path requests when it's destroyed
+            std::unique_ptr<DetourNavigator::Navigator> mNavigator;
+
             Cells mCells;
 
             std::string mCurrentWorldSpace;
 
             std::unique_ptr<MWWorld::Player> mPlayer;
             std::unique_ptr<MWPhysics::PhysicsSystem> mPhysics;
-            std::unique_ptr<DetourNavigator::Navigator> mNavigator;
             std::unique_ptr<MWRender::RenderingManager> mRendering;
             std::unique_ptr<MWWorld::Scene> mWorldScene;
             std::unique_ptr<MWWorld::WeatherManager> mWeatherManager;
@@ -154,6 +156,9 @@ namespace MWWorld
             void doPhysics(float duration);
             ///< Run physics simulation and modify \a world accordingly.
 
+            void moveActors(const MWPhysics::PtrVelocityList& results);
+            ///< Move the actors to the positions computed by the physics simulation.
+
             void updateNavigator();
 
             bool updateNavigatorObject(const MWPhysics::Object* object);
@@ -184,6 +189,10 @@ namespace MWWorld
 
             float mSpellPreloadTimer;
 
+            // Actor movement to be solved by submitPhysics(), when using asynchronous physics
+            bool mShouldSubmitPhysics;
+            float mPhysicsDuration;
+
             float feetToGameUnits(float feet);
             float getActivationDistancePlusTelekinesis();
 
@@ -491,6 +500,10 @@ namespace MWWorld
             void update (float duration, bool paused) override;
             void updatePhysics (float duration, bool paused) override;
 
+            void submitPhysics() override;
+
+            void collectPhysics() override;
+
             void updateWindowManager () override;
 
             MWWorld::Ptr placeObject (const MWWorld::ConstPtr& object, float cursorX, float cursorY, int amount) override;
@@ -717,6 +730,8 @@ namespace MWWorld
 
             DetourNavigator::Navigator* getNavigator() const override;
 
+            void reportStats(unsigned int frameNumber, osg::Stats& stats) const override;
+
             void updateActorPath(const MWWorld::ConstPtr& actor, const std::deque<osg::Vec3f>& path,
                     const osg::Vec3f& halfExtents, const osg::Vec3f& start, const osg::Vec3f& end) const override;
 
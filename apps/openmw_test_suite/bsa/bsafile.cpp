@@ -0,0 +1,123 @@
+#include <components/bsa/bsa_file.hpp>
+#include <components/misc/binaryio.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+namespace
+{
+    using namespace testing;
+
+    struct BsaFileTest : Test
+    {
+        std::vector<std::pair<std::string, std::string>> mFiles;
+        const std::string mPath = (boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("openmw-bsa-%%%%-%%%%.bsa")).string();
+
+        BsaFileTest()
+        {
+            mFiles.emplace_back("meshes\\foo.nif", "foo");
+            mFiles.emplace_back("Textures\\Bar.dds", "bar bar");
+            for (int i = 0; i < 100; ++i)
+                mFiles.emplace_back("sound\\s" + std::to_string(i) + ".wav", std::string(i, 'x'));
+
+            writeArchive();
+        }
+
+        ~BsaFileTest()
+        {
+            boost::filesystem::remove(mPath);
+        }
+
+        void writeArchive()
+        {
+            std::string names;
+            std::vector<uint32_t> nameOffsets;
+            for (const auto& file : mFiles)
+            {
+                nameOffsets.push_back(static_cast<uint32_t>(names.size()));
+                names += file.first;
+                names += '\0';
+            }
+
+            const uint32_t count = static_cast<uint32_t>(mFiles.size());
+
+            boost::filesystem::ofstream stream(mPath, std::ios::binary);
+            Misc::writeBinary<uint32_t>(stream, 0x100);
+            Misc::writeBinary<uint32_t>(stream, static_cast<uint32_t>(12 * count + names.size()));
+            Misc::writeBinary<uint32_t>(stream, count);
+
+            uint32_t offset = 0;
+            for (const auto& file : mFiles)
+            {
+                Misc::writeBinary<uint32_t>(stream, static_cast<uint32_t>(file.second.size()));
+                Misc::writeBinary<uint32_t>(stream, offset);
+                offset += static_cast<uint32_t>(file.second.size());
+            }
+            for (uint32_t nameOffset : nameOffsets)
+                Misc::writeBinary<uint32_t>(stream, nameOffset);
+            stream.write(names.data(), names.size());
+
+            // hash table, not used by the reader
+            for (uint32_t i = 0; i < count; ++i)
+                Misc::writeBinary<uint64_t>(stream, 0);
+
+            for (const auto& file : mFiles)
+                stream.write(file.second.data(), file.second.size());
+        }
+
+        static std::string read(const Files::IStreamPtr& stream)
+        {
+            std::ostringstream result;
+            result << stream->rdbuf();
+            return result.str();
+        }
+    };
+
+    TEST_F(BsaFileTest, exists_should_ignore_case)
+    {
+        Bsa::BSAFile file;
+        file.open(mPath);
+
+        EXPECT_TRUE(file.exists("meshes\\foo.nif"));
+        EXPECT_TRUE(file.exists("MESHES\\FOO.NIF"));
+        EXPECT_TRUE(file.exists("textures\\bar.dds"));
+        EXPECT_FALSE(file.exists("meshes\\foo.ni"));
+        EXPECT_FALSE(file.exists("meshes\\foo.nif2"));
+        EXPECT_FALSE(file.exists(""));
+    }
+
+    TEST_F(BsaFileTest, get_file_should_return_content_of_every_file)
+    {
+        Bsa::BSAFile file;
+        file.open(mPath);
+
+        for (const auto& entry : mFiles)
+            EXPECT_EQ(read(file.getFile(entry.first.c_str())), entry.second) << entry.first;
+    }
+
+    TEST_F(BsaFileTest, get_file_should_support_seeking)
+    {
+        Bsa::BSAFile file;
+        file.open(mPath);
+
+        const Files::IStreamPtr stream = file.getFile("textures\\bar.dds");
+        stream->seekg(4);
+        EXPECT_EQ(read(stream), "bar");
+        stream->clear();
+        stream->seekg(0, std::ios_base::end);
+        EXPECT_EQ(stream->tellg(), std::streampos(7));
+    }
+
+    TEST_F(BsaFileTest, get_file_should_throw_for_missing_file)
+    {
+        Bsa::BSAFile file;
+        file.open(mPath);
+
+        EXPECT_THROW(file.getFile("meshes\\missing.nif"), std::runtime_error);
+    }
+}
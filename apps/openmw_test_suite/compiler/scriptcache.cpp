@@ -0,0 +1,136 @@
+#include <components/compiler/extensions.hpp>
+#include <components/compiler/scriptcache.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+namespace
+{
+    using namespace testing;
+    using namespace Compiler;
+
+    struct CompilerScriptCacheTest : Test
+    {
+        const std::string mPath = (boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("%%%%-%%%%-%%%%-%%%%.scripts")).string();
+        Extensions mExtensions;
+        const std::vector<std::string> mEnvironment {"morrowind.esm"};
+        const std::string mSource = "begin test\nshort doOnce\nend test\n";
+        const std::vector<Interpreter::Type_Code> mCode {4, 0, 0, 0, 0x1000000, 0x2000000, 0x3000000, 0x4000000};
+        Locals mLocals;
+
+        CompilerScriptCacheTest()
+        {
+            mExtensions.registerInstruction("enableplayercontrols", "", 0x2000000);
+            mLocals.declare('s', "doonce");
+            mLocals.declare('f', "timer");
+        }
+
+        ~CompilerScriptCacheTest()
+        {
+            boost::filesystem::remove(mPath);
+        }
+    };
+
+    TEST_F(CompilerScriptCacheTest, get_should_return_put_script)
+    {
+        ScriptCache cache(mPath, mExtensions, mEnvironment);
+        cache.put("Test", mSource, mCode, mLocals);
+
+        std::vector<Interpreter::Type_Code> code;
+        Locals locals;
+        ASSERT_TRUE(cache.get("test", mSource, code, locals));
+        EXPECT_EQ(code, mCode);
+        EXPECT_EQ(locals.getType("doonce"), 's');
+        EXPECT_EQ(locals.getType("timer"), 'f');
+    }
+
+    TEST_F(CompilerScriptCacheTest, get_should_not_return_script_compiled_from_other_source)
+    {
+        ScriptCache cache(mPath, mExtensions, mEnvironment);
+        cache.put("test", mSource, mCode, mLocals);
+
+        std::vector<Interpreter::Type_Code> code;
+        Locals locals;
+        EXPECT_FALSE(cache.get("test", mSource + "\n", code, locals));
+        EXPECT_FALSE(cache.get("other", mSource, code, locals));
+    }
+
+    TEST_F(CompilerScriptCacheTest, load_should_restore_saved_scripts)
+    {
+        {
+            ScriptCache cache(mPath, mExtensions, mEnvironment);
+            cache.put("test", mSource, mCode, mLocals);
+            ASSERT_TRUE(cache.save());
+        }
+
+        ScriptCache cache(mPath, mExtensions, mEnvironment);
+        cache.load();
+        EXPECT_EQ(cache.getSize(), 1u);
+
+        std::vector<Interpreter::Type_Code> code;
+        Locals locals;
+        ASSERT_TRUE(cache.get("test", mSource, code, locals));
+        EXPECT_EQ(code, mCode);
+        const Locals& loaded = locals;
+        const Locals& saved = mLocals;
+        for (const char type : {'s', 'l', 'f'})
+            EXPECT_EQ(loaded.get(type), saved.get(type)) << type;
+    }
+
+    TEST_F(CompilerScriptCacheTest, load_should_discard_scripts_saved_for_other_environment)
+    {
+        {
+            ScriptCache cache(mPath, mExtensions, mEnvironment);
+            cache.put("test", mSource, mCode, mLocals);
+            ASSERT_TRUE(cache.save());
+        }
+
+        ScriptCache otherContentFiles(mPath, mExtensions, {"morrowind.esm", "tribunal.esm"});
+        otherContentFiles.load();
+        EXPECT_EQ(otherContentFiles.getSize(), 0u);
+
+        Extensions otherExtensions;
+        otherExtensions.registerInstruction("enableplayercontrols", "", 0x2000001);
+        ScriptCache otherOpcodes(mPath, otherExtensions, mEnvironment);
+        otherOpcodes.load();
+        EXPECT_EQ(otherOpcodes.getSize(), 0u);
+    }
+
+    TEST_F(CompilerScriptCacheTest, load_should_discard_truncated_file)
+    {
+        {
+            ScriptCache cache(mPath, mExtensions, mEnvironment);
+            cache.put("test", mSource, mCode, mLocals);
+            ASSERT_TRUE(cache.save());
+        }
+
+        boost::filesystem::resize_file(mPath, boost::filesystem::file_size(mPath) - 4);
+
+        ScriptCache cache(mPath, mExtensions, mEnvironment);
+        cache.load();
+        EXPECT_EQ(cache.getSize(), 0u);
+    }
+
+    TEST_F(CompilerScriptCacheTest, load_should_keep_scripts_put_before)
+    {
+        {
+            ScriptCache cache(mPath, mExtensions, mEnvironment);
+            cache.put("test", mSource, mCode, mLocals);
+            ASSERT_TRUE(cache.save());
+        }
+
+        const std::vector<Interpreter::Type_Code> newCode {0, 0, 0, 0};
+        ScriptCache cache(mPath, mExtensions, mEnvironment);
+        cache.put("test", mSource, newCode, Locals());
+        cache.load();
+
+        std::vector<Interpreter::Type_Code> code;
+        Locals locals;
+        ASSERT_TRUE(cache.get("test", mSource, code, locals));
+        EXPECT_EQ(code, newCode);
+    }
+}
@@ -12,8 +12,10 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <iterator>
 #include <deque>
+#include <thread>
 
 namespace
 {
@@ -693,4 +695,63 @@ namespace
 
         EXPECT_EQ(distance, 85.260780334472656) << distance;
     }
+
+    TEST_F(DetourNavigatorNavigatorTest, request_path_without_async_path_finder_threads_should_return_zero)
+    {
+        EXPECT_EQ(mNavigator->requestPath(mAgentHalfExtents, mStepSize, mStart, mEnd, Flag_walk), 0u);
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, take_path_for_unknown_request_should_return_not_found)
+    {
+        mSettings.mAsyncPathFinderThreads = 1;
+        mNavigator.reset(new NavigatorImpl(mSettings));
+
+        const auto result = mNavigator->takePath(42);
+        ASSERT_TRUE(result);
+        EXPECT_EQ(result->mStatus, Status::PathRequestNotFound);
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, requested_path_should_be_equal_to_found_one)
+    {
+        mSettings.mAsyncPathFinderThreads = 1;
+        mSettings.mMaxPathRequestsPerFrame = 1;
+        mNavigator.reset(new NavigatorImpl(mSettings));
+
+        const std::array<btScalar, 5 * 5> heightfieldData {{
+            0,   0,    0,    0,    0,
+            0, -25,  -25,  -25,  -25,
+            0, -25, -100, -100, -100,
+            0, -25, -100, -100, -100,
+            0, -25, -100, -100, -100,
+        }};
+        btHeightfieldTerrainShape shape(5, 5, heightfieldData.data(), 1, 0, 0, 2, PHY_FLOAT, false);
+        shape.setLocalScaling(btVector3(128, 128, 1));
+
+        mNavigator->addAgent(mAgentHalfExtents);
+        mNavigator->addObject(ObjectId(&shape), shape, btTransform::getIdentity());
+        mNavigator->update(mPlayerPosition);
+        mNavigator->wait();
+
+        EXPECT_EQ(mNavigator->findPath(mAgentHalfExtents, mStepSize, mStart, mEnd, Flag_walk, mOut), Status::Success);
+
+        const auto far = mNavigator->requestPath(mAgentHalfExtents, mStepSize, mEnd, mStart, Flag_walk);
+        const auto near = mNavigator->requestPath(mAgentHalfExtents, mStepSize, mStart, mEnd, Flag_walk);
+        ASSERT_NE(far, 0u);
+        ASSERT_NE(near, 0u);
+        EXPECT_FALSE(mNavigator->takePath(near));
+
+        mNavigator->updatePathRequests(mStart);
+
+        boost::optional<PathResult> result;
+        while (!(result = mNavigator->takePath(near)))
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        EXPECT_EQ(result->mStatus, Status::Success);
+        EXPECT_EQ(std::deque<osg::Vec3f>(result->mPath.begin(), result->mPath.end()), mPath);
+        EXPECT_FALSE(mNavigator->takePath(far));
+        EXPECT_EQ(mNavigator->takePath(near)->mStatus, Status::PathRequestNotFound);
+
+        mNavigator->cancelPath(far);
+        EXPECT_EQ(mNavigator->takePath(far)->mStatus, Status::PathRequestNotFound);
+    }
 }
@@ -0,0 +1,113 @@
+#include <components/detournavigator/navmeshdb.hpp>
+#include <components/detournavigator/recastmesh.hpp>
+#include <components/detournavigator/settings.hpp>
+
+#include <DetourAlloc.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    struct DetourNavigatorNavMeshDbTest : Test
+    {
+        const osg::Vec3f mAgentHalfExtents {1, 2, 3};
+        const TilePosition mTilePosition {0, 0};
+        const std::size_t mGeneration = 0;
+        const std::size_t mRevision = 0;
+        const std::vector<int> mIndices {{0, 1, 2}};
+        const std::vector<float> mVertices {{0, 0, 0, 1, 0, 0, 1, 1, 0}};
+        const std::vector<AreaType> mAreaTypes {1, AreaType_ground};
+        const std::vector<RecastMesh::Water> mWater {};
+        const std::size_t mTrianglesPerChunk {1};
+        const RecastMesh mRecastMesh {mGeneration, mRevision, mIndices, mVertices,
+                                      mAreaTypes, mWater, mTrianglesPerChunk};
+        const std::vector<OffMeshConnection> mOffMeshConnections {};
+        const unsigned char mData[4] {1, 2, 3, 4};
+        Settings mSettings;
+
+        DetourNavigatorNavMeshDbTest()
+        {
+            mSettings.mCellSize = 0.2f;
+            mSettings.mCellHeight = 0.2f;
+            mSettings.mTileSize = 64;
+            mSettings.mMaxNavMeshDbFileSize = 1024;
+            mSettings.mNavMeshDbPath = (boost::filesystem::temp_directory_path()
+                / boost::filesystem::unique_path("openmw-navmesh-%%%%-%%%%.db")).string();
+        }
+
+        ~DetourNavigatorNavMeshDbTest()
+        {
+            boost::filesystem::remove(mSettings.mNavMeshDbPath);
+        }
+
+        bool hasData(const NavMeshData& navMeshData) const
+        {
+            return navMeshData.mValue && navMeshData.mSize == static_cast<int>(sizeof(mData))
+                && std::memcmp(navMeshData.mValue.get(), mData, sizeof(mData)) == 0;
+        }
+    };
+
+    TEST_F(DetourNavigatorNavMeshDbTest, get_for_empty_db_should_return_empty_value)
+    {
+        NavMeshDb db(mSettings);
+        EXPECT_FALSE(db.get(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections).mValue);
+        EXPECT_EQ(db.getTilesCount(), 0u);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, get_should_return_put_value)
+    {
+        NavMeshDb db(mSettings);
+        db.put(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, mData, sizeof(mData));
+        EXPECT_TRUE(hasData(db.get(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections)));
+        EXPECT_EQ(db.getTilesCount(), 1u);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, get_for_other_recast_mesh_should_return_empty_value)
+    {
+        NavMeshDb db(mSettings);
+        db.put(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, mData, sizeof(mData));
+
+        const std::vector<float> vertices {{0, 0, 0, 1, 0, 0, 1, 2, 0}};
+        const RecastMesh otherRecastMesh {mGeneration, mRevision, mIndices, vertices,
+                                          mAreaTypes, mWater, mTrianglesPerChunk};
+        EXPECT_FALSE(db.get(mAgentHalfExtents, mTilePosition, otherRecastMesh, mOffMeshConnections).mValue);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, put_values_should_be_available_after_reopen)
+    {
+        {
+            NavMeshDb db(mSettings);
+            db.put(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, mData, sizeof(mData));
+        }
+        NavMeshDb db(mSettings);
+        EXPECT_EQ(db.getTilesCount(), 1u);
+        EXPECT_TRUE(hasData(db.get(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections)));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, reopen_with_other_settings_should_discard_values)
+    {
+        {
+            NavMeshDb db(mSettings);
+            db.put(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, mData, sizeof(mData));
+        }
+        mSettings.mTileSize = 128;
+        NavMeshDb db(mSettings);
+        EXPECT_EQ(db.getTilesCount(), 0u);
+        EXPECT_FALSE(db.get(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections).mValue);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, put_should_not_grow_file_over_max_size)
+    {
+        mSettings.mMaxNavMeshDbFileSize = 0;
+        NavMeshDb db(mSettings);
+        db.put(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, mData, sizeof(mData));
+        EXPECT_EQ(db.getTilesCount(), 0u);
+    }
+}
@@ -0,0 +1,169 @@
+#include "operators.hpp"
+
+#include <components/detournavigator/navmeshjobqueue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    struct DetourNavigatorNavMeshJobQueueTest : Test
+    {
+        const osg::Vec3f mAgentHalfExtents {29, 29, 66};
+        const TilePosition mPlayerTile {0, 0};
+        NavMeshJobQueue mQueue;
+
+        NavMeshJob makeJob(const TilePosition& tile, ChangeType changeType, unsigned tryNumber = 0) const
+        {
+            NavMeshJob job;
+            job.mAgentHalfExtents = mAgentHalfExtents;
+            job.mChangedTile = tile;
+            job.mTryNumber = tryNumber;
+            job.mChangeType = changeType;
+            job.mDistanceToPlayer = getManhattanDistance(tile, mPlayerTile);
+            job.mDistanceToOrigin = getManhattanDistance(tile, TilePosition {0, 0});
+            return job;
+        }
+    };
+
+    TEST_F(DetourNavigatorNavMeshJobQueueTest, pop_should_return_closest_to_player_tile_first)
+    {
+        EXPECT_TRUE(mQueue.push(makeJob(TilePosition {2, 0}, ChangeType::add)));
+        EXPECT_TRUE(mQueue.push(makeJob(TilePosition {0, 1}, ChangeType::add)));
+        EXPECT_TRUE(mQueue.push(makeJob(TilePosition {-3, 0}, ChangeType::add)));
+
+        ASSERT_EQ(mQueue.size(), 3u);
+        EXPECT_EQ(mQueue.pop().mChangedTile, TilePosition(0, 1));
+        EXPECT_EQ(mQueue.pop().mChangedTile, TilePosition(2, 0));
+        EXPECT_EQ(mQueue.pop().mChangedTile, TilePosition(-3, 0));
+        EXPECT_TRUE(mQueue.empty());
+    }
+
+    TEST_F(DetourNavigatorNavMeshJobQueueTest, pop_should_return_reposted_job_after_new_ones)
+    {
+        EXPECT_TRUE(mQueue.push(makeJob(TilePosition {0, 0}, ChangeType::add, 1)));
+        EXPECT_TRUE(mQueue.push(makeJob(TilePosition {2, 0}, ChangeType::add)));
+
+        EXPECT_EQ(mQueue.pop().mChangedTile, TilePosition(2, 0));
+        EXPECT_EQ(mQueue.pop().mChangedTile, TilePosition(0, 0));
+    }
+
+    TEST_F(DetourNavigatorNavMeshJobQueueTest, push_for_queued_tile_should_coalesce_jobs)
+    {
+        EXPECT_TRUE(mQueue.push(makeJob(TilePosition {1, 0}, ChangeType::update)));
+        EXPECT_FALSE(mQueue.push(makeJob(TilePosition {1, 0}, ChangeType::update)));
+
+        ASSERT_EQ(mQueue.size(), 1u);
+        EXPECT_EQ(mQueue.pop().mChangeType, ChangeType::update);
+    }
+
+    TEST_F(DetourNavigatorNavMeshJobQueueTest, push_for_queued_tile_with_other_change_type_should_merge_it)
+    {
+        EXPECT_TRUE(mQueue.push(makeJob(TilePosition {1, 0}, ChangeType::remove)));
+        EXPECT_FALSE(mQueue.push(makeJob(TilePosition {1, 0}, ChangeType::add)));
+
+        ASSERT_EQ(mQueue.size(), 1u);
+        EXPECT_EQ(mQueue.pop().mChangeType, ChangeType::mixed);
+    }
+
+    TEST_F(DetourNavigatorNavMeshJobQueueTest, push_for_popped_tile_should_add_job)
+    {
+        EXPECT_TRUE(mQueue.push(makeJob(TilePosition {1, 0}, ChangeType::add)));
+        mQueue.pop();
+        EXPECT_TRUE(mQueue.push(makeJob(TilePosition {1, 0}, ChangeType::update)));
+
+        ASSERT_EQ(mQueue.size(), 1u);
+        EXPECT_EQ(mQueue.pop().mChangeType, ChangeType::update);
+    }
+
+    TEST_F(DetourNavigatorNavMeshJobQueueTest, push_for_same_tile_of_other_agent_should_add_job)
+    {
+        NavMeshJob job = makeJob(TilePosition {1, 0}, ChangeType::add);
+        job.mAgentHalfExtents = osg::Vec3f(1, 1, 1);
+        EXPECT_TRUE(mQueue.push(makeJob(TilePosition {1, 0}, ChangeType::add)));
+        EXPECT_TRUE(mQueue.push(std::move(job)));
+
+        EXPECT_EQ(mQueue.size(), 2u);
+    }
+
+    TEST_F(DetourNavigatorNavMeshJobQueueTest, update_priorities_should_order_jobs_by_new_player_tile)
+    {
+        EXPECT_TRUE(mQueue.push(makeJob(TilePosition {-2, 0}, ChangeType::add)));
+        EXPECT_TRUE(mQueue.push(makeJob(TilePosition {1, 0}, ChangeType::add)));
+        EXPECT_TRUE(mQueue.push(makeJob(TilePosition {4, 0}, ChangeType::add)));
+
+        mQueue.updatePriorities(TilePosition {4, 0});
+
+        const NavMeshJob first = mQueue.pop();
+        EXPECT_EQ(first.mChangedTile, TilePosition(4, 0));
+        EXPECT_EQ(first.mDistanceToPlayer, 0);
+        EXPECT_EQ(mQueue.pop().mChangedTile, TilePosition(1, 0));
+        EXPECT_EQ(mQueue.pop().mChangedTile, TilePosition(-2, 0));
+    }
+
+    TEST_F(DetourNavigatorNavMeshJobQueueTest, update_priorities_should_keep_coalescing_queued_tiles)
+    {
+        EXPECT_TRUE(mQueue.push(makeJob(TilePosition {1, 0}, ChangeType::add)));
+        mQueue.updatePriorities(TilePosition {4, 0});
+
+        EXPECT_FALSE(mQueue.push(makeJob(TilePosition {1, 0}, ChangeType::add)));
+        EXPECT_EQ(mQueue.size(), 1u);
+    }
+
+    struct DetourNavigatorFindStealableQueueTest : DetourNavigatorNavMeshJobQueueTest
+    {
+        const std::thread::id mThreadId = std::this_thread::get_id();
+        const std::thread::id mOtherThreadId {};
+        std::map<std::thread::id, NavMeshJobQueue> mQueues;
+        std::vector<TilePosition> mLockedTiles;
+
+        NavMeshJobQueue* find()
+        {
+            return findStealableQueue(mQueues, mThreadId,
+                [&] (const osg::Vec3f& /*agentHalfExtents*/, const TilePosition& tile)
+                {
+                    return std::find(mLockedTiles.begin(), mLockedTiles.end(), tile) != mLockedTiles.end();
+                });
+        }
+    };
+
+    TEST_F(DetourNavigatorFindStealableQueueTest, should_return_other_thread_queue_with_unlocked_tile)
+    {
+        mQueues[mThreadId];
+        mQueues[mOtherThreadId].push(makeJob(TilePosition {1, 0}, ChangeType::add));
+
+        EXPECT_EQ(find(), &mQueues[mOtherThreadId]);
+    }
+
+    TEST_F(DetourNavigatorFindStealableQueueTest, should_not_return_own_queue)
+    {
+        mQueues[mThreadId].push(makeJob(TilePosition {1, 0}, ChangeType::add));
+
+        EXPECT_EQ(find(), nullptr);
+    }
+
+    TEST_F(DetourNavigatorFindStealableQueueTest, should_not_return_empty_queue)
+    {
+        mQueues[mOtherThreadId];
+
+        EXPECT_EQ(find(), nullptr);
+    }
+
+    TEST_F(DetourNavigatorFindStealableQueueTest, should_not_return_queue_waiting_for_locked_tile)
+    {
+        mQueues[mOtherThreadId].push(makeJob(TilePosition {1, 0}, ChangeType::add));
+        mLockedTiles.push_back(TilePosition {1, 0});
+
+        EXPECT_EQ(find(), nullptr);
+
+        mLockedTiles.clear();
+        EXPECT_EQ(find(), &mQueues[mOtherThreadId]);
+    }
+}
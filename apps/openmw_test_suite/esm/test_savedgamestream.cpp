@@ -0,0 +1,247 @@
+#include <components/esm/savedgamestream.hpp>
+#include <components/esm/esmreader.hpp>
+#include <components/esm/esmwriter.hpp>
+#include <components/files/memorystream.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+namespace
+{
+    using namespace testing;
+    using namespace ESM;
+
+    struct EsmSavedGameStreamTest : Test
+    {
+        std::string mData;
+        const std::string mPath = (boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("openmw-save-%%%%-%%%%.omwsave")).string();
+
+        EsmSavedGameStreamTest()
+        {
+            // Repeated records with some noise, larger than the buffers of the stream
+            unsigned int seed = 42;
+            for (int i = 0; i < 40000; ++i)
+            {
+                mData += "CELL record " + std::to_string(i % 100) + ' ';
+                seed = seed * 1103515245 + 12345;
+                mData += static_cast<char>(seed >> 16);
+            }
+        }
+
+        ~EsmSavedGameStreamTest()
+        {
+            boost::filesystem::remove(mPath);
+        }
+
+        std::string compress(const std::string& data, std::size_t pieceSize) const
+        {
+            std::string result;
+            SavedGameCompressor compressor([&] (const char* piece, std::size_t size) { result.append(piece, size); });
+            for (std::size_t offset = 0; offset < data.size(); offset += pieceSize)
+                compressor.write(data.data() + offset, std::min(pieceSize, data.size() - offset));
+            compressor.finish();
+            return result;
+        }
+
+        static Files::IStreamPtr makeStream(const std::string& data)
+        {
+            return std::make_shared<std::istringstream>(data);
+        }
+
+        static std::string readAll(std::istream& stream)
+        {
+            std::ostringstream result;
+            result << stream.rdbuf();
+            return result.str();
+        }
+
+        void writeFile(const std::string& data) const
+        {
+            boost::filesystem::ofstream file(mPath, std::ios::binary);
+            file << data;
+        }
+
+        static void writeRecords(ESMWriter& writer, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                writer.startRecord("CELL");
+                writer.writeHNString("NAME", "cell " + std::to_string(i));
+                writer.writeHNT("DATA", i);
+                writer.endRecord("CELL");
+            }
+        }
+
+        static void writeEsm(std::ostream& stream, int records)
+        {
+            ESMWriter writer;
+            writer.setFormat(1);
+            writer.setVersion(0);
+            writer.setType(0);
+            writer.setAuthor("");
+            writer.setDescription("");
+            writer.setRecordCount(records);
+            writer.save(stream);
+            writeRecords(writer, records);
+            writer.close();
+        }
+
+        static std::string makeEsm(int records)
+        {
+            std::stringstream stream;
+            writeEsm(stream, records);
+            return stream.str();
+        }
+
+        static void readRecords(ESMReader& reader, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                ASSERT_TRUE(reader.hasMoreRecs());
+                EXPECT_EQ(reader.getRecName().toString(), "CELL");
+                reader.getRecHeader();
+                EXPECT_EQ(reader.getHNString("NAME"), "cell " + std::to_string(i));
+                int value = -1;
+                reader.getHNT(value, "DATA");
+                EXPECT_EQ(value, i);
+            }
+            EXPECT_FALSE(reader.hasMoreRecs());
+        }
+    };
+
+    TEST_F(EsmSavedGameStreamTest, plain_stream_should_be_returned_as_is)
+    {
+        const Files::IStreamPtr stream = makeStream("TES3 and more");
+        EXPECT_EQ(openSavedGameStream(stream), stream);
+        EXPECT_EQ(readAll(*stream), "TES3 and more");
+    }
+
+    TEST_F(EsmSavedGameStreamTest, too_short_plain_stream_should_be_returned_as_is)
+    {
+        const Files::IStreamPtr stream = makeStream("TES");
+        EXPECT_EQ(openSavedGameStream(stream), stream);
+        EXPECT_EQ(readAll(*stream), "TES");
+    }
+
+    TEST_F(EsmSavedGameStreamTest, compressed_data_should_round_trip)
+    {
+        for (const std::size_t pieceSize : {std::size_t(1) << 20, std::size_t(1000), std::size_t(7)})
+        {
+            const std::string compressed = compress(mData, pieceSize);
+            EXPECT_LT(compressed.size(), mData.size() / 2);
+            const Files::IStreamPtr stream = openSavedGameStream(makeStream(compressed));
+            EXPECT_EQ(readAll(*stream), mData);
+        }
+    }
+
+    TEST_F(EsmSavedGameStreamTest, empty_data_should_round_trip)
+    {
+        const Files::IStreamPtr stream = openSavedGameStream(makeStream(compress(std::string(), 1)));
+        EXPECT_EQ(stream->get(), std::char_traits<char>::eof());
+    }
+
+    TEST_F(EsmSavedGameStreamTest, end_of_compressed_stream_should_be_its_uncompressed_size)
+    {
+        const Files::IStreamPtr stream = openSavedGameStream(makeStream(compress(mData, 4096)));
+        stream->seekg(0, std::ios::end);
+        EXPECT_EQ(stream->tellg(), std::streampos(mData.size()));
+        stream->seekg(0, std::ios::beg);
+        EXPECT_EQ(stream->tellg(), std::streampos(0));
+        EXPECT_EQ(stream->get(), mData[0]);
+    }
+
+    TEST_F(EsmSavedGameStreamTest, compressed_stream_should_support_seeking_in_both_directions)
+    {
+        const Files::IStreamPtr stream = openSavedGameStream(makeStream(compress(mData, 4096)));
+        std::string piece(100, '\0');
+        for (const std::size_t offset : {std::size_t(200000), std::size_t(10), std::size_t(200050),
+                                         std::size_t(500000), mData.size() - piece.size()})
+        {
+            stream->seekg(static_cast<std::streamoff>(offset));
+            ASSERT_TRUE(stream->read(&piece[0], piece.size()));
+            EXPECT_EQ(piece, mData.substr(offset, piece.size()));
+            EXPECT_EQ(stream->tellg(), std::streampos(offset + piece.size()));
+        }
+        EXPECT_EQ(stream->get(), std::char_traits<char>::eof());
+    }
+
+    TEST_F(EsmSavedGameStreamTest, newer_compressed_format_should_throw)
+    {
+        std::string compressed = compress(mData, 4096);
+        compressed[8] = 100;
+        EXPECT_THROW(openSavedGameStream(makeStream(compressed)), std::runtime_error);
+    }
+
+    TEST_F(EsmSavedGameStreamTest, truncated_compressed_header_should_throw)
+    {
+        EXPECT_THROW(openSavedGameStream(makeStream(compress(mData, 4096).substr(0, 10))), std::runtime_error);
+    }
+
+    TEST_F(EsmSavedGameStreamTest, compressed_stream_without_size_should_throw)
+    {
+        EXPECT_THROW(openSavedGameStream(makeStream(compress(std::string(), 1).substr(0, 16))), std::runtime_error);
+    }
+
+    TEST_F(EsmSavedGameStreamTest, esm_reader_should_read_compressed_file)
+    {
+        const std::string esm = makeEsm(1000);
+        writeFile(compress(esm, 1 << 20));
+
+        ESMReader reader;
+        reader.open(mPath);
+        EXPECT_EQ(reader.getFileSize(), esm.size());
+        readRecords(reader, 1000);
+    }
+
+    TEST_F(EsmSavedGameStreamTest, esm_reader_should_still_read_plain_file)
+    {
+        writeFile(makeEsm(10));
+
+        ESMReader reader;
+        reader.open(mPath);
+        readRecords(reader, 10);
+    }
+
+    TEST_F(EsmSavedGameStreamTest, esm_reader_should_skip_records_of_compressed_file)
+    {
+        writeFile(compress(makeEsm(1000), 1 << 20));
+
+        ESMReader reader;
+        reader.open(mPath);
+        for (int i = 0; i < 999; ++i)
+        {
+            reader.getRecName();
+            reader.getRecHeader();
+            reader.skipRecord();
+        }
+        reader.getRecName();
+        reader.getRecHeader();
+        EXPECT_EQ(reader.getHNString("NAME"), "cell 999");
+    }
+
+    TEST_F(EsmSavedGameStreamTest, esm_reader_should_restore_context_of_compressed_file)
+    {
+        writeFile(compress(makeEsm(1000), 1 << 20));
+
+        ESMReader reader;
+        reader.open(mPath);
+        const ESM_Context context = reader.getContext();
+        readRecords(reader, 1000);
+        reader.restoreContext(context);
+        readRecords(reader, 1000);
+    }
+
+    TEST_F(EsmSavedGameStreamTest, esm_writer_should_write_same_data_to_memory_stream)
+    {
+        Files::OMemStream stream;
+        writeEsm(stream, 1000);
+        EXPECT_FALSE(stream.fail());
+        EXPECT_EQ(stream.release(), makeEsm(1000));
+        EXPECT_TRUE(stream.release().empty());
+    }
+}
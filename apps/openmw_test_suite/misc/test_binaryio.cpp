@@ -0,0 +1,81 @@
+#include <components/misc/binaryio.hpp>
+#include <components/misc/hash.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+namespace
+{
+    const Misc::FileMagic sMagic {{'O', 'M', 'W', 'T', 'E', 'S', 'T', 'S'}};
+
+    TEST(MiscHashTest, should_be_fnv1a_of_added_bytes)
+    {
+        Misc::Hash hash;
+        EXPECT_EQ(hash.getValue(), 0xcbf29ce484222325ull);
+        hash.add('a');
+        EXPECT_EQ(hash.getValue(), 0xaf63dc4c8601ec8cull);
+        hash.add("r", 1);
+        EXPECT_EQ(hash.getSize(), 2u);
+    }
+
+    TEST(MiscHashTest, should_include_size_of_vectors)
+    {
+        Misc::Hash first;
+        first.add(std::vector<int> {1, 2});
+        first.add(std::vector<int> {3});
+
+        Misc::Hash second;
+        second.add(std::vector<int> {1});
+        second.add(std::vector<int> {2, 3});
+
+        EXPECT_NE(first.getValue(), second.getValue());
+    }
+
+    TEST(MiscBinaryIOTest, should_read_written_header_and_values)
+    {
+        std::stringstream stream;
+        Misc::writeFileHeader(stream, sMagic, 3);
+        Misc::writeBinary(stream, 42.5f);
+        Misc::writeBinary(stream, std::string("value"));
+        EXPECT_EQ(stream.str().size(), Misc::sFileHeaderSize + sizeof(float) + sizeof(std::uint32_t) + 5);
+
+        std::uint32_t version = 0;
+        float number = 0;
+        std::string string;
+        ASSERT_TRUE(Misc::readFileHeader(stream, sMagic, version));
+        EXPECT_EQ(version, 3u);
+        ASSERT_TRUE(Misc::readBinary(stream, number));
+        EXPECT_EQ(number, 42.5f);
+        ASSERT_TRUE(Misc::readBinary(stream, string, 5));
+        EXPECT_EQ(string, "value");
+    }
+
+    TEST(MiscBinaryIOTest, should_reject_other_magic)
+    {
+        std::stringstream stream;
+        Misc::writeFileHeader(stream, {{'O', 'M', 'W', 'O', 'T', 'H', 'E', 'R'}}, 1);
+
+        std::uint32_t version = 1;
+        EXPECT_FALSE(Misc::readFileHeader(stream, sMagic, version));
+        EXPECT_EQ(version, 0u);
+    }
+
+    TEST(MiscBinaryIOTest, should_return_version_0_for_truncated_header)
+    {
+        std::stringstream stream(std::string(sMagic.data(), sMagic.size()) + "\x01");
+
+        std::uint32_t version = 1;
+        EXPECT_TRUE(Misc::readFileHeader(stream, sMagic, version));
+        EXPECT_EQ(version, 0u);
+    }
+
+    TEST(MiscBinaryIOTest, should_not_read_string_longer_than_max_size)
+    {
+        std::stringstream stream;
+        Misc::writeBinary(stream, std::string("value"));
+
+        std::string string;
+        EXPECT_FALSE(Misc::readBinary(stream, string, 4));
+    }
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <thread>
+
 #include <boost/filesystem/fstream.hpp>
 
 #include <components/files/configurationmanager.hpp>
@@ -313,3 +315,227 @@ TEST_F(StoreTest, overwrite_test)
 
     ASSERT_TRUE (overwrittenRec && overwrittenRec->mModel == "the_new_model");
 }
+
+template <typename T>
+void writeRecord(ESM::ESMWriter& writer, const T& record, bool deleted = false)
+{
+    writer.startRecord(T::sRecordId);
+    record.save(writer, deleted);
+    writer.endRecord(T::sRecordId);
+}
+
+void writeInfos(ESM::ESMWriter& writer, const ESM::Dialogue& dialogue)
+{
+    for (const ESM::DialInfo& info : dialogue.mInfo)
+        writeRecord(writer, info);
+}
+
+template <typename T>
+void writeInfos(ESM::ESMWriter& writer, const T& record)
+{
+}
+
+/// Serialize all records of type T in the store, to compare the contents of two stores.
+template <typename T>
+void saveRecords(MWWorld::ESMStore& esmStore, std::ostream& outStream)
+{
+    ESM::ESMWriter writer;
+    writer.setFormat(0);
+    writer.save(outStream);
+
+    const MWWorld::Store<T>& store = esmStore.get<T>();
+    for (typename MWWorld::Store<T>::iterator it = store.begin(); it != store.end(); ++it)
+    {
+        writeRecord(writer, *it);
+        writeInfos(writer, *it);
+    }
+}
+
+template <typename T>
+void expectEqualRecords(MWWorld::ESMStore& expected, MWWorld::ESMStore& actual)
+{
+    std::ostringstream expectedStream;
+    std::ostringstream actualStream;
+    saveRecords<T>(expected, expectedStream);
+    saveRecords<T>(actual, actualStream);
+
+    EXPECT_EQ(expected.get<T>().getSize(), actual.get<T>().getSize()) << T::getRecordType();
+    EXPECT_TRUE(expectedStream.str() == actualStream.str()) << T::getRecordType();
+}
+
+/// Tests that parsing content files in parallel and merging them in load order gives the same store
+/// as loading them one after another.
+TEST_F(StoreTest, parallel_load_test)
+{
+    std::vector<std::string> files;
+
+    ESM::Apparatus apparatus;
+    apparatus.blank();
+    apparatus.mId = "foo";
+    apparatus.mModel = "foo_model";
+
+    ESM::Apparatus other;
+    other.blank();
+    other.mId = "bar";
+
+    ESM::Dialogue dialogue;
+    dialogue.blank();
+    dialogue.mId = "topic";
+    dialogue.mType = ESM::Dialogue::Topic;
+
+    ESM::DialInfo info;
+    info.blank();
+    info.mId = "1";
+    info.mResponse = "first";
+
+    // master file inserts the records
+    {
+        std::stringstream stream;
+        ESM::ESMWriter writer;
+        writer.setFormat(0);
+        writer.save(stream);
+        writeRecord(writer, apparatus);
+        writeRecord(writer, other);
+        writeRecord(writer, dialogue);
+        writeRecord(writer, info);
+        files.push_back(stream.str());
+    }
+
+    // a plugin overwrites one record, deletes another and adds a dialogue response
+    {
+        std::stringstream stream;
+        ESM::ESMWriter writer;
+        writer.setFormat(0);
+        writer.save(stream);
+        apparatus.mId = "Foo";
+        apparatus.mModel = "the_new_model";
+        writeRecord(writer, apparatus);
+        writeRecord(writer, other, true);
+        writeRecord(writer, dialogue);
+        info.mId = "2";
+        info.mPrev = "1";
+        info.mResponse = "second";
+        writeRecord(writer, info);
+        files.push_back(stream.str());
+    }
+
+    // another plugin inserts the deleted record again
+    {
+        std::stringstream stream;
+        ESM::ESMWriter writer;
+        writer.setFormat(0);
+        writer.save(stream);
+        other.mModel = "restored";
+        writeRecord(writer, other);
+        files.push_back(stream.str());
+    }
+
+    std::vector<ESM::ESMReader> readerList(files.size());
+
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        ESM::ESMReader& reader = readerList[i];
+        reader.setIndex(i);
+        reader.setGlobalReaderList(&readerList);
+        reader.open(Files::IStreamPtr(new std::stringstream(files[i])), "filename");
+        mEsmStore.load(reader, &dummyListener);
+    }
+    mEsmStore.setUp();
+
+    MWWorld::ESMStore parallelStore;
+    std::vector<MWWorld::ESMStore::ParsedRecords> parsed(files.size());
+    {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            threads.emplace_back([&, i] {
+                ESM::ESMReader reader;
+                reader.setIndex(i);
+                reader.open(Files::IStreamPtr(new std::stringstream(files[i])), "filename");
+                parsed[i] = parallelStore.parse(reader);
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    std::vector<ESM::ESMReader> parallelReaderList(files.size());
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        ESM::ESMReader& reader = parallelReaderList[i];
+        reader.setIndex(i);
+        reader.setGlobalReaderList(&parallelReaderList);
+        reader.open(Files::IStreamPtr(new std::stringstream(files[i])), "filename");
+        parallelStore.load(reader, parsed[i], &dummyListener);
+    }
+    parallelStore.setUp();
+
+    RUN_TEST_FOR_TYPES(expectEqualRecords, mEsmStore, parallelStore);
+
+    const ESM::Apparatus* overwritten = parallelStore.get<ESM::Apparatus>().search("foo");
+    ASSERT_TRUE(overwritten != nullptr);
+    EXPECT_EQ(overwritten->mModel, "the_new_model");
+
+    const ESM::Apparatus* restored = parallelStore.get<ESM::Apparatus>().search("bar");
+    ASSERT_TRUE(restored != nullptr);
+    EXPECT_EQ(restored->mModel, "restored");
+
+    const ESM::Dialogue* topic = parallelStore.get<ESM::Dialogue>().search("topic");
+    ASSERT_TRUE(topic != nullptr);
+    EXPECT_EQ(topic->mInfo.size(), 2u);
+}
+
+/// Tests case insensitive lookups, also after records were erased from the store.
+TEST_F(StoreTest, lookup_test)
+{
+    typedef ESM::Apparatus RecordType;
+
+    MWWorld::Store<RecordType>& store = const_cast<MWWorld::Store<RecordType>&>(mEsmStore.get<RecordType>());
+
+    const int count = 100;
+    RecordType record;
+    record.blank();
+    for (int i = 0; i < count; ++i)
+    {
+        record.mId = "static_" + std::to_string(i);
+        store.insertStatic(record);
+    }
+    for (int i = 0; i < count; ++i)
+    {
+        record.mId = "Dynamic_" + std::to_string(i);
+        store.insert(record);
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        const std::string id = "Static_" + std::to_string(i);
+        const RecordType* found = store.search(id);
+        ASSERT_TRUE(found != nullptr);
+        EXPECT_EQ(found->mId, "static_" + std::to_string(i));
+
+        const std::string padded = "DYNAMIC_" + std::to_string(i) + "_padding";
+        found = store.search(padded.data(), padded.size() - std::string("_padding").size());
+        ASSERT_TRUE(found != nullptr);
+        EXPECT_TRUE(store.isDynamic("dynamic_" + std::to_string(i)));
+    }
+
+    EXPECT_TRUE(store.search("static_") == nullptr);
+    EXPECT_TRUE(store.search("static_1000") == nullptr);
+    EXPECT_THROW(store.find("static_1000"), std::runtime_error);
+
+    for (int i = 0; i < count; i += 2)
+    {
+        EXPECT_TRUE(store.erase("DYNAMIC_" + std::to_string(i)));
+        store.eraseStatic("static_" + std::to_string(i));
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        const bool erased = i % 2 == 0;
+        EXPECT_EQ(store.search("dynamic_" + std::to_string(i)) == nullptr, erased);
+        EXPECT_EQ(store.search("static_" + std::to_string(i)) == nullptr, erased);
+    }
+
+    EXPECT_EQ(store.getSize(), static_cast<size_t>(count));
+    EXPECT_EQ(store.getDynamicSize(), static_cast<std::size_t>(count / 2));
+}
@@ -0,0 +1,149 @@
+#include <components/nifosg/textkeyindex.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace NifOsg;
+
+    struct NifOsgTextKeyIndexTest : Test
+    {
+        TextKeyMap mTextKeys {
+            {0.f, "idle: start"},
+            {0.5f, "soundgen: left 0.5 0.8"},
+            {1.f, "idle: loop start"},
+            {2.f, "idle: loop stop"},
+            {2.f, "idle: stop."},
+            {3.f, "attack1: start"},
+            {3.5f, "attack1: hit"},
+            {4.f, "attack1: stop"},
+            {5.f, "attack2: start"},
+            {5.5f, "sound: swish"},
+            {6.f, "attack2: stop"},
+            {7.f, "walkforward: start"},
+            {8.f, "walkforward: stop"},
+            {9.f, "walkforward: start"},
+            {10.f, "walkforward: stop"},
+            {11.f, "spellcast: target start"},
+            {12.f, "spellcast: target release"},
+        };
+    };
+
+    TEST_F(NifOsgTextKeyIndexTest, keys_should_be_in_time_order)
+    {
+        const TextKeyIndex index(mTextKeys);
+        ASSERT_EQ(index.getKeys().size(), mTextKeys.size());
+        auto textKey = mTextKeys.begin();
+        for (const TextKeyIndex::Key& key : index.getKeys())
+        {
+            EXPECT_EQ(key.mTime, textKey->first);
+            EXPECT_EQ(key.mText, textKey->second);
+            ++textKey;
+        }
+    }
+
+    TEST_F(NifOsgTextKeyIndexTest, keys_should_be_parsed)
+    {
+        const TextKeyIndex index(mTextKeys);
+        const TextKeyIndex::Key& loopStart = index.getKeys()[2];
+        EXPECT_EQ(loopStart.mGroupName, "idle");
+        EXPECT_EQ(loopStart.mGroup, index.findGroup("idle")->mId);
+        EXPECT_EQ(loopStart.mMarkerName, "loop start");
+        EXPECT_EQ(loopStart.mMarker, TextKeyIndex::Marker_LoopStart);
+        EXPECT_EQ(loopStart.mSoundType, TextKeyIndex::Sound_None);
+
+        const TextKeyIndex::Key& release = index.getKeys()[16];
+        EXPECT_EQ(release.mMarkerName, "target release");
+        EXPECT_EQ(release.mMarker, TextKeyIndex::Marker_None);
+
+        EXPECT_EQ(index.getKeys()[4].mMarker, TextKeyIndex::Marker_None);
+    }
+
+    TEST_F(NifOsgTextKeyIndexTest, sound_keys_should_be_parsed)
+    {
+        const TextKeyIndex index(mTextKeys);
+        const TextKeyIndex::Key& soundGen = index.getKeys()[1];
+        EXPECT_EQ(soundGen.mSoundType, TextKeyIndex::Sound_SoundGen);
+        EXPECT_EQ(soundGen.mSound, "left");
+        EXPECT_FLOAT_EQ(soundGen.mVolume, 0.5f);
+        EXPECT_FLOAT_EQ(soundGen.mPitch, 0.8f);
+
+        const TextKeyIndex::Key& sound = index.getKeys()[9];
+        EXPECT_EQ(sound.mSoundType, TextKeyIndex::Sound_Sound);
+        EXPECT_EQ(sound.mSound, "swish");
+        EXPECT_FLOAT_EQ(sound.mVolume, 1.f);
+        EXPECT_FLOAT_EQ(sound.mPitch, 1.f);
+    }
+
+    TEST_F(NifOsgTextKeyIndexTest, start_keys_should_know_if_a_hit_key_follows)
+    {
+        const TextKeyIndex index(mTextKeys);
+        EXPECT_TRUE(index.getKeys()[5].mHasHitKey);
+        EXPECT_FALSE(index.getKeys()[8].mHasHitKey);
+    }
+
+    TEST_F(NifOsgTextKeyIndexTest, find_group_should_return_keys_of_the_group)
+    {
+        const TextKeyIndex index(mTextKeys);
+        EXPECT_EQ(index.findGroup("run"), nullptr);
+        EXPECT_EQ(index.findGroup("attack"), nullptr);
+
+        const TextKeyIndex::Group* group = index.findGroup("walkforward");
+        ASSERT_NE(group, nullptr);
+        ASSERT_EQ(group->mKeys.size(), 4u);
+        EXPECT_EQ(group->mKeys[0].mKey, 11u);
+        EXPECT_EQ(group->mKeys[3].mKey, 14u);
+
+        EXPECT_EQ(group->findLast("start"), 2u);
+        EXPECT_EQ(group->findLast("loop start"), TextKeyIndex::sNone);
+    }
+
+    TEST_F(NifOsgTextKeyIndexTest, find_last_prefix_should_ignore_garbage_after_marker)
+    {
+        const TextKeyIndex index(mTextKeys);
+        const TextKeyIndex::Group* group = index.findGroup("idle");
+        ASSERT_NE(group, nullptr);
+        EXPECT_EQ(group->findLast("stop"), TextKeyIndex::sNone);
+        EXPECT_EQ(group->findLastPrefix("stop"), 3u);
+    }
+
+    TEST_F(NifOsgTextKeyIndexTest, keys_should_belong_to_every_group_named_before_a_separator)
+    {
+        const TextKeyIndex index(TextKeyMap {{0.f, "a: b: start"}});
+        const TextKeyIndex::Group* outer = index.findGroup("a");
+        const TextKeyIndex::Group* inner = index.findGroup("a: b");
+        ASSERT_NE(outer, nullptr);
+        ASSERT_NE(inner, nullptr);
+        EXPECT_EQ(outer->mKeys[0].mMarker, TextKeyIndex::Marker_None);
+        EXPECT_EQ(inner->mKeys[0].mMarker, TextKeyIndex::Marker_Start);
+        EXPECT_EQ(index.getKeys()[0].mGroup, inner->mId);
+    }
+
+    TEST_F(NifOsgTextKeyIndexTest, find_key_should_return_first_key_with_prefix)
+    {
+        const TextKeyIndex index(mTextKeys);
+        ASSERT_NE(index.findKey("walkforward: start"), nullptr);
+        EXPECT_EQ(index.findKey("walkforward: start")->mTime, 7.f);
+        ASSERT_NE(index.findKey("idle: stop"), nullptr);
+        EXPECT_EQ(index.findKey("idle: stop")->mTime, 2.f);
+        ASSERT_NE(index.findKey("attack1: "), nullptr);
+        EXPECT_EQ(index.findKey("attack1: ")->mTime, 3.f);
+        ASSERT_NE(index.findKey("spell"), nullptr);
+        EXPECT_EQ(index.findKey("spell")->mTime, 11.f);
+        EXPECT_EQ(index.findKey("idle: equip attach"), nullptr);
+        EXPECT_EQ(index.findKey("shield: equip attach"), nullptr);
+    }
+
+    TEST_F(NifOsgTextKeyIndexTest, bounds_should_match_text_key_map)
+    {
+        const TextKeyIndex index(mTextKeys);
+        for (float time : {-1.f, 0.f, 1.5f, 2.f, 5.5f, 12.f, 13.f})
+        {
+            EXPECT_EQ(index.lowerBound(time),
+                      static_cast<std::size_t>(std::distance(mTextKeys.begin(), mTextKeys.lower_bound(time))));
+            EXPECT_EQ(index.upperBound(time),
+                      static_cast<std::size_t>(std::distance(mTextKeys.begin(), mTextKeys.upper_bound(time))));
+        }
+    }
+}
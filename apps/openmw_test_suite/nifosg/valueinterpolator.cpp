@@ -0,0 +1,96 @@
+#include <components/nifosg/controller.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace NifOsg;
+
+    // Interpolation by looking up every time in the key map, as the interpolator did before it got the cursor
+    float interpolateByMap(const Nif::FloatKeyMap& keys, float time)
+    {
+        const Nif::FloatKeyMap::MapType& map = keys.mKeys;
+        if (time <= map.begin()->first)
+            return map.begin()->second.mValue;
+
+        const auto high = map.lower_bound(time);
+        if (high == map.end())
+            return map.rbegin()->second.mValue;
+
+        const auto low = std::prev(high);
+        const float a = (time - low->first) / (high->first - low->first);
+        if (keys.mInterpolationType == Nif::InterpolationType_Constant)
+            return a > 0.5f ? high->second.mValue : low->second.mValue;
+        return low->second.mValue + (high->second.mValue - low->second.mValue) * a;
+    }
+
+    struct NifOsgValueInterpolatorTest : Test
+    {
+        const std::vector<std::pair<float, float>> mKeys {
+            {0.f, 1.f}, {0.5f, 3.f}, {0.55f, -4.f}, {1.25f, -2.f}, {2.f, 0.f}, {3.f, 7.f}, {4.f, 10.f}};
+        const float mDuration = 4.f;
+        const float mStep = 1.f / 60.f;
+
+        /// Interpolate each time in order with one interpolator, so it moves its cursor as it does in playback
+        void expectSameValues(const std::vector<float>& times) const
+        {
+            for (const unsigned int type : {Nif::InterpolationType_Linear, Nif::InterpolationType_Constant})
+            {
+                const auto keys = std::make_shared<Nif::FloatKeyMap>();
+                keys->mInterpolationType = type;
+                for (const auto& key : mKeys)
+                    keys->mKeys[key.first].mValue = key.second;
+
+                const FloatInterpolator interpolator(keys);
+                for (const float time : times)
+                    EXPECT_NEAR(interpolator.interpKey(time), interpolateByMap(*keys, time), 1e-5f)
+                        << "type=" << type << " time=" << time;
+            }
+        }
+    };
+
+    TEST_F(NifOsgValueInterpolatorTest, forward_playback_should_give_same_values_as_map_lookup)
+    {
+        std::vector<float> times;
+        for (float time = -mStep; time <= mDuration + 2 * mStep; time += mStep)
+            times.push_back(time);
+        expectSameValues(times);
+    }
+
+    TEST_F(NifOsgValueInterpolatorTest, backward_playback_should_give_same_values_as_map_lookup)
+    {
+        std::vector<float> times;
+        for (float time = mDuration + 2 * mStep; time >= -mStep; time -= mStep)
+            times.push_back(time);
+        expectSameValues(times);
+    }
+
+    TEST_F(NifOsgValueInterpolatorTest, looping_playback_should_give_same_values_as_map_lookup)
+    {
+        std::vector<float> times;
+        for (float time = 0; time < 3 * mDuration; time += 3 * mStep)
+            times.push_back(std::fmod(time, mDuration));
+        expectSameValues(times);
+    }
+
+    TEST_F(NifOsgValueInterpolatorTest, playback_with_steps_over_several_keys_should_give_same_values_as_map_lookup)
+    {
+        expectSameValues({0.1f, 0.52f, 2.5f, 0.3f, 3.9f, 1.f, 1.1f, 0.f, 4.f, 5.f, 0.7f});
+    }
+
+    TEST_F(NifOsgValueInterpolatorTest, playback_at_key_times_should_give_same_values_as_map_lookup)
+    {
+        std::vector<float> times;
+        for (int repeat = 0; repeat < 2; ++repeat)
+            for (const auto& key : mKeys)
+                times.push_back(key.first);
+        expectSameValues(times);
+    }
+}
@@ -0,0 +1,145 @@
+#include <components/resource/objectcache.hpp>
+
+#include <osg/Object>
+
+#include <gtest/gtest.h>
+
+#include <tuple>
+#include <utility>
+
+namespace
+{
+    using namespace testing;
+    using namespace Resource;
+
+    struct ResourceObjectCacheTest : Test
+    {
+        osg::ref_ptr<ObjectCache> mCache = new ObjectCache;
+    };
+
+    TEST_F(ResourceObjectCacheTest, get_should_return_added_object_and_count_hits_and_misses)
+    {
+        osg::ref_ptr<osg::Object> object = new osg::DummyObject;
+        mCache->addEntryToObjectCache("meshes/a.nif", object);
+
+        EXPECT_EQ(mCache->getRefFromObjectCache("meshes/a.nif").get(), object.get());
+        EXPECT_EQ(mCache->getRefFromObjectCache("meshes/b.nif").get(), nullptr);
+        EXPECT_EQ(mCache->getCacheSize(), 1u);
+
+        CacheStats stats;
+        mCache->getStats(stats);
+        EXPECT_EQ(stats.mHits, 1u);
+        EXPECT_EQ(stats.mMisses, 1u);
+        EXPECT_EQ(stats.mEvictions, 0u);
+    }
+
+    TEST_F(ResourceObjectCacheTest, peek_should_not_count_hits_and_misses)
+    {
+        osg::ref_ptr<osg::Object> object = new osg::DummyObject;
+        mCache->addEntryToObjectCache("meshes/a.nif", object);
+
+        EXPECT_EQ(mCache->peekRefFromObjectCache("meshes/a.nif").get(), object.get());
+        EXPECT_EQ(mCache->peekRefFromObjectCache("meshes/b.nif").get(), nullptr);
+
+        CacheStats stats;
+        mCache->getStats(stats);
+        EXPECT_EQ(stats.mHits, 0u);
+        EXPECT_EQ(stats.mMisses, 0u);
+    }
+
+    TEST_F(ResourceObjectCacheTest, update_should_remove_expired_objects_without_external_references)
+    {
+        osg::ref_ptr<osg::Object> referenced = new osg::DummyObject;
+        mCache->addEntryToObjectCache("referenced", referenced);
+        mCache->addEntryToObjectCache("unreferenced", new osg::DummyObject);
+
+        mCache->updateCache(1.0, 0.0);
+        EXPECT_EQ(mCache->getCacheSize(), 2u);
+
+        mCache->updateCache(10.0, 5.0);
+        EXPECT_EQ(mCache->getCacheSize(), 1u);
+        EXPECT_EQ(mCache->getRefFromObjectCache("referenced").get(), referenced.get());
+    }
+
+    TEST_F(ResourceObjectCacheTest, update_should_keep_objects_checked_in_after_last_reference_was_dropped)
+    {
+        mCache->addEntryToObjectCache("a", new osg::DummyObject);
+        mCache->updateCache(1.0, 0.0);
+
+        EXPECT_TRUE(mCache->checkInObjectCache("a", 8.0));
+        mCache->updateCache(10.0, 5.0);
+        EXPECT_EQ(mCache->getCacheSize(), 1u);
+    }
+
+    TEST_F(ResourceObjectCacheTest, update_should_evict_least_recently_used_objects_over_memory_budget)
+    {
+        const std::size_t objectSize = estimateObjectSize(osg::DummyObject());
+        mCache->setMemoryBudget(2 * objectSize);
+
+        for (const char* name : {"a", "b", "c", "d"})
+            mCache->addEntryToObjectCache(name, new osg::DummyObject);
+        mCache->getRefFromObjectCache("a");
+        mCache->getRefFromObjectCache("c");
+
+        mCache->updateCache(1.0, 0.0);
+
+        EXPECT_EQ(mCache->getCacheSize(), 2u);
+        EXPECT_NE(mCache->getRefFromObjectCache("a").get(), nullptr);
+        EXPECT_NE(mCache->getRefFromObjectCache("c").get(), nullptr);
+
+        CacheStats stats;
+        mCache->getStats(stats);
+        EXPECT_EQ(stats.mEvictions, 2u);
+        EXPECT_EQ(stats.mSize, 2 * objectSize);
+    }
+
+    TEST_F(ResourceObjectCacheTest, update_should_not_evict_objects_with_external_references)
+    {
+        const std::size_t objectSize = estimateObjectSize(osg::DummyObject());
+        mCache->setMemoryBudget(objectSize);
+
+        osg::ref_ptr<osg::Object> a = new osg::DummyObject;
+        osg::ref_ptr<osg::Object> b = new osg::DummyObject;
+        mCache->addEntryToObjectCache("a", a);
+        mCache->addEntryToObjectCache("b", b);
+
+        mCache->updateCache(1.0, 0.0);
+
+        EXPECT_EQ(mCache->getCacheSize(), 2u);
+        CacheStats stats;
+        mCache->getStats(stats);
+        EXPECT_EQ(stats.mEvictions, 0u);
+    }
+
+    TEST_F(ResourceObjectCacheTest, pair_keys_should_be_found_in_their_shard)
+    {
+        osg::ref_ptr<GenericObjectCache<std::pair<int, int>>> cache = new GenericObjectCache<std::pair<int, int>>;
+        for (int x = -4; x < 4; ++x)
+            for (int y = -4; y < 4; ++y)
+                cache->addEntryToObjectCache(std::make_pair(x, y), new osg::DummyObject);
+
+        EXPECT_EQ(cache->getCacheSize(), 64u);
+        for (int x = -4; x < 4; ++x)
+            for (int y = -4; y < 4; ++y)
+                EXPECT_NE(cache->getRefFromObjectCache(std::make_pair(x, y)).get(), nullptr);
+
+        cache->removeFromObjectCache(std::make_pair(0, 0));
+        EXPECT_EQ(cache->getRefFromObjectCache(std::make_pair(0, 0)).get(), nullptr);
+        EXPECT_EQ(cache->getCacheSize(), 63u);
+    }
+
+    TEST_F(ResourceObjectCacheTest, tuple_keys_should_be_found_in_their_shard)
+    {
+        typedef std::tuple<int, unsigned char, unsigned int> Key;
+        osg::ref_ptr<GenericObjectCache<Key>> cache = new GenericObjectCache<Key>;
+        for (int x = 0; x < 8; ++x)
+            for (unsigned char lod = 0; lod < 4; ++lod)
+                cache->addEntryToObjectCache(Key(x, lod, 0), new osg::DummyObject);
+
+        EXPECT_EQ(cache->getCacheSize(), 32u);
+        for (int x = 0; x < 8; ++x)
+            for (unsigned char lod = 0; lod < 4; ++lod)
+                EXPECT_NE(cache->getRefFromObjectCache(Key(x, lod, 0)).get(), nullptr);
+        EXPECT_EQ(cache->getRefFromObjectCache(Key(0, 0, 1)).get(), nullptr);
+    }
+}
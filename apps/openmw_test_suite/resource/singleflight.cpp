@@ -0,0 +1,153 @@
+#include <components/resource/singleflight.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Resource;
+
+    /// Keeps the first load of a test in flight until release() is called.
+    struct Gate
+    {
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        bool mEntered = false;
+        bool mReleased = false;
+
+        void enterAndWait()
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mEntered = true;
+            mCondition.notify_all();
+            mCondition.wait(lock, [&] { return mReleased; });
+        }
+
+        void waitEntered()
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [&] { return mEntered; });
+        }
+
+        void release()
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mReleased = true;
+            mCondition.notify_all();
+        }
+    };
+
+    template <class Flight>
+    void waitForShared(const Flight& flight, std::size_t count)
+    {
+        while (flight.getNumShared() < count)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    TEST(ResourceSingleFlightTest, run_without_concurrent_requests_should_load)
+    {
+        SingleFlight<std::string, int> flight;
+        EXPECT_EQ(flight.run("a", [] { return 1; }), 1);
+        EXPECT_EQ(flight.run("a", [] { return 2; }), 2);
+        EXPECT_EQ(flight.getNumInFlight(), 0u);
+        EXPECT_EQ(flight.getNumShared(), 0u);
+    }
+
+    TEST(ResourceSingleFlightTest, concurrent_requests_for_same_key_should_share_one_load)
+    {
+        SingleFlight<std::string, std::shared_ptr<int>> flight;
+        Gate gate;
+        std::atomic<int> loads(0);
+        const auto load = [&]
+        {
+            ++loads;
+            gate.enterAndWait();
+            return std::make_shared<int>(42);
+        };
+
+        std::shared_ptr<int> first;
+        std::thread leader([&] { first = flight.run("mesh.nif", load); });
+        gate.waitEntered();
+        EXPECT_EQ(flight.getNumInFlight(), 1u);
+
+        const std::size_t numWaiters = 4;
+        std::vector<std::shared_ptr<int>> results(numWaiters);
+        std::vector<std::thread> waiters;
+        for (std::size_t i = 0; i < numWaiters; ++i)
+            waiters.emplace_back([&, i] { results[i] = flight.run("mesh.nif", load); });
+
+        waitForShared(flight, numWaiters);
+        gate.release();
+        leader.join();
+        for (std::thread& waiter : waiters)
+            waiter.join();
+
+        EXPECT_EQ(loads, 1);
+        ASSERT_NE(first, nullptr);
+        EXPECT_EQ(*first, 42);
+        for (const std::shared_ptr<int>& result : results)
+            EXPECT_EQ(result, first);
+        EXPECT_EQ(flight.getNumInFlight(), 0u);
+        EXPECT_EQ(flight.getNumShared(), numWaiters);
+    }
+
+    TEST(ResourceSingleFlightTest, requests_for_different_keys_should_not_wait_for_each_other)
+    {
+        SingleFlight<std::string, int> flight;
+        Gate gate;
+
+        int first = 0;
+        std::thread leader([&] { first = flight.run("a", [&] { gate.enterAndWait(); return 1; }); });
+        gate.waitEntered();
+
+        EXPECT_EQ(flight.run("b", [] { return 2; }), 2);
+        EXPECT_EQ(flight.getNumInFlight(), 1u);
+
+        gate.release();
+        leader.join();
+        EXPECT_EQ(first, 1);
+        EXPECT_EQ(flight.getNumShared(), 0u);
+    }
+
+    TEST(ResourceSingleFlightTest, failed_load_should_throw_for_all_waiters_and_be_retried_later)
+    {
+        SingleFlight<std::string, int> flight;
+        Gate gate;
+        const auto load = [&] () -> int
+        {
+            gate.enterAndWait();
+            throw std::runtime_error("not found");
+        };
+
+        bool leaderThrew = false;
+        bool waiterThrew = false;
+        std::thread leader([&] {
+            try { flight.run("a", load); }
+            catch (const std::runtime_error&) { leaderThrew = true; }
+        });
+        gate.waitEntered();
+        std::thread waiter([&] {
+            try { flight.run("a", load); }
+            catch (const std::runtime_error&) { waiterThrew = true; }
+        });
+
+        waitForShared(flight, 1);
+        gate.release();
+        leader.join();
+        waiter.join();
+
+        EXPECT_TRUE(leaderThrew);
+        EXPECT_TRUE(waiterThrew);
+        EXPECT_EQ(flight.getNumInFlight(), 0u);
+        EXPECT_EQ(flight.run("a", [] { return 3; }), 3);
+    }
+}
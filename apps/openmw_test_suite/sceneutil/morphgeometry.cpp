@@ -0,0 +1,143 @@
+#include <components/sceneutil/morphgeometry.hpp>
+
+#include <gtest/gtest.h>
+
+#include <osg/NodeVisitor>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    /// Records the internal geometry MorphGeometry passes on in the cull traversal
+    struct CullGeometryVisitor : osg::NodeVisitor
+    {
+        osg::Geometry* mGeometry = nullptr;
+
+        CullGeometryVisitor() : osg::NodeVisitor(CULL_VISITOR, TRAVERSE_ALL_CHILDREN) {}
+
+        void apply(osg::Geometry& geometry) override
+        {
+            mGeometry = &geometry;
+        }
+    };
+
+    struct SceneUtilMorphGeometryTest : Test
+    {
+        static const unsigned int sVertices = 100;
+
+        osg::ref_ptr<osg::Vec3Array> mSource {new osg::Vec3Array};
+        osg::ref_ptr<MorphGeometry> mMorph {new MorphGeometry};
+        CullGeometryVisitor mVisitor;
+        unsigned int mFrame = 0;
+
+        SceneUtilMorphGeometryTest()
+        {
+            for (unsigned int i = 0; i < sVertices; ++i)
+                mSource->push_back(osg::Vec3f(i, 2.f * i, -1.f * i));
+            osg::ref_ptr<osg::Geometry> geometry (new osg::Geometry);
+            geometry->setVertexArray(mSource);
+            geometry->addPrimitiveSet(new osg::DrawArrays(GL_POINTS, 0, sVertices));
+            mMorph->setSourceGeometry(geometry);
+        }
+
+        /// Add a target that moves the vertices in [begin, end)
+        void addTarget(unsigned int begin, unsigned int end, float weight)
+        {
+            osg::ref_ptr<osg::Vec3Array> offsets (new osg::Vec3Array(sVertices));
+            for (unsigned int i = begin; i < end; ++i)
+                (*offsets)[i] = osg::Vec3f(0.5f + i % 7, -0.25f * (i % 5), 1.f + 0.1f * (i % 3));
+            mMorph->addMorphTarget(offsets, weight);
+        }
+
+        /// Blend all vertices with all targets, as MorphGeometry did before it tracked the morphed range
+        std::vector<osg::Vec3f> blendAll() const
+        {
+            std::vector<osg::Vec3f> result(mSource->begin(), mSource->end());
+            for (const MorphGeometry::MorphTarget& target : mMorph->getMorphTargetList())
+                for (unsigned int i = 0; i < sVertices; ++i)
+                    result[i] += (*target.getOffsets())[i] * target.getWeight();
+            return result;
+        }
+
+        /// Cull the next frame as the controller does it after setting the weights
+        void cullFrame()
+        {
+            mMorph->dirty();
+            mVisitor.setTraversalNumber(++mFrame);
+            mVisitor.mGeometry = nullptr;
+            mMorph->accept(mVisitor);
+        }
+
+        void expectFullBlend()
+        {
+            cullFrame();
+            ASSERT_NE(mVisitor.mGeometry, nullptr);
+            const osg::Vec3Array& vertices = *static_cast<const osg::Vec3Array*>(mVisitor.mGeometry->getVertexArray());
+            const std::vector<osg::Vec3f> expected = blendAll();
+            ASSERT_EQ(vertices.size(), expected.size());
+            for (unsigned int i = 0; i < sVertices; ++i)
+                for (int c = 0; c < 3; ++c)
+                    EXPECT_NEAR(vertices[i][c], expected[i][c], 1e-4f) << "frame=" << mFrame << " vertex=" << i;
+        }
+    };
+
+    TEST_F(SceneUtilMorphGeometryTest, target_range_should_exclude_zero_offsets)
+    {
+        addTarget(10, 30, 1.f);
+        EXPECT_EQ(mMorph->getMorphTarget(0).getBegin(), 10u);
+        EXPECT_EQ(mMorph->getMorphTarget(0).getEnd(), 30u);
+    }
+
+    TEST_F(SceneUtilMorphGeometryTest, changing_weights_of_some_targets_should_give_full_blend)
+    {
+        addTarget(0, 100, 0.f);
+        addTarget(10, 30, 0.5f);
+        addTarget(25, 60, 0.f);
+        addTarget(80, 95, 1.f);
+
+        // each internal geometry is blended every other frame, so change the weights in an uneven pattern
+        const float weights[] = {0.f, 0.3f, 1.f, 0.75f, 0.f};
+        for (unsigned int frame = 0; frame < 20; ++frame)
+        {
+            mMorph->getMorphTarget(frame % 4).setWeight(weights[frame % 5]);
+            if (frame % 3 == 0)
+                mMorph->getMorphTarget((frame + 1) % 4).setWeight(weights[(frame + 2) % 5]);
+            expectFullBlend();
+        }
+    }
+
+    TEST_F(SceneUtilMorphGeometryTest, unchanged_weights_should_give_full_blend)
+    {
+        addTarget(10, 30, 0.5f);
+        addTarget(20, 40, 0.25f);
+        for (int frame = 0; frame < 3; ++frame)
+            expectFullBlend();
+    }
+
+    TEST_F(SceneUtilMorphGeometryTest, weights_back_to_zero_should_give_source_vertices)
+    {
+        addTarget(10, 30, 1.f);
+        addTarget(50, 70, 1.f);
+        expectFullBlend();
+        expectFullBlend();
+
+        mMorph->getMorphTarget(0).setWeight(0.f);
+        mMorph->getMorphTarget(1).setWeight(0.f);
+        expectFullBlend();
+        expectFullBlend();
+    }
+
+    TEST_F(SceneUtilMorphGeometryTest, target_added_after_blending_should_give_full_blend)
+    {
+        addTarget(10, 30, 1.f);
+        expectFullBlend();
+        expectFullBlend();
+
+        addTarget(40, 90, 0.5f);
+        expectFullBlend();
+        expectFullBlend();
+    }
+}
@@ -0,0 +1,133 @@
+#include <components/vfs/manager.hpp>
+#include <components/vfs/archive.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+    using namespace testing;
+
+    struct TestFile : VFS::File
+    {
+        std::string mContent;
+
+        explicit TestFile(const std::string& content)
+            : mContent(content)
+        {}
+
+        Files::IStreamPtr open() override
+        {
+            return std::make_shared<std::istringstream>(mContent);
+        }
+    };
+
+    struct TestArchive : VFS::Archive
+    {
+        std::map<std::string, TestFile> mFiles;
+
+        void listResources(std::map<std::string, VFS::File*>& out, char (*normalize_function) (char)) override
+        {
+            for (auto& file : mFiles)
+            {
+                std::string name = file.first;
+                std::transform(name.begin(), name.end(), name.begin(), normalize_function);
+                out[name] = &file.second;
+            }
+        }
+    };
+
+    std::string read(const Files::IStreamPtr& stream)
+    {
+        std::ostringstream result;
+        result << stream->rdbuf();
+        return result.str();
+    }
+
+    struct VFSManagerTest : Test
+    {
+        VFS::Manager mManager {false};
+
+        VFSManagerTest()
+        {
+            TestArchive* first = new TestArchive;
+            first->mFiles.emplace("Meshes\\Foo.nif", TestFile("first foo"));
+            first->mFiles.emplace("meshes/bar.nif", TestFile("first bar"));
+            mManager.addArchive(first);
+
+            TestArchive* second = new TestArchive;
+            second->mFiles.emplace("MESHES/BAR.NIF", TestFile("second bar"));
+            for (int i = 0; i < 100; ++i)
+                second->mFiles.emplace("textures/tx_" + std::to_string(i) + ".dds", TestFile(std::to_string(i)));
+            mManager.addArchive(second);
+
+            mManager.buildIndex();
+        }
+    };
+
+    TEST_F(VFSManagerTest, exists_should_ignore_case_and_slashes)
+    {
+        EXPECT_TRUE(mManager.exists("meshes/foo.nif"));
+        EXPECT_TRUE(mManager.exists("MESHES\\FOO.NIF"));
+        EXPECT_FALSE(mManager.exists("meshes/foo.ni"));
+        EXPECT_FALSE(mManager.exists("meshes/foo.nif2"));
+        EXPECT_FALSE(mManager.exists(""));
+    }
+
+    TEST_F(VFSManagerTest, exists_should_support_not_null_terminated_names)
+    {
+        const std::string name = "Meshes/Foo.nifX";
+        EXPECT_TRUE(mManager.exists(name.data(), name.size() - 1));
+        EXPECT_FALSE(mManager.exists(name.data(), name.size()));
+    }
+
+    TEST_F(VFSManagerTest, get_should_prefer_last_added_archive)
+    {
+        EXPECT_EQ(read(mManager.get("Meshes\\Bar.nif")), "second bar");
+        EXPECT_EQ(read(mManager.get("meshes/foo.nif")), "first foo");
+    }
+
+    TEST_F(VFSManagerTest, get_should_find_every_indexed_file)
+    {
+        for (int i = 0; i < 100; ++i)
+            EXPECT_EQ(read(mManager.get("Textures\\TX_" + std::to_string(i) + ".DDS")), std::to_string(i));
+    }
+
+    TEST_F(VFSManagerTest, get_should_throw_for_missing_file)
+    {
+        EXPECT_THROW(mManager.get("meshes/missing.nif"), std::runtime_error);
+    }
+
+    TEST_F(VFSManagerTest, get_normalized_should_find_normalized_name)
+    {
+        EXPECT_EQ(read(mManager.getNormalized("meshes/foo.nif")), "first foo");
+    }
+
+    TEST_F(VFSManagerTest, get_index_should_be_sorted_by_normalized_name)
+    {
+        const auto& index = mManager.getIndex();
+        ASSERT_EQ(index.size(), 102u);
+        EXPECT_EQ(index.begin()->first, "meshes/bar.nif");
+        EXPECT_EQ(std::next(index.begin())->first, "meshes/foo.nif");
+    }
+
+    TEST(VFSManagerStrictTest, exists_should_be_case_sensitive)
+    {
+        VFS::Manager manager(true);
+        TestArchive* archive = new TestArchive;
+        archive->mFiles.emplace("Meshes\\Foo.nif", TestFile("foo"));
+        manager.addArchive(archive);
+        manager.buildIndex();
+
+        EXPECT_TRUE(manager.exists("Meshes/Foo.nif"));
+        EXPECT_FALSE(manager.exists("meshes/foo.nif"));
+    }
+
+    TEST(VFSManagerEmptyTest, exists_should_return_false_before_index_is_built)
+    {
+        VFS::Manager manager(false);
+        EXPECT_FALSE(manager.exists("meshes/foo.nif"));
+    }
+}
@@ -28,6 +28,8 @@
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/fstream.hpp>
 
+#include <components/debug/debuglog.hpp>
+
 using namespace std;
 using namespace Bsa;
 
@@ -139,33 +141,111 @@ void BSAFile::readHeader()
 
         if(fs.offset + fs.fileSize > fsize)
             fail("Archive contains offsets outside itself");
-
-        // Add the file name to the lookup
-        mLookup[fs.name] = i;
     }
 
+    buildLookup();
+
     mIsLoaded = true;
 }
 
+namespace
+{
+    /// 32-bit FNV-1a of the lower-cased name
+    uint32_t hashName(const char *name)
+    {
+        uint32_t hash = 2166136261u;
+        for (; *name != '\0'; ++name)
+            hash = (hash ^ static_cast<unsigned char>(Misc::StringUtils::toLower(*name))) * 16777619u;
+        return hash;
+    }
+
+    bool ciEqualNames(const char *lhs, const char *rhs)
+    {
+        while (*lhs != '\0' && Misc::StringUtils::toLower(*lhs) == Misc::StringUtils::toLower(*rhs))
+        {
+            ++lhs;
+            ++rhs;
+        }
+        return *lhs == '\0' && *rhs == '\0';
+    }
+}
+
+void BSAFile::buildLookup()
+{
+    // keep the load factor at or below 1/2 so that probe sequences stay short
+    size_t capacity = 16;
+    while (capacity < mFiles.size() * 2)
+        capacity *= 2;
+
+    mLookup.assign(capacity, LookupEntry {0, -1});
+
+    const size_t mask = capacity - 1;
+    for (size_t i = 0; i < mFiles.size(); ++i)
+    {
+        const char *name = mFiles[i].name;
+        const uint32_t hash = hashName(name);
+
+        size_t slot = hash & mask;
+        // a later entry with the same name replaces the earlier one
+        while (mLookup[slot].mIndex != -1
+               && (mLookup[slot].mHash != hash || !ciEqualNames(name, mFiles[mLookup[slot].mIndex].name)))
+            slot = (slot + 1) & mask;
+
+        mLookup[slot].mHash = hash;
+        mLookup[slot].mIndex = static_cast<int>(i);
+    }
+}
+
 /// Get the index of a given file name, or -1 if not found
 int BSAFile::getIndex(const char *str) const
 {
-    Lookup::const_iterator it = mLookup.find(str);
-    if(it == mLookup.end())
+    if (mLookup.empty())
         return -1;
 
-    int res = it->second;
-    assert(res >= 0 && (size_t)res < mFiles.size());
-    return res;
+    const uint32_t hash = hashName(str);
+    const size_t mask = mLookup.size() - 1;
+    for (size_t slot = hash & mask; mLookup[slot].mIndex != -1; slot = (slot + 1) & mask)
+    {
+        const LookupEntry &entry = mLookup[slot];
+        if (entry.mHash == hash && ciEqualNames(mFiles[entry.mIndex].name, str))
+        {
+            assert(entry.mIndex >= 0 && (size_t)entry.mIndex < mFiles.size());
+            return entry.mIndex;
+        }
+    }
+
+    return -1;
 }
 
 /// Open an archive file.
 void BSAFile::open(const string &file)
 {
     mFilename = file;
+    mapFile();
     readHeader();
 }
 
+void BSAFile::mapFile()
+{
+    try
+    {
+        mMappedFile = std::make_shared<const Files::MappedFile>(mFilename);
+    }
+    catch (const std::exception& e)
+    {
+        // e.g. not enough address space on 32-bit systems
+        Log(Debug::Warning) << "Warning: failed to map BSA archive " << mFilename << " into memory, reading it from disk instead: " << e.what();
+        mMappedFile.reset();
+    }
+}
+
+Files::IStreamPtr BSAFile::openFileStream(size_t offset, size_t size) const
+{
+    if (mMappedFile)
+        return Files::openConstrainedFileStream (mMappedFile, offset, size);
+    return Files::openConstrainedFileStream (mFilename.c_str (), offset, size);
+}
+
 Files::IStreamPtr BSAFile::getFile(const char *file)
 {
     assert(file);
@@ -175,10 +255,10 @@ Files::IStreamPtr BSAFile::getFile(const char *file)
 
     const FileStruct &fs = mFiles[i];
 
-    return Files::openConstrainedFileStream (mFilename.c_str (), fs.offset, fs.fileSize);
+    return openFileStream (fs.offset, fs.fileSize);
 }
 
 Files::IStreamPtr BSAFile::getFile(const FileStruct *file)
 {
-    return Files::openConstrainedFileStream (mFilename.c_str (), file->offset, file->fileSize);
+    return openFileStream (file->offset, file->fileSize);
 }
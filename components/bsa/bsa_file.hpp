@@ -69,28 +69,38 @@ protected:
     /// Used for error messages
     std::string mFilename;
 
-    /// Case insensitive string comparison
-    struct iltstr
+    /// Read-only mapping of the whole archive, shared by all streams opened from it.
+    /// Empty if the archive could not be mapped, streams read from the file then.
+    Files::MappedFilePtr mMappedFile;
+
+    struct LookupEntry
     {
-        bool operator()(const char *s1, const char *s2) const
-        { return Misc::StringUtils::ciLess(s1, s2); }
+        uint32_t mHash;
+        int mIndex; ///< index into mFiles, -1 marks an empty slot
     };
 
-    /** A map used for fast file name lookup. The value is the index into
-        the files[] vector above. The iltstr ensures that file name
-        checks are case insensitive.
+    /** An open addressing hash table used for fast file name lookup,
+        keyed by a hash of the lower-cased file name so that file name
+        checks are case insensitive. The size is always a power of two.
     */
-    typedef std::map<const char*, int, iltstr> Lookup;
+    typedef std::vector<LookupEntry> Lookup;
     Lookup mLookup;
 
+    /// Build mLookup from mFiles, should be called once all file names are known
+    void buildLookup();
+
     /// Error handling
     void fail(const std::string &msg);
 
     /// Read header information from the input source
     virtual void readHeader();
 
-    /// Read header information from the input source
+    /// Map the archive into memory, falls back to regular file reads on failure
+    void mapFile();
 
+    /// Open a stream over a region of the archive
+    /// @note Thread safe.
+    Files::IStreamPtr openFileStream(size_t offset, size_t size) const;
 
     /// Get the index of a given file name, or -1 if not found
     /// @note Thread safe.
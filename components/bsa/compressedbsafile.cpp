@@ -26,6 +26,7 @@
 
 #include <stdexcept>
 #include <cassert>
+#include <cstring>
 
 #include <boost/scoped_array.hpp>
 #include <boost/filesystem/path.hpp>
@@ -36,7 +37,31 @@
 #include <boost/iostreams/filter/zlib.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <boost/iostreams/device/array.hpp>
-#include <components/bsa/memorystream.hpp>
+
+#include <components/files/memorystream.hpp>
+
+namespace
+{
+    /// Reads a decompressed file, which may be shared with the cache and other streams of the same file.
+    class BufferStreamBuf : public Files::MemBuf
+    {
+    public:
+        explicit BufferStreamBuf(std::shared_ptr<const std::vector<char>> buffer)
+            : Files::MemBuf(buffer->data(), buffer->size())
+            , mBuffer(std::move(buffer))
+        {
+        }
+
+    private:
+        std::shared_ptr<const std::vector<char>> mBuffer;
+    };
+
+    Files::IStreamPtr openBuffer(std::shared_ptr<const std::vector<char>> buffer)
+    {
+        std::unique_ptr<std::streambuf> buf(new BufferStreamBuf(std::move(buffer)));
+        return Files::IStreamPtr(new Files::ConstrainedFileStream(std::move(buf)));
+    }
+}
 
 namespace Bsa
 {
@@ -99,6 +124,7 @@ void CompressedBSAFile::getBZString(std::string& str, std::istream& filestream)
 
 CompressedBSAFile::CompressedBSAFile()
     : mCompressedByDefault(false), mEmbeddedFileNames(false)
+    , mCacheSize(0), mMaxCacheSize(0), mCacheHits(0), mCacheMisses(0)
 { }
 
 CompressedBSAFile::~CompressedBSAFile()
@@ -267,7 +293,6 @@ void CompressedBSAFile::readHeader()
 
         mFiles[fileIndex].name = reinterpret_cast<char*>(mStringBuf.data() + mStringBuffOffset);
 
-        mLookup[reinterpret_cast<char*>(mStringBuf.data() + mStringBuffOffset)] = fileIndex;
         mStringBuffOffset += stringLength + 1u;
     }
 
@@ -275,6 +300,8 @@ void CompressedBSAFile::readHeader()
         fail("Could not resolve names of files in BSA file");
     }
 
+    buildLookup();
+
     convertCompressedSizesToUncompressed();
     mIsLoaded = true;
 }
@@ -328,31 +355,115 @@ Files::IStreamPtr CompressedBSAFile::getFile(const char* file)
 Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
 {
     if (fileRecord.isCompressed(mCompressedByDefault)) {
-        Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilename.c_str(), fileRecord.offset, fileRecord.getSizeWithoutCompressionFlag());
+        if (mMaxCacheSize > 0)
+        {
+            if (Buffer cached = getCachedFile(fileRecord.offset))
+            {
+                ++mCacheHits;
+                return openBuffer(std::move(cached));
+            }
+            ++mCacheMisses;
+        }
 
-        std::istream* fileStream = streamPtr.get();
+        const std::uint32_t compressedSize = fileRecord.getSizeWithoutCompressionFlag();
 
-        if (mEmbeddedFileNames) {
-            std::string embeddedFileName;
-            getBZString(embeddedFileName, *fileStream);
+        // Inflate straight from the archive mapping when possible, otherwise read the
+        // compressed record into memory first. Either way the whole record is inflated in one go.
+        std::vector<char> recordBuffer;
+        const char* record = nullptr;
+        if (mMappedFile)
+        {
+            if (std::size_t(fileRecord.offset) + compressedSize > mMappedFile->size())
+                fail("Compressed record is outside of the archive");
+            record = mMappedFile->data() + fileRecord.offset;
         }
+        else
+        {
+            recordBuffer.resize(compressedSize);
+            openFileStream(fileRecord.offset, compressedSize)->read(recordBuffer.data(), compressedSize);
+            record = recordBuffer.data();
+        }
+
+        std::size_t headerSize = 0;
+        if (mEmbeddedFileNames && compressedSize > 0)
+            headerSize += 1 + static_cast<unsigned char>(record[0]);
 
         uint32_t uncompressedSize = 0u;
-        fileStream->read(reinterpret_cast<char*>(&uncompressedSize), sizeof(uncompressedSize));
+        if (headerSize + sizeof(uncompressedSize) > compressedSize)
+            fail("Compressed record is too small");
+        std::memcpy(&uncompressedSize, record + headerSize, sizeof(uncompressedSize));
+        headerSize += sizeof(uncompressedSize);
 
         boost::iostreams::filtering_streambuf<boost::iostreams::input> inputStreamBuf;
         inputStreamBuf.push(boost::iostreams::zlib_decompressor());
-        inputStreamBuf.push(*fileStream);
+        inputStreamBuf.push(boost::iostreams::array_source(record + headerSize, compressedSize - headerSize));
 
-        std::shared_ptr<Bsa::MemoryInputStream> memoryStreamPtr = std::make_shared<MemoryInputStream>(uncompressedSize);
+        std::shared_ptr<std::vector<char>> buffer = std::make_shared<std::vector<char>>(uncompressedSize);
 
-        boost::iostreams::basic_array_sink<char> sr(memoryStreamPtr->getRawData(), uncompressedSize);
+        boost::iostreams::basic_array_sink<char> sr(buffer->data(), uncompressedSize);
         boost::iostreams::copy(inputStreamBuf, sr);
 
-        return std::shared_ptr<std::istream>(memoryStreamPtr, (std::istream*)memoryStreamPtr.get());
+        if (mMaxCacheSize > 0)
+            addCachedFile(fileRecord.offset, buffer);
+
+        return openBuffer(std::move(buffer));
     }
 
-    return Files::openConstrainedFileStream(mFilename.c_str(), fileRecord.offset, fileRecord.size);
+    return openFileStream(fileRecord.offset, fileRecord.getSizeWithoutCompressionFlag());
+}
+
+CompressedBSAFile::Buffer CompressedBSAFile::getCachedFile(std::uint32_t offset)
+{
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    const auto found = mCacheIndex.find(offset);
+    if (found == mCacheIndex.end())
+        return Buffer();
+    mCache.splice(mCache.begin(), mCache, found->second);
+    return found->second->second;
+}
+
+void CompressedBSAFile::addCachedFile(std::uint32_t offset, const Buffer& buffer)
+{
+    if (buffer->size() > mMaxCacheSize)
+        return;
+
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    // Another thread may have inflated the same file in the meantime
+    if (mCacheIndex.find(offset) != mCacheIndex.end())
+        return;
+
+    mCache.emplace_front(offset, buffer);
+    mCacheIndex.emplace(offset, mCache.begin());
+    mCacheSize += buffer->size();
+
+    trimCache();
+}
+
+void CompressedBSAFile::trimCache()
+{
+    while (mCacheSize > mMaxCacheSize)
+    {
+        mCacheSize -= mCache.back().second->size();
+        mCacheIndex.erase(mCache.back().first);
+        mCache.pop_back();
+    }
+}
+
+void CompressedBSAFile::setCacheSize(std::size_t size)
+{
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    mMaxCacheSize = size;
+    trimCache();
+}
+
+CompressedBSAFile::CacheStats CompressedBSAFile::getCacheStats() const
+{
+    CacheStats stats;
+    stats.mHits = mCacheHits;
+    stats.mMisses = mCacheMisses;
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    stats.mSize = mCacheSize;
+    return stats;
 }
 
 BsaVersion CompressedBSAFile::detectVersion(std::string filePath)
@@ -407,7 +518,7 @@ void CompressedBSAFile::convertCompressedSizesToUncompressed()
             continue;
         }
 
-        Files::IStreamPtr dataBegin = Files::openConstrainedFileStream(mFilename.c_str(), fileRecord.offset, fileRecord.getSizeWithoutCompressionFlag());
+        Files::IStreamPtr dataBegin = openFileStream(fileRecord.offset, fileRecord.getSizeWithoutCompressionFlag());
 
         if (mEmbeddedFileNames)
         {
@@ -28,6 +28,12 @@
 
 #include <components/bsa/bsa_file.hpp>
 
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 namespace Bsa
 {
     enum BsaVersion
@@ -80,7 +86,32 @@ namespace Bsa
         /// \brief Normalizes given filename or folder and generates format-compatible hash. See https://en.uesp.net/wiki/Tes4Mod:Hash_Calculation.
         std::uint64_t generateHash(std::string stem, std::string extension) const;
         Files::IStreamPtr getFile(const FileRecord& fileRecord);
+
+        typedef std::shared_ptr<const std::vector<char>> Buffer;
+        typedef std::list<std::pair<std::uint32_t, Buffer>> CacheList;
+
+        /// Decompressed files by record offset, the most recently used first
+        CacheList mCache;
+        std::unordered_map<std::uint32_t, CacheList::iterator> mCacheIndex;
+        std::size_t mCacheSize;
+        std::size_t mMaxCacheSize;
+        mutable std::mutex mCacheMutex;
+        std::atomic<std::size_t> mCacheHits;
+        std::atomic<std::size_t> mCacheMisses;
+
+        Buffer getCachedFile(std::uint32_t offset);
+        void addCachedFile(std::uint32_t offset, const Buffer& buffer);
+        /// Drop the least recently used files until the cache fits its size, call with mCacheMutex locked.
+        void trimCache();
     public:
+        struct CacheStats
+        {
+            std::size_t mHits = 0;
+            std::size_t mMisses = 0;
+            /// Size of the decompressed files in the cache, in bytes.
+            std::size_t mSize = 0;
+        };
+
         CompressedBSAFile();
         virtual ~CompressedBSAFile();
 
@@ -92,7 +123,13 @@ namespace Bsa
        
         Files::IStreamPtr getFile(const char* filePath);
         Files::IStreamPtr getFile(const FileStruct* fileStruct);
-        
+
+        /// Keep up to \a size bytes of recently decompressed files in memory, so opening them again does not inflate
+        /// them again. 0 (the default) disables the cache.
+        /// @note The other methods may be called from several threads at once, this one may not.
+        void setCacheSize(std::size_t size);
+
+        CacheStats getCacheStats() const;
     };
 }
 
@@ -1,6 +1,7 @@
 #include "extensions.hpp"
 
 #include <cassert>
+#include <ostream>
 #include <stdexcept>
 
 #include "generator.hpp"
@@ -213,4 +214,31 @@ namespace Compiler
             iter!=mKeywords.end(); ++iter)
             keywords.push_back (iter->first);
     }
+
+    void Extensions::write (std::ostream& stream) const
+    {
+        for (std::map<std::string, int>::const_iterator iter (mKeywords.begin());
+            iter!=mKeywords.end(); ++iter)
+        {
+            stream << iter->first;
+
+            std::map<int, Function>::const_iterator function = mFunctions.find (iter->second);
+
+            if (function!=mFunctions.end())
+                stream
+                    << " function " << function->second.mReturn << ' ' << function->second.mArguments << ' '
+                    << function->second.mCode << ' ' << function->second.mCodeExplicit << ' '
+                    << function->second.mSegment;
+
+            std::map<int, Instruction>::const_iterator instruction = mInstructions.find (iter->second);
+
+            if (instruction!=mInstructions.end())
+                stream
+                    << " instruction " << instruction->second.mArguments << ' '
+                    << instruction->second.mCode << ' ' << instruction->second.mCodeExplicit << ' '
+                    << instruction->second.mSegment;
+
+            stream << '\n';
+        }
+    }
 }
@@ -305,6 +305,7 @@ namespace Compiler
         const int opcodeRepairedOnMe = 0x200030c;
         const int opcodeRepairedOnMeExplicit = 0x200030d;
         const int opcodeToggleRecastMesh = 0x2000310;
+        const int opcodeShowScriptProfile = 0x20031;
     }
 
     namespace Sky
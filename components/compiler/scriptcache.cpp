@@ -0,0 +1,214 @@
+#include "scriptcache.hpp"
+
+#include <fstream>
+#include <sstream>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <components/debug/debuglog.hpp>
+#include <components/misc/binaryio.hpp>
+#include <components/misc/hash.hpp>
+#include <components/misc/stringops.hpp>
+
+#include "extensions.hpp"
+
+namespace
+{
+    // Increase when the file layout or the code generated for the same source changes
+    const std::uint32_t sVersion = 1;
+    const Misc::FileMagic sMagic {{'O', 'M', 'W', 'S', 'C', 'R', 'P', 'T'}};
+
+    std::uint64_t hash (const std::string& data)
+    {
+        Misc::Hash hash;
+        hash.add (data.data(), data.size());
+        return hash.getValue();
+    }
+
+    std::uint64_t makeEnvironmentHash (const Compiler::Extensions& extensions,
+        const std::vector<std::string>& environment)
+    {
+        std::ostringstream stream;
+        extensions.write (stream);
+
+        for (const std::string& value : environment)
+            stream << value << '\n';
+
+        return hash (stream.str());
+    }
+}
+
+namespace Compiler
+{
+    ScriptCache::ScriptCache (const std::string& path, const Extensions& extensions,
+        const std::vector<std::string>& environment)
+    : mPath (path), mEnvironmentHash (makeEnvironmentHash (extensions, environment)), mChanged (false)
+    {}
+
+    void ScriptCache::load()
+    {
+        std::map<std::string, Entry> entries;
+
+        std::ifstream file (mPath, std::ios::binary);
+
+        if (!file.is_open())
+            return;
+
+        const std::uint64_t fileSize = boost::filesystem::file_size (mPath);
+
+        std::uint32_t version = 0;
+        std::uint64_t environmentHash = 0;
+        std::uint32_t count = 0;
+
+        if (!Misc::readFileHeader (file, sMagic, version) || version!=sVersion
+            || !Misc::readBinary (file, environmentHash) || environmentHash!=mEnvironmentHash)
+        {
+            Log(Debug::Info) << "Compiled scripts in \"" << mPath << "\" are outdated, discarding them";
+            return;
+        }
+
+        bool good = Misc::readBinary (file, count);
+
+        for (std::uint32_t i = 0; good && i<count; ++i)
+        {
+            std::string name;
+            Entry entry;
+            std::uint32_t codeSize = 0;
+
+            good = Misc::readBinary (file, name, fileSize) && Misc::readBinary (file, entry.mSourceHash)
+                && Misc::readBinary (file, entry.mSourceSize) && Misc::readBinary (file, codeSize)
+                && codeSize<=fileSize/sizeof (Interpreter::Type_Code);
+
+            if (good)
+            {
+                entry.mCode.resize (codeSize);
+                good = codeSize==0 || file.read (reinterpret_cast<char *> (entry.mCode.data()),
+                    codeSize * sizeof (Interpreter::Type_Code));
+            }
+
+            for (const char type : {'s', 'l', 'f'})
+            {
+                std::uint32_t localsCount = 0;
+                good = good && Misc::readBinary (file, localsCount) && localsCount<=fileSize;
+
+                for (std::uint32_t j = 0; good && j<localsCount; ++j)
+                {
+                    std::string local;
+                    good = Misc::readBinary (file, local, fileSize);
+                    entry.mLocals.declare (type, local);
+                }
+            }
+
+            if (good)
+                entries.insert (std::make_pair (name, std::move (entry)));
+        }
+
+        if (!good)
+        {
+            Log(Debug::Warning) << "Warning: failed to read compiled scripts from \"" << mPath << "\"";
+            return;
+        }
+
+        Log(Debug::Verbose) << "Loaded " << entries.size() << " compiled scripts from \"" << mPath << "\"";
+
+        std::lock_guard<std::mutex> lock (mMutex);
+
+        // scripts compiled while loading are newer than the stored ones
+        for (auto& entry : entries)
+            mEntries.insert (std::move (entry));
+    }
+
+    bool ScriptCache::save()
+    {
+        std::lock_guard<std::mutex> lock (mMutex);
+
+        if (!mChanged)
+            return true;
+
+        // write a complete new file first, so a crash can't leave a partially written cache behind
+        const std::string temporaryPath = mPath + ".tmp";
+
+        {
+            std::ofstream file (temporaryPath, std::ios::binary | std::ios::trunc);
+
+            Misc::writeFileHeader (file, sMagic, sVersion);
+            Misc::writeBinary (file, mEnvironmentHash);
+            Misc::writeBinary (file, static_cast<std::uint32_t> (mEntries.size()));
+
+            for (const auto& entry : mEntries)
+            {
+                Misc::writeBinary (file, entry.first);
+                Misc::writeBinary (file, entry.second.mSourceHash);
+                Misc::writeBinary (file, entry.second.mSourceSize);
+                Misc::writeBinary (file, static_cast<std::uint32_t> (entry.second.mCode.size()));
+                file.write (reinterpret_cast<const char *> (entry.second.mCode.data()),
+                    entry.second.mCode.size() * sizeof (Interpreter::Type_Code));
+
+                for (const char type : {'s', 'l', 'f'})
+                {
+                    const std::vector<std::string>& locals = entry.second.mLocals.get (type);
+                    Misc::writeBinary (file, static_cast<std::uint32_t> (locals.size()));
+
+                    for (const std::string& local : locals)
+                        Misc::writeBinary (file, local);
+                }
+            }
+
+            file.flush();
+
+            if (!file)
+            {
+                Log(Debug::Warning) << "Warning: failed to write compiled scripts to \"" << temporaryPath << "\"";
+                return false;
+            }
+        }
+
+        boost::system::error_code error;
+        boost::filesystem::rename (temporaryPath, mPath, error);
+
+        if (error)
+        {
+            Log(Debug::Warning) << "Warning: failed to replace \"" << mPath << "\": " << error.message();
+            return false;
+        }
+
+        mChanged = false;
+        return true;
+    }
+
+    bool ScriptCache::get (const std::string& name, const std::string& source,
+        std::vector<Interpreter::Type_Code>& code, Locals& locals) const
+    {
+        const std::string key = Misc::StringUtils::lowerCase (name);
+        const std::uint64_t sourceHash = hash (source);
+
+        std::lock_guard<std::mutex> lock (mMutex);
+
+        std::map<std::string, Entry>::const_iterator iter = mEntries.find (key);
+
+        if (iter==mEntries.end() || iter->second.mSourceHash!=sourceHash
+            || iter->second.mSourceSize!=source.size())
+            return false;
+
+        code = iter->second.mCode;
+        locals = iter->second.mLocals;
+        return true;
+    }
+
+    void ScriptCache::put (const std::string& name, const std::string& source,
+        const std::vector<Interpreter::Type_Code>& code, const Locals& locals)
+    {
+        Entry entry {hash (source), source.size(), code, locals};
+
+        std::lock_guard<std::mutex> lock (mMutex);
+
+        mEntries[Misc::StringUtils::lowerCase (name)] = std::move (entry);
+        mChanged = true;
+    }
+
+    std::size_t ScriptCache::getSize() const
+    {
+        std::lock_guard<std::mutex> lock (mMutex);
+        return mEntries.size();
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef COMPILER_SCRIPTCACHE_H_INCLUDED
+#define COMPILER_SCRIPTCACHE_H_INCLUDED
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <components/interpreter/types.hpp>
+
+#include "locals.hpp"
+
+namespace Compiler
+{
+    class Extensions;
+
+    /// \brief Compiled scripts stored on disk, so they don't have to be compiled again in the next session
+    ///
+    /// Scripts are keyed by name and a hash of their source. The whole cache is discarded if it was
+    /// written by another format version or for another environment (extensions, content files or
+    /// OpenMW version).
+    /// \note Thread safe.
+    class ScriptCache
+    {
+            struct Entry
+            {
+                std::uint64_t mSourceHash;
+                std::uint64_t mSourceSize;
+                std::vector<Interpreter::Type_Code> mCode;
+                Locals mLocals;
+            };
+
+            const std::string mPath;
+            const std::uint64_t mEnvironmentHash;
+            mutable std::mutex mMutex;
+            std::map<std::string, Entry> mEntries;
+            bool mChanged;
+
+        public:
+
+            ScriptCache (const std::string& path, const Extensions& extensions,
+                const std::vector<std::string>& environment);
+            ///< \param environment Anything besides the extensions that compiled code depends on
+            /// (e.g. OpenMW version, content file names and modification times).
+
+            void load();
+            ///< Add the entries stored in the file, if it was written for the same environment.
+
+            bool save();
+            ///< Write all entries to the file, if any was added since the last load or save.
+            /// \return Success?
+
+            bool get (const std::string& name, const std::string& source,
+                std::vector<Interpreter::Type_Code>& code, Locals& locals) const;
+            ///< Return code and locals of script \a name, if it was compiled from \a source.
+
+            void put (const std::string& name, const std::string& source,
+                const std::vector<Interpreter::Type_Code>& code, const Locals& locals);
+
+            std::size_t getSize() const;
+    };
+}
+
+#endif
@@ -7,14 +7,27 @@
 
 #include <osg/Stats>
 
+#include <algorithm>
+
 namespace
 {
-    using DetourNavigator::ChangeType;
-    using DetourNavigator::TilePosition;
+    // Latency percentiles are reported over this number of last jobs
+    const std::size_t sMaxLatencies = 1024;
+
+    std::size_t getThreadsCount(std::size_t value)
+    {
+        if (value > 0)
+            return value;
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
 
-    int getManhattanDistance(const TilePosition& lhs, const TilePosition& rhs)
+    float getPercentile(std::vector<float>& values, std::size_t percent)
     {
-        return std::abs(lhs.x() - rhs.x()) + std::abs(lhs.y() - rhs.y());
+        if (values.empty())
+            return 0;
+        const auto nth = values.begin() + std::min(values.size() - 1, values.size() * percent / 100);
+        std::nth_element(values.begin(), nth, values.end());
+        return *nth;
     }
 }
 
@@ -45,10 +58,18 @@ namespace DetourNavigator
         : mSettings(settings)
         , mRecastMeshManager(recastMeshManager)
         , mOffMeshConnectionsManager(offMeshConnectionsManager)
+        , mThreadsCount(getThreadsCount(settings.mAsyncNavMeshUpdaterThreads))
         , mShouldStop()
         , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize)
+        , mLastReport(std::chrono::steady_clock::now())
+        , mLastReportDone(0)
     {
-        for (std::size_t i = 0; i < mSettings.get().mAsyncNavMeshUpdaterThreads; ++i)
+        if (settings.mEnableNavMeshDiskCache && !settings.mNavMeshDbPath.empty())
+            mNavMeshDb.reset(new NavMeshDb(settings));
+
+        Log(Debug::Verbose) << "Start " << mThreadsCount << " nav mesh updater threads";
+
+        for (std::size_t i = 0; i < mThreadsCount; ++i)
             mThreads.emplace_back([&] { process(); });
     }
 
@@ -56,7 +77,7 @@ namespace DetourNavigator
     {
         mShouldStop = true;
         std::unique_lock<std::mutex> lock(mMutex);
-        mJobs = decltype(mJobs)();
+        mJobs.clear();
         mHasJob.notify_all();
         lock.unlock();
         for (auto& thread : mThreads)
@@ -72,26 +93,37 @@ namespace DetourNavigator
         if (changedTiles.empty())
             return;
 
+        const auto now = std::chrono::steady_clock::now();
+        std::size_t coalesced = 0;
+
         const std::lock_guard<std::mutex> lock(mMutex);
 
-        for (const auto& changedTile : changedTiles)
+        if (playerTile != mJobsPlayerTile)
         {
-            if (mPushed[agentHalfExtents].insert(changedTile.first).second)
-            {
-                Job job;
-
-                job.mAgentHalfExtents = agentHalfExtents;
-                job.mNavMeshCacheItem = navMeshCacheItem;
-                job.mChangedTile = changedTile.first;
-                job.mTryNumber = 0;
-                job.mChangeType = changedTile.second;
-                job.mDistanceToPlayer = getManhattanDistance(changedTile.first, playerTile);
-                job.mDistanceToOrigin = getManhattanDistance(changedTile.first, TilePosition {0, 0});
+            mJobsPlayerTile = playerTile;
+            mJobs.updatePriorities(playerTile);
+        }
 
-                mJobs.push(std::move(job));
-            }
+        for (const auto& changedTile : changedTiles)
+        {
+            Job job;
+
+            job.mAgentHalfExtents = agentHalfExtents;
+            job.mNavMeshCacheItem = navMeshCacheItem;
+            job.mChangedTile = changedTile.first;
+            job.mTryNumber = 0;
+            job.mChangeType = changedTile.second;
+            job.mDistanceToPlayer = getManhattanDistance(changedTile.first, playerTile);
+            job.mDistanceToOrigin = getManhattanDistance(changedTile.first, TilePosition {0, 0});
+            job.mPosted = now;
+
+            if (!mJobs.push(std::move(job)))
+                ++coalesced;
         }
 
+        if (coalesced > 0)
+            mJobsStats.lock()->mCoalesced += coalesced;
+
         Log(Debug::Debug) << "Posted " << mJobs.size() << " navigator jobs";
 
         if (!mJobs.empty())
@@ -115,7 +147,36 @@ namespace DetourNavigator
 
         stats.setAttribute(frameNumber, "NavMesh UpdateJobs", jobs);
 
+        std::vector<float> latencies;
+        std::size_t done = 0;
+        std::size_t cancelled = 0;
+        std::size_t coalesced = 0;
+
+        {
+            const auto locked = mJobsStats.lockConst();
+            latencies = locked->mLatencies;
+            done = locked->mDone;
+            cancelled = locked->mCancelled;
+            coalesced = locked->mCoalesced;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        const float seconds = std::chrono::duration<float>(now - mLastReport).count();
+        if (seconds > 0)
+            stats.setAttribute(frameNumber, "NavMesh TilesPerSecond", (done - mLastReportDone) / seconds);
+        mLastReport = now;
+        mLastReportDone = done;
+
+        stats.setAttribute(frameNumber, "NavMesh JobLatency50", getPercentile(latencies, 50));
+        stats.setAttribute(frameNumber, "NavMesh JobLatency95", getPercentile(latencies, 95));
+        stats.setAttribute(frameNumber, "NavMesh JobLatency99", getPercentile(latencies, 99));
+        stats.setAttribute(frameNumber, "NavMesh JobsCancelled", cancelled);
+        stats.setAttribute(frameNumber, "NavMesh JobsCoalesced", coalesced);
+
         mNavMeshTilesCache.reportStats(frameNumber, stats);
+
+        if (mNavMeshDb)
+            mNavMeshDb->reportStats(frameNumber, stats);
     }
 
     void AsyncNavMeshUpdater::process() throw()
@@ -127,9 +188,12 @@ namespace DetourNavigator
             {
                 if (auto job = getNextJob())
                 {
-                    const auto processed = processJob(*job);
+                    const auto status = processJob(*job);
                     unlockTile(job->mAgentHalfExtents, job->mChangedTile);
-                    if (!processed)
+                    // Only jobs that built a tile count towards the throughput and latency stats
+                    if (status == JobStatus::built)
+                        addLatency(std::chrono::steady_clock::now() - job->mPosted);
+                    else if (status == JobStatus::failed)
                         repost(std::move(*job));
                 }
             }
@@ -141,7 +205,7 @@ namespace DetourNavigator
         Log(Debug::Debug) << "Stop navigator jobs processing";
     }
 
-    bool AsyncNavMeshUpdater::processJob(const Job& job)
+    AsyncNavMeshUpdater::JobStatus AsyncNavMeshUpdater::processJob(const Job& job)
     {
         Log(Debug::Debug) << "Process job for agent=(" << std::fixed << std::setprecision(2) << job.mAgentHalfExtents << ")";
 
@@ -152,14 +216,25 @@ namespace DetourNavigator
         const auto navMeshCacheItem = job.mNavMeshCacheItem.lock();
 
         if (!navMeshCacheItem)
-            return true;
+            return JobStatus::skipped;
 
-        const auto recastMesh = mRecastMeshManager.get().getMesh(job.mChangedTile);
         const auto playerTile = *mPlayerTile.lockConst();
+
+        // Player moved away since the job was posted, don't build recast mesh for a tile that will be removed anyway
+        const int maxTiles = std::min(mSettings.get().mMaxTilesNumber,
+                                      navMeshCacheItem->lockConst()->getImpl().getParams()->maxTiles);
+        if (!shouldAddTile(job.mChangedTile, playerTile, maxTiles))
+        {
+            navMeshCacheItem->lock()->removeTile(job.mChangedTile);
+            ++mJobsStats.lock()->mCancelled;
+            return JobStatus::skipped;
+        }
+
+        const auto recastMesh = mRecastMeshManager.get().getMesh(job.mChangedTile);
         const auto offMeshConnections = mOffMeshConnectionsManager.get().get(job.mChangedTile);
 
         const auto status = updateNavMesh(job.mAgentHalfExtents, recastMesh.get(), job.mChangedTile, playerTile,
-            offMeshConnections, mSettings, navMeshCacheItem, mNavMeshTilesCache);
+            offMeshConnections, mSettings, navMeshCacheItem, mNavMeshTilesCache, mNavMeshDb.get());
 
         const auto finish = std::chrono::steady_clock::now();
 
@@ -176,7 +251,13 @@ namespace DetourNavigator
             " time=" << std::chrono::duration_cast<FloatMs>(finish - start).count() << "ms" <<
             " total_time=" << std::chrono::duration_cast<FloatMs>(finish - firstStart).count() << "ms";
 
-        return isSuccess(status);
+        if (!isSuccess(status))
+            return JobStatus::failed;
+
+        if ((static_cast<unsigned>(status) & static_cast<unsigned>(UpdateNavMeshStatus::added)) == 0)
+            return JobStatus::skipped;
+
+        return JobStatus::built;
     }
 
     boost::optional<AsyncNavMeshUpdater::Job> AsyncNavMeshUpdater::getNextJob()
@@ -188,7 +269,10 @@ namespace DetourNavigator
 
         while (true)
         {
-            const auto hasJob = [&] { return !mJobs.empty() || !threadQueue.mPushed.empty(); };
+            const auto hasJob = [&]
+            {
+                return !mJobs.empty() || !threadQueue.empty() || findStealableQueue(threadId) != nullptr;
+            };
 
             if (!mHasJob.wait_for(lock, std::chrono::milliseconds(10), hasJob))
             {
@@ -198,11 +282,17 @@ namespace DetourNavigator
             }
 
             Log(Debug::Debug) << "Got " << mJobs.size() << " navigator jobs and "
-                << threadQueue.mJobs.size() << " thread jobs";
+                << threadQueue.size() << " thread jobs";
+
+            NavMeshJobQueue* stealableQueue = nullptr;
+            if (threadQueue.empty() && mJobs.empty())
+                stealableQueue = findStealableQueue(threadId);
 
-            auto job = threadQueue.mJobs.empty()
-                ? getJob(mJobs, mPushed)
-                : getJob(threadQueue.mJobs, threadQueue.mPushed);
+            auto job = stealableQueue != nullptr
+                ? stealableQueue->pop()
+                : threadQueue.empty()
+                    ? mJobs.pop()
+                    : threadQueue.pop();
 
             const auto owner = lockTile(job.mAgentHalfExtents, job.mChangedTile);
 
@@ -213,17 +303,25 @@ namespace DetourNavigator
         }
     }
 
-    AsyncNavMeshUpdater::Job AsyncNavMeshUpdater::getJob(Jobs& jobs, Pushed& pushed)
+    NavMeshJobQueue* AsyncNavMeshUpdater::findStealableQueue(const std::thread::id threadId)
     {
-        auto job = jobs.top();
-        jobs.pop();
-
-        const auto it = pushed.find(job.mAgentHalfExtents);
-        it->second.erase(job.mChangedTile);
-        if (it->second.empty())
-            pushed.erase(it);
+        return DetourNavigator::findStealableQueue(mThreadsQueues, threadId,
+            [&] (const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile)
+            {
+                return isTileLocked(agentHalfExtents, changedTile);
+            });
+    }
 
-        return job;
+    void AsyncNavMeshUpdater::addLatency(const std::chrono::steady_clock::duration& value)
+    {
+        const float latency = std::chrono::duration<float, std::milli>(value).count();
+        const auto locked = mJobsStats.lock();
+        if (locked->mLatencies.size() < sMaxLatencies)
+            locked->mLatencies.push_back(latency);
+        else
+            locked->mLatencies[locked->mNextLatency] = latency;
+        locked->mNextLatency = (locked->mNextLatency + 1) % sMaxLatencies;
+        ++locked->mDone;
     }
 
     void AsyncNavMeshUpdater::writeDebugFiles(const Job& job, const RecastMesh* recastMesh) const
@@ -264,26 +362,20 @@ namespace DetourNavigator
 
         const std::lock_guard<std::mutex> lock(mMutex);
 
-        if (mPushed[job.mAgentHalfExtents].insert(job.mChangedTile).second)
-        {
-            ++job.mTryNumber;
-            mJobs.push(std::move(job));
+        ++job.mTryNumber;
+        if (mJobs.push(std::move(job)))
             mHasJob.notify_all();
-        }
     }
 
-    void AsyncNavMeshUpdater::postThreadJob(Job&& job, Queue& queue)
+    void AsyncNavMeshUpdater::postThreadJob(Job&& job, NavMeshJobQueue& queue)
     {
-        if (queue.mPushed[job.mAgentHalfExtents].insert(job.mChangedTile).second)
-        {
-            queue.mJobs.push(std::move(job));
+        if (queue.push(std::move(job)))
             mHasJob.notify_all();
-        }
     }
 
     std::thread::id AsyncNavMeshUpdater::lockTile(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile)
     {
-        if (mSettings.get().mAsyncNavMeshUpdaterThreads <= 1)
+        if (mThreadsCount <= 1)
             return std::this_thread::get_id();
 
         auto locked = mProcessingTiles.lock();
@@ -309,7 +401,7 @@ namespace DetourNavigator
 
     void AsyncNavMeshUpdater::unlockTile(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile)
     {
-        if (mSettings.get().mAsyncNavMeshUpdaterThreads <= 1)
+        if (mThreadsCount <= 1)
             return;
 
         auto locked = mProcessingTiles.lock();
@@ -327,4 +419,18 @@ namespace DetourNavigator
         if (agent->second.empty())
             locked->erase(agent);
     }
+
+    bool AsyncNavMeshUpdater::isTileLocked(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile)
+    {
+        if (mThreadsCount <= 1)
+            return false;
+
+        const auto locked = mProcessingTiles.lockConst();
+
+        const auto agent = locked->find(agentHalfExtents);
+        if (agent == locked->end())
+            return false;
+
+        return agent->second.count(changedTile) > 0;
+    }
 }
@@ -2,10 +2,12 @@
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_ASYNCNAVMESHUPDATER_H
 
 #include "navmeshcacheitem.hpp"
+#include "navmeshjobqueue.hpp"
 #include "offmeshconnectionsmanager.hpp"
 #include "tilecachedrecastmeshmanager.hpp"
 #include "tileposition.hpp"
 #include "navmeshtilescache.hpp"
+#include "navmeshdb.hpp"
 
 #include <osg/Vec3f>
 
@@ -16,22 +18,13 @@
 #include <condition_variable>
 #include <memory>
 #include <mutex>
-#include <queue>
-#include <set>
+#include <map>
 #include <thread>
 
 class dtNavMesh;
 
 namespace DetourNavigator
 {
-    enum class ChangeType
-    {
-        remove = 0,
-        mixed = 1,
-        add = 2,
-        update = 3,
-    };
-
     class AsyncNavMeshUpdater
     {
     public:
@@ -47,63 +40,56 @@ namespace DetourNavigator
         void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
 
     private:
-        struct Job
+        using Job = NavMeshJob;
+
+        enum class JobStatus
         {
-            osg::Vec3f mAgentHalfExtents;
-            std::weak_ptr<GuardedNavMeshCacheItem> mNavMeshCacheItem;
-            TilePosition mChangedTile;
-            unsigned mTryNumber;
-            ChangeType mChangeType;
-            int mDistanceToPlayer;
-            int mDistanceToOrigin;
-
-            std::tuple<unsigned, ChangeType, int, int> getPriority() const
-            {
-                return std::make_tuple(mTryNumber, mChangeType, mDistanceToPlayer, mDistanceToOrigin);
-            }
-
-            friend inline bool operator <(const Job& lhs, const Job& rhs)
-            {
-                return lhs.getPriority() > rhs.getPriority();
-            }
+            built, // tile is added or replaced
+            skipped, // nothing to build: the nav mesh is gone, the tile is out of range or is only removed
+            failed, // job is reposted
         };
 
-        using Jobs = std::priority_queue<Job, std::deque<Job>>;
-        using Pushed = std::map<osg::Vec3f, std::set<TilePosition>>;
-
-        struct Queue
+        struct JobsStats
         {
-            Jobs mJobs;
-            Pushed mPushed;
-
-            Queue() = default;
+            std::vector<float> mLatencies;
+            std::size_t mNextLatency = 0;
+            std::size_t mDone = 0;
+            std::size_t mCancelled = 0;
+            std::size_t mCoalesced = 0;
         };
 
         std::reference_wrapper<const Settings> mSettings;
         std::reference_wrapper<TileCachedRecastMeshManager> mRecastMeshManager;
         std::reference_wrapper<OffMeshConnectionsManager> mOffMeshConnectionsManager;
+        const std::size_t mThreadsCount;
         std::atomic_bool mShouldStop;
         mutable std::mutex mMutex;
         std::condition_variable mHasJob;
         std::condition_variable mDone;
-        Jobs mJobs;
-        std::map<osg::Vec3f, std::set<TilePosition>> mPushed;
+        NavMeshJobQueue mJobs;
+        TilePosition mJobsPlayerTile;
         Misc::ScopeGuarded<TilePosition> mPlayerTile;
         Misc::ScopeGuarded<boost::optional<std::chrono::steady_clock::time_point>> mFirstStart;
         NavMeshTilesCache mNavMeshTilesCache;
+        std::unique_ptr<NavMeshDb> mNavMeshDb;
         Misc::ScopeGuarded<std::map<osg::Vec3f, std::map<TilePosition, std::thread::id>>> mProcessingTiles;
-        std::map<std::thread::id, Queue> mThreadsQueues;
+        std::map<std::thread::id, NavMeshJobQueue> mThreadsQueues;
+        mutable Misc::ScopeGuarded<JobsStats> mJobsStats;
+        mutable std::chrono::steady_clock::time_point mLastReport;
+        mutable std::size_t mLastReportDone;
         std::vector<std::thread> mThreads;
 
         void process() throw();
 
-        bool processJob(const Job& job);
+        JobStatus processJob(const Job& job);
 
         boost::optional<Job> getNextJob();
 
-        static Job getJob(Jobs& jobs, Pushed& pushed);
+        NavMeshJobQueue* findStealableQueue(const std::thread::id threadId);
 
-        void postThreadJob(Job&& job, Queue& queue);
+        void postThreadJob(Job&& job, NavMeshJobQueue& queue);
+
+        void addLatency(const std::chrono::steady_clock::duration& value);
 
         void writeDebugFiles(const Job& job, const RecastMesh* recastMesh) const;
 
@@ -114,6 +100,8 @@ namespace DetourNavigator
         std::thread::id lockTile(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile);
 
         void unlockTile(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile);
+
+        bool isTileLocked(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile);
     };
 }
 
@@ -0,0 +1,236 @@
+#include "asyncpathfinder.hpp"
+#include "findsmoothpath.hpp"
+#include "settings.hpp"
+#include "settingsutils.hpp"
+
+#include <components/debug/debuglog.hpp>
+
+#include <osg/Stats>
+
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+    // Results of requests of actors that are not processed anymore are never taken
+    const std::chrono::seconds sResultTimeout(10);
+}
+
+namespace DetourNavigator
+{
+    AsyncPathFinder::AsyncPathFinder(const Settings& settings)
+        : mSettings(settings)
+        , mShouldStop(false)
+        , mLastId(0)
+        , mDone(0)
+    {
+        for (std::size_t i = 0; i < mSettings.get().mAsyncPathFinderThreads; ++i)
+            mThreads.emplace_back([&] { process(); });
+    }
+
+    AsyncPathFinder::~AsyncPathFinder()
+    {
+        mShouldStop = true;
+        std::unique_lock<std::mutex> lock(mMutex);
+        mBatches.clear();
+        mHasBatch.notify_all();
+        lock.unlock();
+        for (auto& thread : mThreads)
+            thread.join();
+    }
+
+    PathRequestId AsyncPathFinder::request(const osg::Vec3f& agentHalfExtents, const float stepSize,
+        const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags)
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        const PathRequestId id = ++mLastId;
+        mQueued.emplace(id, Request {id, agentHalfExtents, stepSize, start, end, includeFlags});
+        return id;
+    }
+
+    boost::optional<PathResult> AsyncPathFinder::take(const PathRequestId id)
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+
+        const auto result = mResults.find(id);
+        if (result != mResults.end())
+        {
+            PathResult value = std::move(result->second.mValue);
+            mResults.erase(result);
+            return value;
+        }
+
+        if (mQueued.count(id) || mStarted.count(id))
+            return boost::none;
+
+        return PathResult {Status::PathRequestNotFound, {}};
+    }
+
+    void AsyncPathFinder::cancel(const PathRequestId id)
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        mQueued.erase(id);
+        mStarted.erase(id);
+        mResults.erase(id);
+    }
+
+    void AsyncPathFinder::update(const osg::Vec3f& playerPosition,
+        const std::map<osg::Vec3f, SharedNavMeshCacheItem>& navMeshes)
+    {
+        const auto now = std::chrono::steady_clock::now();
+
+        const std::lock_guard<std::mutex> lock(mMutex);
+
+        for (auto it = mResults.begin(); it != mResults.end();)
+        {
+            if (now - it->second.mDone > sResultTimeout)
+                it = mResults.erase(it);
+            else
+                ++it;
+        }
+
+        if (mQueued.empty())
+            return;
+
+        std::vector<const Request*> closest;
+        closest.reserve(mQueued.size());
+        for (const auto& queued : mQueued)
+            closest.push_back(&queued.second);
+
+        const std::size_t count = std::min(closest.size(), mSettings.get().mMaxPathRequestsPerFrame);
+        std::nth_element(closest.begin(), closest.begin() + count, closest.end(),
+            [&] (const Request* lhs, const Request* rhs)
+            {
+                return (lhs->mStart - playerPosition).length2() < (rhs->mStart - playerPosition).length2();
+            });
+        closest.resize(count);
+
+        std::map<osg::Vec3f, std::vector<Request>> agentsRequests;
+        for (const Request* request : closest)
+        {
+            const PathRequestId id = request->mId;
+            agentsRequests[request->mAgentHalfExtents].push_back(*request);
+            mQueued.erase(id);
+        }
+
+        const std::size_t threads = std::max(std::size_t(1), mThreads.size());
+
+        for (auto& agentRequests : agentsRequests)
+        {
+            auto& requests = agentRequests.second;
+
+            const auto navMesh = navMeshes.find(agentRequests.first);
+            if (navMesh == navMeshes.end())
+            {
+                for (const Request& request : requests)
+                    mResults[request.mId] = Result {PathResult {Status::NavMeshNotFound, {}}, now};
+                continue;
+            }
+
+            const std::size_t batchSize = (requests.size() + threads - 1) / threads;
+            for (std::size_t begin = 0; begin < requests.size(); begin += batchSize)
+            {
+                const std::size_t end = std::min(begin + batchSize, requests.size());
+                Batch batch;
+                batch.mNavMesh = navMesh->second;
+                batch.mRequests.assign(requests.begin() + begin, requests.begin() + end);
+                for (const Request& request : batch.mRequests)
+                    mStarted.insert(request.mId);
+                mBatches.push_back(std::move(batch));
+            }
+        }
+
+        mHasBatch.notify_all();
+    }
+
+    void AsyncPathFinder::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        stats.setAttribute(frameNumber, "NavMesh PathRequests", mQueued.size() + mStarted.size());
+        stats.setAttribute(frameNumber, "NavMesh PathRequestsDone", mDone);
+    }
+
+    void AsyncPathFinder::process() throw()
+    {
+        Log(Debug::Debug) << "Start process path requests";
+        while (!mShouldStop)
+        {
+            try
+            {
+                Batch batch;
+                {
+                    std::unique_lock<std::mutex> lock(mMutex);
+                    mHasBatch.wait(lock, [&] { return mShouldStop || !mBatches.empty(); });
+                    if (mShouldStop)
+                        break;
+                    batch = std::move(mBatches.front());
+                    mBatches.pop_front();
+                }
+                finish(processBatch(batch));
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "AsyncPathFinder::process exception: " << e.what();
+            }
+        }
+        Log(Debug::Debug) << "Stop path requests processing";
+    }
+
+    std::vector<std::pair<PathRequestId, PathResult>> AsyncPathFinder::processBatch(const Batch& batch) const
+    {
+        const Settings& settings = mSettings;
+
+        std::vector<std::pair<PathRequestId, PathResult>> results;
+        results.reserve(batch.mRequests.size());
+
+        const auto navMesh = batch.mNavMesh->lockConst();
+        const dtNavMesh& impl = navMesh->getImpl();
+
+        dtNavMeshQuery navMeshQuery;
+        const bool initialized = initNavMeshQuery(navMeshQuery, impl, settings.mMaxNavMeshQueryNodes);
+
+        for (const Request& request : batch.mRequests)
+        {
+            PathResult result {Status::InitNavMeshQueryFailed, {}};
+
+            if (initialized)
+            {
+                try
+                {
+                    auto out = std::back_inserter(result.mPath);
+                    result.mStatus = findSmoothPath(navMeshQuery, impl,
+                        toNavMeshCoordinates(settings, request.mAgentHalfExtents),
+                        toNavMeshCoordinates(settings, request.mStepSize),
+                        toNavMeshCoordinates(settings, request.mStart), toNavMeshCoordinates(settings, request.mEnd),
+                        request.mIncludeFlags, settings, out);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << "Warning: failed to find path from " << request.mStart
+                        << " to " << request.mEnd << ": " << e.what();
+                    result.mStatus = Status::FindPathOverPolygonsFailed;
+                    result.mPath.clear();
+                }
+            }
+
+            results.emplace_back(request.mId, std::move(result));
+        }
+
+        return results;
+    }
+
+    void AsyncPathFinder::finish(std::vector<std::pair<PathRequestId, PathResult>>&& results)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const std::lock_guard<std::mutex> lock(mMutex);
+        for (auto& result : results)
+        {
+            // skip requests cancelled while they were processed
+            if (mStarted.erase(result.first))
+            {
+                mResults[result.first] = Result {std::move(result.second), now};
+                ++mDone;
+            }
+        }
+    }
+}
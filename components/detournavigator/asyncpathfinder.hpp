@@ -0,0 +1,98 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_ASYNCPATHFINDER_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_ASYNCPATHFINDER_H
+
+#include "flags.hpp"
+#include "navmeshcacheitem.hpp"
+#include "pathrequest.hpp"
+
+#include <osg/Vec3f>
+
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace DetourNavigator
+{
+    struct Settings;
+
+    /// @brief Searches paths requested by AI in background threads.
+    /// @par Requests are queued and each update only the closest to the player ones are started, limited by
+    /// Settings::mMaxPathRequestsPerFrame. Started requests are grouped by agent into batches, each batch is
+    /// processed by a single thread with one nav mesh query under one nav mesh lock.
+    class AsyncPathFinder
+    {
+    public:
+        AsyncPathFinder(const Settings& settings);
+        ~AsyncPathFinder();
+
+        PathRequestId request(const osg::Vec3f& agentHalfExtents, const float stepSize, const osg::Vec3f& start,
+            const osg::Vec3f& end, const Flags includeFlags);
+
+        /// @return result of the done request, empty optional while request is not done or result with
+        /// Status::PathRequestNotFound if there is no such request. Result is given only once.
+        boost::optional<PathResult> take(const PathRequestId id);
+
+        void cancel(const PathRequestId id);
+
+        void update(const osg::Vec3f& playerPosition, const std::map<osg::Vec3f, SharedNavMeshCacheItem>& navMeshes);
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+    private:
+        struct Request
+        {
+            PathRequestId mId;
+            osg::Vec3f mAgentHalfExtents;
+            float mStepSize;
+            osg::Vec3f mStart;
+            osg::Vec3f mEnd;
+            Flags mIncludeFlags;
+        };
+
+        struct Batch
+        {
+            SharedNavMeshCacheItem mNavMesh;
+            std::vector<Request> mRequests;
+        };
+
+        struct Result
+        {
+            PathResult mValue;
+            std::chrono::steady_clock::time_point mDone;
+        };
+
+        std::reference_wrapper<const Settings> mSettings;
+        std::atomic_bool mShouldStop;
+        mutable std::mutex mMutex;
+        std::condition_variable mHasBatch;
+        PathRequestId mLastId;
+        std::map<PathRequestId, Request> mQueued;
+        std::deque<Batch> mBatches;
+        std::set<PathRequestId> mStarted;
+        std::map<PathRequestId, Result> mResults;
+        std::size_t mDone;
+        std::vector<std::thread> mThreads;
+
+        void process() throw();
+
+        std::vector<std::pair<PathRequestId, PathResult>> processBatch(const Batch& batch) const;
+
+        void finish(std::vector<std::pair<PathRequestId, PathResult>>&& results);
+    };
+}
+
+#endif
@@ -267,15 +267,13 @@ namespace DetourNavigator
         return Status::Success;
     }
 
+    /// Same as findSmoothPath below, but uses already initialized navMeshQuery to avoid its allocation
+    /// when many paths are searched over the same navMesh.
     template <class OutputIterator>
-    Status findSmoothPath(const dtNavMesh& navMesh, const osg::Vec3f& halfExtents, const float stepSize,
-            const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags,
+    Status findSmoothPath(dtNavMeshQuery& navMeshQuery, const dtNavMesh& navMesh, const osg::Vec3f& halfExtents,
+            const float stepSize, const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags,
             const Settings& settings, OutputIterator& out)
     {
-        dtNavMeshQuery navMeshQuery;
-        if (!initNavMeshQuery(navMeshQuery, navMesh, settings.mMaxNavMeshQueryNodes))
-            return Status::InitNavMeshQueryFailed;
-
         dtQueryFilter queryFilter;
         queryFilter.setIncludeFlags(includeFlags);
 
@@ -318,6 +316,18 @@ namespace DetourNavigator
         return makeSmoothPath(navMesh, navMeshQuery, queryFilter, start, end, stepSize, std::move(*polygonPath),
             settings.mMaxSmoothPathSize, outTransform);
     }
+
+    template <class OutputIterator>
+    Status findSmoothPath(const dtNavMesh& navMesh, const osg::Vec3f& halfExtents, const float stepSize,
+            const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags,
+            const Settings& settings, OutputIterator& out)
+    {
+        dtNavMeshQuery navMeshQuery;
+        if (!initNavMeshQuery(navMeshQuery, navMesh, settings.mMaxNavMeshQueryNodes))
+            return Status::InitNavMeshQueryFailed;
+
+        return findSmoothPath(navMeshQuery, navMesh, halfExtents, stepSize, start, end, includeFlags, settings, out);
+    }
 }
 
 #endif
@@ -486,7 +486,7 @@ namespace DetourNavigator
     UpdateNavMeshStatus updateNavMesh(const osg::Vec3f& agentHalfExtents, const RecastMesh* recastMesh,
         const TilePosition& changedTile, const TilePosition& playerTile,
         const std::vector<OffMeshConnection>& offMeshConnections, const Settings& settings,
-        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache)
+        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache, NavMeshDb* navMeshDb)
     {
         Log(Debug::Debug) << std::fixed << std::setprecision(2) <<
             "Update NavMesh with multiple tiles:" <<
@@ -535,13 +535,24 @@ namespace DetourNavigator
             const osg::Vec3f tileBorderMin(tileBounds.mMin.x(), recastMeshBounds.mMin.y() - 1, tileBounds.mMin.y());
             const osg::Vec3f tileBorderMax(tileBounds.mMax.x(), recastMeshBounds.mMax.y() + 1, tileBounds.mMax.y());
 
-            auto navMeshData = makeNavMeshTileData(agentHalfExtents, *recastMesh, offMeshConnections, changedTile,
-                tileBorderMin, tileBorderMax, settings);
+            NavMeshData navMeshData;
+            if (navMeshDb)
+                navMeshData = navMeshDb->get(agentHalfExtents, changedTile, *recastMesh, offMeshConnections);
 
             if (!navMeshData.mValue)
             {
-                Log(Debug::Debug) << "Ignore add tile: NavMeshData is null";
-                return navMeshCacheItem->lock()->removeTile(changedTile);
+                navMeshData = makeNavMeshTileData(agentHalfExtents, *recastMesh, offMeshConnections, changedTile,
+                    tileBorderMin, tileBorderMax, settings);
+
+                if (!navMeshData.mValue)
+                {
+                    Log(Debug::Debug) << "Ignore add tile: NavMeshData is null";
+                    return navMeshCacheItem->lock()->removeTile(changedTile);
+                }
+
+                if (navMeshDb)
+                    navMeshDb->put(agentHalfExtents, changedTile, *recastMesh, offMeshConnections,
+                                   navMeshData.mValue.get(), navMeshData.mSize);
             }
 
             try
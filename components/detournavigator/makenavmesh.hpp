@@ -8,6 +8,7 @@
 #include "tilebounds.hpp"
 #include "sharednavmesh.hpp"
 #include "navmeshtilescache.hpp"
+#include "navmeshdb.hpp"
 
 #include <osg/Vec3f>
 
@@ -41,7 +42,7 @@ namespace DetourNavigator
     UpdateNavMeshStatus updateNavMesh(const osg::Vec3f& agentHalfExtents, const RecastMesh* recastMesh,
         const TilePosition& changedTile, const TilePosition& playerTile,
         const std::vector<OffMeshConnection>& offMeshConnections, const Settings& settings,
-        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache);
+        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache, NavMeshDb* navMeshDb);
 }
 
 #endif
@@ -6,6 +6,7 @@
 #include "settings.hpp"
 #include "objectid.hpp"
 #include "navmeshcacheitem.hpp"
+#include "pathrequest.hpp"
 #include "recastmesh.hpp"
 #include "recastmeshtiles.hpp"
 
@@ -180,6 +181,35 @@ namespace DetourNavigator
                 toNavMeshCoordinates(settings, end), includeFlags, settings, out);
         }
 
+        /**
+         * @brief requestPath queues search of the same path as findPath does to be done by background threads.
+         * @return id to get the result by takePath or 0 if paths are not searched in background, then findPath should
+         * be used.
+         */
+        virtual PathRequestId requestPath(const osg::Vec3f& agentHalfExtents, const float stepSize,
+            const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags) = 0;
+
+        /**
+         * @brief takePath returns result of requested path search once it is done. Result is given only once.
+         * @param id is returned by requestPath.
+         * @return empty optional while search is not done and result with Status::PathRequestNotFound if there is no
+         * request with given id, e.g. it's cancelled or result is already taken.
+         */
+        virtual boost::optional<PathResult> takePath(const PathRequestId id) = 0;
+
+        /**
+         * @brief cancelPath drops requested path search and its result.
+         * @param id is returned by requestPath.
+         */
+        virtual void cancelPath(const PathRequestId id) = 0;
+
+        /**
+         * @brief updatePathRequests starts search for requested paths of agents closest to the player, not more than
+         * Settings::mMaxPathRequestsPerFrame at once. Should be called each frame.
+         * @param playerPosition is used to order requests.
+         */
+        virtual void updatePathRequests(const osg::Vec3f& playerPosition) = 0;
+
         /**
          * @brief getNavMesh returns navmesh for specific agent half extents
          * @return navmesh
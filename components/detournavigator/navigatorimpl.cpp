@@ -10,6 +10,8 @@ namespace DetourNavigator
         : mSettings(settings)
         , mNavMeshManager(mSettings)
     {
+        if (mSettings.mAsyncPathFinderThreads > 0)
+            mAsyncPathFinder.reset(new AsyncPathFinder(mSettings));
     }
 
     void NavigatorImpl::addAgent(const osg::Vec3f& agentHalfExtents)
@@ -123,6 +125,33 @@ namespace DetourNavigator
         mNavMeshManager.wait();
     }
 
+    PathRequestId NavigatorImpl::requestPath(const osg::Vec3f& agentHalfExtents, const float stepSize,
+        const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags)
+    {
+        if (!mAsyncPathFinder)
+            return 0;
+        return mAsyncPathFinder->request(agentHalfExtents, stepSize, start, end, includeFlags);
+    }
+
+    boost::optional<PathResult> NavigatorImpl::takePath(const PathRequestId id)
+    {
+        if (!mAsyncPathFinder)
+            return PathResult {Status::PathRequestNotFound, {}};
+        return mAsyncPathFinder->take(id);
+    }
+
+    void NavigatorImpl::cancelPath(const PathRequestId id)
+    {
+        if (mAsyncPathFinder)
+            mAsyncPathFinder->cancel(id);
+    }
+
+    void NavigatorImpl::updatePathRequests(const osg::Vec3f& playerPosition)
+    {
+        if (mAsyncPathFinder)
+            mAsyncPathFinder->update(playerPosition, mNavMeshManager.getNavMeshes());
+    }
+
     SharedNavMeshCacheItem NavigatorImpl::getNavMesh(const osg::Vec3f& agentHalfExtents) const
     {
         return mNavMeshManager.getNavMesh(agentHalfExtents);
@@ -141,6 +170,9 @@ namespace DetourNavigator
     void NavigatorImpl::reportStats(unsigned int frameNumber, osg::Stats& stats) const
     {
         mNavMeshManager.reportStats(frameNumber, stats);
+
+        if (mAsyncPathFinder)
+            mAsyncPathFinder->reportStats(frameNumber, stats);
     }
 
     RecastMeshTiles NavigatorImpl::getRecastMeshTiles()
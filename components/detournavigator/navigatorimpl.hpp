@@ -3,6 +3,9 @@
 
 #include "navigator.hpp"
 #include "navmeshmanager.hpp"
+#include "asyncpathfinder.hpp"
+
+#include <memory>
 
 namespace DetourNavigator
 {
@@ -42,6 +45,15 @@ namespace DetourNavigator
 
         void wait() override;
 
+        PathRequestId requestPath(const osg::Vec3f& agentHalfExtents, const float stepSize, const osg::Vec3f& start,
+            const osg::Vec3f& end, const Flags includeFlags) override;
+
+        boost::optional<PathResult> takePath(const PathRequestId id) override;
+
+        void cancelPath(const PathRequestId id) override;
+
+        void updatePathRequests(const osg::Vec3f& playerPosition) override;
+
         SharedNavMeshCacheItem getNavMesh(const osg::Vec3f& agentHalfExtents) const override;
 
         std::map<osg::Vec3f, SharedNavMeshCacheItem> getNavMeshes() const override;
@@ -55,6 +67,7 @@ namespace DetourNavigator
     private:
         Settings mSettings;
         NavMeshManager mNavMeshManager;
+        std::unique_ptr<AsyncPathFinder> mAsyncPathFinder;
         std::map<osg::Vec3f, std::size_t> mAgents;
         std::unordered_map<ObjectId, ObjectId> mAvoidIds;
         std::unordered_map<ObjectId, ObjectId> mWaterIds;
@@ -64,6 +64,21 @@ namespace DetourNavigator
 
         void wait() override {}
 
+        PathRequestId requestPath(const osg::Vec3f& /*agentHalfExtents*/, const float /*stepSize*/,
+            const osg::Vec3f& /*start*/, const osg::Vec3f& /*end*/, const Flags /*includeFlags*/) override
+        {
+            return 0;
+        }
+
+        boost::optional<PathResult> takePath(const PathRequestId /*id*/) override
+        {
+            return PathResult {Status::PathRequestNotFound, {}};
+        }
+
+        void cancelPath(const PathRequestId /*id*/) override {}
+
+        void updatePathRequests(const osg::Vec3f& /*playerPosition*/) override {}
+
         SharedNavMeshCacheItem getNavMesh(const osg::Vec3f& /*agentHalfExtents*/) const override
         {
             return mEmptyNavMeshCacheItem;
@@ -0,0 +1,239 @@
+#include "navmeshdb.hpp"
+#include "recastmesh.hpp"
+#include "settings.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/misc/binaryio.hpp>
+#include <components/misc/hash.hpp>
+
+#include <DetourAlloc.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <osg/Stats>
+
+#include <array>
+
+namespace
+{
+    using DetourNavigator::RecastMesh;
+
+    // Increase when the file layout or the nav mesh tile format changes
+    const std::uint32_t sVersion = 1;
+    const Misc::FileMagic sMagic {{'O', 'M', 'W', 'N', 'A', 'V', 'D', 'B'}};
+
+    const std::uint64_t sHeaderSize = Misc::sFileHeaderSize + sizeof(std::uint64_t);
+    const std::uint64_t sRecordHeaderSize = 3 * sizeof(float) + 2 * sizeof(std::int32_t) + 2 * sizeof(std::uint64_t)
+        + sizeof(std::uint32_t);
+
+    std::uint64_t makeSettingsHash(const DetourNavigator::Settings& settings)
+    {
+        Misc::Hash hash;
+        hash.add(settings.mCellHeight);
+        hash.add(settings.mCellSize);
+        hash.add(settings.mDetailSampleDist);
+        hash.add(settings.mDetailSampleMaxError);
+        hash.add(settings.mMaxClimb);
+        hash.add(settings.mMaxSimplificationError);
+        hash.add(settings.mMaxSlope);
+        hash.add(settings.mRecastScaleFactor);
+        hash.add(settings.mSwimHeightScale);
+        hash.add(settings.mBorderSize);
+        hash.add(settings.mMaxEdgeLen);
+        hash.add(settings.mMaxPolys);
+        hash.add(settings.mMaxVertsPerPoly);
+        hash.add(settings.mRegionMergeSize);
+        hash.add(settings.mRegionMinSize);
+        hash.add(settings.mTileSize);
+        return hash.getValue();
+    }
+}
+
+namespace DetourNavigator
+{
+    NavMeshDb::NavMeshDb(const Settings& settings)
+        : mPath(settings.mNavMeshDbPath)
+        , mSettingsHash(makeSettingsHash(settings))
+        , mMaxFileSize(settings.mMaxNavMeshDbFileSize)
+        , mFileSize(0)
+        , mHits(0)
+        , mMisses(0)
+    {
+        open();
+    }
+
+    NavMeshData NavMeshDb::get(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+        const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections)
+    {
+        const Key key = makeKey(agentHalfExtents, changedTile, recastMesh, offMeshConnections);
+
+        const std::lock_guard<std::mutex> lock(mMutex);
+
+        const auto tile = mTiles.find(key);
+        if (tile == mTiles.end())
+        {
+            ++mMisses;
+            return NavMeshData();
+        }
+
+        NavMeshData result(static_cast<unsigned char*>(dtAlloc(tile->second.mSize, DT_ALLOC_PERM)),
+                           static_cast<int>(tile->second.mSize));
+        mFile.seekg(static_cast<std::streamoff>(tile->second.mOffset));
+        if (!result.mValue || !mFile.read(reinterpret_cast<char*>(result.mValue.get()), tile->second.mSize))
+        {
+            Log(Debug::Warning) << "Warning: failed to read nav mesh tile from \"" << mPath << "\"";
+            mFile.clear();
+            mTiles.erase(tile);
+            ++mMisses;
+            return NavMeshData();
+        }
+
+        ++mHits;
+        return result;
+    }
+
+    void NavMeshDb::put(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+        const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections,
+        const unsigned char* data, int size)
+    {
+        const Key key = makeKey(agentHalfExtents, changedTile, recastMesh, offMeshConnections);
+        const std::uint64_t recordSize = sRecordHeaderSize + static_cast<std::uint64_t>(size);
+
+        const std::lock_guard<std::mutex> lock(mMutex);
+
+        if (!mFile.is_open() || mTiles.count(key) || mFileSize + recordSize > mMaxFileSize)
+            return;
+
+        mFile.seekp(static_cast<std::streamoff>(mFileSize));
+        Misc::writeBinary(mFile, key.mAgentHalfExtents.x());
+        Misc::writeBinary(mFile, key.mAgentHalfExtents.y());
+        Misc::writeBinary(mFile, key.mAgentHalfExtents.z());
+        Misc::writeBinary(mFile, static_cast<std::int32_t>(key.mTilePosition.x()));
+        Misc::writeBinary(mFile, static_cast<std::int32_t>(key.mTilePosition.y()));
+        Misc::writeBinary(mFile, key.mInputHash);
+        Misc::writeBinary(mFile, key.mInputSize);
+        Misc::writeBinary(mFile, static_cast<std::uint32_t>(size));
+        mFile.write(reinterpret_cast<const char*>(data), size);
+        mFile.flush();
+
+        if (!mFile)
+        {
+            Log(Debug::Warning) << "Warning: failed to write nav mesh tile to \"" << mPath << "\", disabling it";
+            mFile.close();
+            mTiles.clear();
+            return;
+        }
+
+        mTiles[key] = Location {mFileSize + sRecordHeaderSize, static_cast<std::uint32_t>(size)};
+        mFileSize += recordSize;
+    }
+
+    std::size_t NavMeshDb::getTilesCount() const
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        return mTiles.size();
+    }
+
+    void NavMeshDb::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "NavMesh DiskTiles", getTilesCount());
+        stats.setAttribute(frameNumber, "NavMesh DiskHits", mHits);
+        stats.setAttribute(frameNumber, "NavMesh DiskMisses", mMisses);
+    }
+
+    void NavMeshDb::open()
+    {
+        mFile.open(mPath, std::ios::in | std::ios::out | std::ios::binary);
+        if (!mFile.is_open())
+        {
+            reset();
+            return;
+        }
+
+        std::uint32_t version = 0;
+        std::uint64_t settingsHash = 0;
+        if (!Misc::readFileHeader(mFile, sMagic, version) || version != sVersion
+                || !Misc::readBinary(mFile, settingsHash) || settingsHash != mSettingsHash)
+        {
+            Log(Debug::Info) << "Nav mesh tiles in \"" << mPath << "\" are outdated, discarding them";
+            reset();
+            return;
+        }
+
+        const std::uint64_t fileSize = boost::filesystem::file_size(mPath);
+        std::uint64_t offset = sHeaderSize;
+        while (true)
+        {
+            Key key;
+            std::int32_t tileX = 0;
+            std::int32_t tileY = 0;
+            std::uint32_t size = 0;
+            if (!Misc::readBinary(mFile, key.mAgentHalfExtents.x())
+                    || !Misc::readBinary(mFile, key.mAgentHalfExtents.y())
+                    || !Misc::readBinary(mFile, key.mAgentHalfExtents.z())
+                    || !Misc::readBinary(mFile, tileX) || !Misc::readBinary(mFile, tileY)
+                    || !Misc::readBinary(mFile, key.mInputHash) || !Misc::readBinary(mFile, key.mInputSize)
+                    || !Misc::readBinary(mFile, size))
+                break;
+
+            const std::uint64_t end = offset + sRecordHeaderSize + size;
+            if (end > fileSize)
+                break;
+
+            key.mTilePosition = TilePosition(tileX, tileY);
+            mTiles[key] = Location {offset + sRecordHeaderSize, size};
+            offset = end;
+            mFile.seekg(static_cast<std::streamoff>(offset));
+        }
+
+        mFile.close();
+
+        // drop a record that was not completely written, so new ones are appended right after the last complete one
+        if (offset != fileSize)
+            boost::filesystem::resize_file(mPath, offset);
+
+        mFile.open(mPath, std::ios::in | std::ios::out | std::ios::binary);
+        mFileSize = offset;
+
+        Log(Debug::Verbose) << "Loaded " << mTiles.size() << " nav mesh tiles from \"" << mPath << "\"";
+    }
+
+    void NavMeshDb::reset()
+    {
+        mTiles.clear();
+        mFile.close();
+        mFile.clear();
+        mFile.open(mPath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!mFile.is_open())
+        {
+            Log(Debug::Warning) << "Warning: failed to open \"" << mPath << "\" to store nav mesh tiles";
+            return;
+        }
+
+        Misc::writeFileHeader(mFile, sMagic, sVersion);
+        Misc::writeBinary(mFile, mSettingsHash);
+        mFile.flush();
+        mFileSize = sHeaderSize;
+    }
+
+    NavMeshDb::Key NavMeshDb::makeKey(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+        const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections)
+    {
+        Misc::Hash hash;
+        hash.add(recastMesh.getIndices());
+        hash.add(recastMesh.getVertices());
+        hash.add(recastMesh.getAreaTypes());
+        hash.add(static_cast<std::uint64_t>(recastMesh.getWater().size()));
+        for (const auto& water : recastMesh.getWater())
+        {
+            // hash the values instead of the struct to skip its padding
+            std::array<btScalar, 16> transform;
+            water.mTransform.getOpenGLMatrix(transform.data());
+            hash.add(water.mCellSize);
+            hash.add(transform);
+        }
+        hash.add(offMeshConnections);
+
+        return Key {agentHalfExtents, changedTile, hash.getValue(), hash.getSize()};
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDB_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDB_H
+
+#include "navmeshdata.hpp"
+#include "offmeshconnection.hpp"
+#include "tileposition.hpp"
+
+#include <osg/Vec3f>
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace DetourNavigator
+{
+    class RecastMesh;
+    struct Settings;
+
+    /// @brief Persistent store of generated nav mesh tiles, so they don't have to be generated again in the next session.
+    /// @par Tiles are stored in a local file, keyed by agent half extents, tile position and a hash of the recast mesh
+    /// and off mesh connections they were generated from. Files written by another format version or with different
+    /// nav mesh generation settings are discarded on open.
+    /// @note Thread safe.
+    class NavMeshDb
+    {
+    public:
+        /// Open or create the file at Settings::mNavMeshDbPath.
+        NavMeshDb(const Settings& settings);
+
+        /// @return tile stored for these inputs, or empty data if there is none.
+        NavMeshData get(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections);
+
+        /// Store a tile, unless the file would grow beyond Settings::mMaxNavMeshDbFileSize.
+        void put(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections,
+            const unsigned char* data, int size);
+
+        std::size_t getTilesCount() const;
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+    private:
+        struct Key
+        {
+            osg::Vec3f mAgentHalfExtents;
+            TilePosition mTilePosition;
+            std::uint64_t mInputHash;
+            std::uint64_t mInputSize;
+
+            friend bool operator <(const Key& lhs, const Key& rhs)
+            {
+                return std::tie(lhs.mAgentHalfExtents, lhs.mTilePosition, lhs.mInputHash, lhs.mInputSize)
+                    < std::tie(rhs.mAgentHalfExtents, rhs.mTilePosition, rhs.mInputHash, rhs.mInputSize);
+            }
+        };
+
+        struct Location
+        {
+            std::uint64_t mOffset;
+            std::uint32_t mSize;
+        };
+
+        const std::string mPath;
+        const std::uint64_t mSettingsHash;
+        const std::uint64_t mMaxFileSize;
+        mutable std::mutex mMutex;
+        std::fstream mFile;
+        std::uint64_t mFileSize;
+        std::map<Key, Location> mTiles;
+        std::atomic<std::size_t> mHits;
+        std::atomic<std::size_t> mMisses;
+
+        void open();
+
+        void reset();
+
+        static Key makeKey(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections);
+    };
+}
+
+#endif
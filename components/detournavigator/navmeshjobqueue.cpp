@@ -0,0 +1,73 @@
+#include "navmeshjobqueue.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    using DetourNavigator::ChangeType;
+
+    ChangeType merge(ChangeType lhs, ChangeType rhs)
+    {
+        return lhs == rhs ? lhs : ChangeType::mixed;
+    }
+}
+
+namespace DetourNavigator
+{
+    int getManhattanDistance(const TilePosition& lhs, const TilePosition& rhs)
+    {
+        return std::abs(lhs.x() - rhs.x()) + std::abs(lhs.y() - rhs.y());
+    }
+
+    bool NavMeshJobQueue::push(NavMeshJob&& job)
+    {
+        const auto inserted = mPushed[job.mAgentHalfExtents].emplace(job.mChangedTile, job.mChangeType);
+        if (!inserted.second)
+        {
+            // Coalesce with already queued job for the same tile, it will use current recast mesh anyway
+            inserted.first->second = merge(inserted.first->second, job.mChangeType);
+            return false;
+        }
+        mJobs.push(std::move(job));
+        return true;
+    }
+
+    NavMeshJob NavMeshJobQueue::pop()
+    {
+        auto job = mJobs.top();
+        mJobs.pop();
+
+        const auto it = mPushed.find(job.mAgentHalfExtents);
+        const auto tile = it->second.find(job.mChangedTile);
+        job.mChangeType = tile->second;
+        it->second.erase(tile);
+        if (it->second.empty())
+            mPushed.erase(it);
+
+        return job;
+    }
+
+    void NavMeshJobQueue::clear()
+    {
+        mJobs = decltype(mJobs)();
+        mPushed.clear();
+    }
+
+    void NavMeshJobQueue::updatePriorities(const TilePosition& playerTile)
+    {
+        std::vector<NavMeshJob> jobs;
+        jobs.reserve(mJobs.size());
+        while (!mJobs.empty())
+        {
+            jobs.push_back(mJobs.top());
+            mJobs.pop();
+        }
+
+        for (auto& job : jobs)
+        {
+            job.mDistanceToPlayer = getManhattanDistance(job.mChangedTile, playerTile);
+            mJobs.push(std::move(job));
+        }
+    }
+}
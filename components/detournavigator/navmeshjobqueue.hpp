@@ -0,0 +1,98 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHJOBQUEUE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHJOBQUEUE_H
+
+#include "navmeshcacheitem.hpp"
+#include "tileposition.hpp"
+
+#include <osg/Vec3f>
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <tuple>
+
+namespace DetourNavigator
+{
+    enum class ChangeType
+    {
+        remove = 0,
+        mixed = 1,
+        add = 2,
+        update = 3,
+    };
+
+    struct NavMeshJob
+    {
+        osg::Vec3f mAgentHalfExtents;
+        std::weak_ptr<GuardedNavMeshCacheItem> mNavMeshCacheItem;
+        TilePosition mChangedTile;
+        unsigned mTryNumber;
+        ChangeType mChangeType;
+        int mDistanceToPlayer;
+        int mDistanceToOrigin;
+        std::chrono::steady_clock::time_point mPosted;
+
+        std::tuple<unsigned, ChangeType, int, int> getPriority() const
+        {
+            return std::make_tuple(mTryNumber, mChangeType, mDistanceToPlayer, mDistanceToOrigin);
+        }
+
+        friend inline bool operator <(const NavMeshJob& lhs, const NavMeshJob& rhs)
+        {
+            return lhs.getPriority() > rhs.getPriority();
+        }
+    };
+
+    int getManhattanDistance(const TilePosition& lhs, const TilePosition& rhs);
+
+    /// @brief Jobs of AsyncNavMeshUpdater ordered by priority, at most one per agent and tile.
+    class NavMeshJobQueue
+    {
+    public:
+        /// @return false if a job for the same agent and tile is already queued, then the change type of the queued
+        /// job is merged with the change type of \a job instead.
+        bool push(NavMeshJob&& job);
+
+        /// Remove the job with the highest priority. Must not be called for empty queue.
+        NavMeshJob pop();
+
+        /// Must not be called for empty queue.
+        const NavMeshJob& top() const { return mJobs.top(); }
+
+        bool empty() const { return mJobs.empty(); }
+
+        std::size_t size() const { return mJobs.size(); }
+
+        void clear();
+
+        /// Recalculate the distance of queued jobs to the player.
+        void updatePriorities(const TilePosition& playerTile);
+
+    private:
+        std::priority_queue<NavMeshJob, std::deque<NavMeshJob>> mJobs;
+        std::map<osg::Vec3f, std::map<TilePosition, ChangeType>> mPushed;
+    };
+
+    /// Jobs of other thread queue are waiting for a tile locked by that thread. Once the tile is unlocked they can be
+    /// done by any thread, so an idle thread doesn't wait until the owner is done with other jobs.
+    /// @return a queue of other thread than \a threadId which top job tile is not locked or nullptr.
+    template <class IsTileLocked>
+    NavMeshJobQueue* findStealableQueue(std::map<std::thread::id, NavMeshJobQueue>& queues,
+        const std::thread::id threadId, IsTileLocked&& isTileLocked)
+    {
+        for (auto& queue : queues)
+        {
+            if (queue.first == threadId || queue.second.empty())
+                continue;
+            const auto& job = queue.second.top();
+            if (!isTileLocked(job.mAgentHalfExtents, job.mChangedTile))
+                return &queue.second;
+        }
+        return nullptr;
+    }
+}
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_PATHREQUEST_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_PATHREQUEST_H
+
+#include "status.hpp"
+
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <vector>
+
+namespace DetourNavigator
+{
+    /// Identifies path requested from Navigator::requestPath, 0 is never used for a request.
+    using PathRequestId = std::size_t;
+
+    struct PathResult
+    {
+        Status mStatus;
+        std::vector<osg::Vec3f> mPath;
+    };
+}
+
+#endif
@@ -2,6 +2,8 @@
 
 #include <components/settings/settings.hpp>
 
+#include <algorithm>
+
 namespace DetourNavigator
 {
     boost::optional<Settings> makeSettingsFromSettingsManager()
@@ -30,6 +32,8 @@ namespace DetourNavigator
         navigatorSettings.mRegionMinSize = ::Settings::Manager::getInt("region min size", "Navigator");
         navigatorSettings.mTileSize = ::Settings::Manager::getInt("tile size", "Navigator");
         navigatorSettings.mAsyncNavMeshUpdaterThreads = static_cast<std::size_t>(::Settings::Manager::getInt("async nav mesh updater threads", "Navigator"));
+        navigatorSettings.mAsyncPathFinderThreads = static_cast<std::size_t>(::Settings::Manager::getInt("async path finder threads", "Navigator"));
+        navigatorSettings.mMaxPathRequestsPerFrame = static_cast<std::size_t>(std::max(1, ::Settings::Manager::getInt("max path requests per frame", "Navigator")));
         navigatorSettings.mMaxNavMeshTilesCacheSize = static_cast<std::size_t>(::Settings::Manager::getInt("max nav mesh tiles cache size", "Navigator"));
         navigatorSettings.mMaxPolygonPathSize = static_cast<std::size_t>(::Settings::Manager::getInt("max polygon path size", "Navigator"));
         navigatorSettings.mMaxSmoothPathSize = static_cast<std::size_t>(::Settings::Manager::getInt("max smooth path size", "Navigator"));
@@ -40,6 +44,8 @@ namespace DetourNavigator
         navigatorSettings.mNavMeshPathPrefix = ::Settings::Manager::getString("nav mesh path prefix", "Navigator");
         navigatorSettings.mEnableRecastMeshFileNameRevision = ::Settings::Manager::getBool("enable recast mesh file name revision", "Navigator");
         navigatorSettings.mEnableNavMeshFileNameRevision = ::Settings::Manager::getBool("enable nav mesh file name revision", "Navigator");
+        navigatorSettings.mEnableNavMeshDiskCache = ::Settings::Manager::getBool("enable nav mesh disk cache", "Navigator");
+        navigatorSettings.mMaxNavMeshDbFileSize = static_cast<std::size_t>(::Settings::Manager::getInt("max nav mesh disk cache size", "Navigator"));
 
         return navigatorSettings;
     }
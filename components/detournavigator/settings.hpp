@@ -13,6 +13,7 @@ namespace DetourNavigator
         bool mEnableWriteNavMeshToFile = false;
         bool mEnableRecastMeshFileNameRevision = false;
         bool mEnableNavMeshFileNameRevision = false;
+        bool mEnableNavMeshDiskCache = false;
         float mCellHeight = 0;
         float mCellSize = 0;
         float mDetailSampleDist = 0;
@@ -33,11 +34,15 @@ namespace DetourNavigator
         int mTileSize = 0;
         std::size_t mAsyncNavMeshUpdaterThreads = 0;
         std::size_t mMaxNavMeshTilesCacheSize = 0;
+        std::size_t mMaxNavMeshDbFileSize = 0;
+        std::size_t mAsyncPathFinderThreads = 0;
+        std::size_t mMaxPathRequestsPerFrame = 0;
         std::size_t mMaxPolygonPathSize = 0;
         std::size_t mMaxSmoothPathSize = 0;
         std::size_t mTrianglesPerChunk = 0;
         std::string mRecastMeshPathPrefix;
         std::string mNavMeshPathPrefix;
+        std::string mNavMeshDbPath;
     };
 
     boost::optional<Settings> makeSettingsFromSettingsManager();
@@ -13,6 +13,7 @@ namespace DetourNavigator
         FindPathOverPolygonsFailed,
         GetPolyHeightFailed,
         InitNavMeshQueryFailed,
+        PathRequestNotFound,
     };
 
     constexpr const char* getMessage(Status value)
@@ -35,6 +36,8 @@ namespace DetourNavigator
                 return "failed to get polygon height";
             case Status::InitNavMeshQueryFailed:
                 return "failed to init navmesh query";
+            case Status::PathRequestNotFound:
+                return "path request is not found";
         }
         return "unknown error";
     }
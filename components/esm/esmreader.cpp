@@ -1,7 +1,30 @@
 #include "esmreader.hpp"
+#include "savedgamestream.hpp"
 
 #include <stdexcept>
 
+namespace
+{
+    Files::IStreamPtr openContentFile(const std::string& filename)
+    {
+        // Content files are read in many small pieces, reading them through a memory mapping
+        // avoids a seek and read system call for every refill of the stream buffer.
+        Files::IStreamPtr stream;
+        try
+        {
+            stream = Files::openConstrainedFileStream(std::make_shared<const Files::MappedFile>(filename));
+        }
+        catch (const std::exception&)
+        {
+            // e.g. empty file or not enough address space, read the file the usual way
+            stream = Files::openConstrainedFileStream(filename.c_str());
+        }
+
+        // Saved games may be compressed
+        return ESM::openSavedGameStream(stream);
+    }
+}
+
 namespace ESM
 {
 
@@ -78,7 +101,15 @@ void ESMReader::openRaw(Files::IStreamPtr _esm, const std::string& name)
 
 void ESMReader::openRaw(const std::string& filename)
 {
-    openRaw(Files::openConstrainedFileStream(filename.c_str()), filename);
+    openRaw(openContentFile(filename), filename);
+}
+
+void ESMReader::openCopy(const ESMReader &reader, const std::string &filename)
+{
+    openRaw(filename);
+    mHeader = reader.mHeader;
+    setIndex(reader.mIdx);
+    mGlobalReaderList = reader.mGlobalReaderList;
 }
 
 void ESMReader::open(Files::IStreamPtr _esm, const std::string &name)
@@ -95,7 +126,7 @@ void ESMReader::open(Files::IStreamPtr _esm, const std::string &name)
 
 void ESMReader::open(const std::string &file)
 {
-    open (Files::openConstrainedFileStream (file.c_str ()), file);
+    open (openContentFile(file), file);
 }
 
 int64_t ESMReader::getHNLong(const char *name)
@@ -72,6 +72,11 @@ public:
 
   void openRaw(const std::string &filename);
 
+  /// Open \a filename, which \a reader has open as well, with a stream of its own, e.g. to read it on another thread.
+  /// The header of \a reader is taken over instead of being parsed again, including the indices of the parent files,
+  /// and so is the index. The encoder is not, as it may not be shared between threads.
+  void openCopy(const ESMReader &reader, const std::string &filename);
+
   /// Get the current position in the file. Make sure that the file has been opened!
   size_t getFileOffset();
 
@@ -262,6 +267,8 @@ public:
   /// Sets font encoder for ESM strings
   void setEncoder(ToUTF8::Utf8Encoder* encoder);
 
+  ToUTF8::Utf8Encoder* getEncoder() const { return mEncoder; }
+
   /// Get record flags of last record
   unsigned int getRecordFlags() { return mRecordFlags; }
 
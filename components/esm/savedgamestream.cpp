@@ -0,0 +1,222 @@
+#include "savedgamestream.hpp"
+
+#include <components/misc/binaryio.hpp>
+
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_streambuf.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <vector>
+
+namespace
+{
+    // Increase when the layout of the header or of the compressed data changes
+    const std::uint32_t sVersion = 1;
+    const Misc::FileMagic sMagic {{'O', 'M', 'W', 'S', 'A', 'V', 'E', 'Z'}};
+
+    const std::streamoff sHeaderSize = Misc::sFileHeaderSize;
+    const std::streamoff sTrailerSize = sizeof(std::uint64_t);
+
+    /// Passes the compressed data on to a SavedGameCompressor::Sink
+    class SinkDevice
+    {
+    public:
+        typedef char char_type;
+        typedef boost::iostreams::sink_tag category;
+
+        explicit SinkDevice(const ESM::SavedGameCompressor::Sink& sink) : mSink(&sink) {}
+
+        std::streamsize write(const char* data, std::streamsize size)
+        {
+            (*mSink)(data, static_cast<std::size_t>(size));
+            return size;
+        }
+
+    private:
+        const ESM::SavedGameCompressor::Sink* mSink;
+    };
+
+    /// Decompresses the ESM data of a compressed saved game while it is read. Seeking just moves the read position,
+    /// the data in between is decompressed and dropped on the next read.
+    class DecompressingStreamBuf : public std::streambuf
+    {
+    public:
+        DecompressingStreamBuf(Files::IStreamPtr source, std::uint64_t size)
+            : mSource(std::move(source))
+            , mSize(size)
+            , mBuffer(64 * 1024)
+            , mBufferPos(0)
+            , mDecompressedPos(0)
+        {
+            restart();
+            setg(mBuffer.data(), mBuffer.data(), mBuffer.data());
+        }
+
+    protected:
+        virtual int_type underflow()
+        {
+            if (gptr() < egptr())
+                return traits_type::to_int_type(*gptr());
+
+            const std::uint64_t pos = getPos();
+            if (pos < mDecompressedPos)
+                restart();
+
+            while (mDecompressedPos < pos)
+            {
+                const std::streamsize size = static_cast<std::streamsize>(
+                    std::min<std::uint64_t>(mBuffer.size(), pos - mDecompressedPos));
+                const std::streamsize read = mInput->sgetn(mBuffer.data(), size);
+                if (read <= 0)
+                    return setEnd(pos);
+                mDecompressedPos += static_cast<std::uint64_t>(read);
+            }
+
+            const std::streamsize read = mInput->sgetn(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+            if (read <= 0)
+                return setEnd(pos);
+
+            mBufferPos = pos;
+            mDecompressedPos += static_cast<std::uint64_t>(read);
+            setg(mBuffer.data(), mBuffer.data(), mBuffer.data() + read);
+            return traits_type::to_int_type(*gptr());
+        }
+
+        virtual pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode mode)
+        {
+            switch (dir)
+            {
+                case std::ios_base::beg:
+                    return seekpos(pos_type(offset), mode);
+                case std::ios_base::cur:
+                    return seekpos(pos_type(static_cast<off_type>(getPos()) + offset), mode);
+                case std::ios_base::end:
+                    return seekpos(pos_type(static_cast<off_type>(mSize) + offset), mode);
+                default:
+                    return pos_type(off_type(-1));
+            }
+        }
+
+        virtual pos_type seekpos(pos_type pos, std::ios_base::openmode mode)
+        {
+            const off_type offset = pos;
+            if (!(mode & std::ios_base::in) || offset < 0 || static_cast<std::uint64_t>(offset) > mSize)
+                return pos_type(off_type(-1));
+
+            const std::uint64_t target = static_cast<std::uint64_t>(offset);
+            if (target >= mBufferPos && target <= mBufferPos + static_cast<std::uint64_t>(egptr() - eback()))
+                setg(eback(), eback() + (target - mBufferPos), egptr());
+            else
+                setEnd(target);
+            return pos;
+        }
+
+    private:
+        Files::IStreamPtr mSource;
+        const std::uint64_t mSize;
+        std::unique_ptr<boost::iostreams::filtering_istreambuf> mInput;
+        std::vector<char> mBuffer;
+        /// Position of eback() in the decompressed data
+        std::uint64_t mBufferPos;
+        /// Position of the next byte mInput returns
+        std::uint64_t mDecompressedPos;
+
+        std::uint64_t getPos() const
+        {
+            return mBufferPos + static_cast<std::uint64_t>(gptr() - eback());
+        }
+
+        int_type setEnd(std::uint64_t pos)
+        {
+            mBufferPos = pos;
+            setg(mBuffer.data(), mBuffer.data(), mBuffer.data());
+            return traits_type::eof();
+        }
+
+        void restart()
+        {
+            // A filtering_streambuf keeps pointers into its old buffers when its chain is reset, so start over with a new one
+            mInput.reset();
+            mSource->clear();
+            mSource->seekg(sHeaderSize);
+            mInput.reset(new boost::iostreams::filtering_istreambuf);
+            mInput->push(boost::iostreams::zlib_decompressor());
+            mInput->push(*mSource);
+            mDecompressedPos = 0;
+        }
+    };
+}
+
+namespace ESM
+{
+    struct SavedGameCompressor::Impl
+    {
+        Sink mSink;
+        boost::iostreams::filtering_ostreambuf mOutput;
+        std::uint64_t mSize = 0;
+    };
+
+    SavedGameCompressor::SavedGameCompressor(Sink sink)
+        : mImpl(new Impl)
+    {
+        mImpl->mSink = std::move(sink);
+
+        std::ostringstream stream;
+        Misc::writeFileHeader(stream, sMagic, sVersion);
+        const std::string header = stream.str();
+        mImpl->mSink(header.data(), header.size());
+
+        // Saves are mostly small records that compress well even at the fastest level
+        mImpl->mOutput.push(boost::iostreams::zlib_compressor(boost::iostreams::zlib::best_speed));
+        mImpl->mOutput.push(SinkDevice(mImpl->mSink));
+    }
+
+    SavedGameCompressor::~SavedGameCompressor()
+    {
+    }
+
+    void SavedGameCompressor::write(const char* data, std::size_t size)
+    {
+        if (mImpl->mOutput.sputn(data, static_cast<std::streamsize>(size)) != static_cast<std::streamsize>(size))
+            throw std::runtime_error("Failed to compress saved game");
+        mImpl->mSize += size;
+    }
+
+    void SavedGameCompressor::finish()
+    {
+        // Closing the chain writes the end of the zlib stream
+        mImpl->mOutput.reset();
+        mImpl->mSink(reinterpret_cast<const char*>(&mImpl->mSize), sizeof(mImpl->mSize));
+    }
+
+    Files::IStreamPtr openSavedGameStream(Files::IStreamPtr stream)
+    {
+        std::uint32_t version = 0;
+        if (!Misc::readFileHeader(*stream, sMagic, version))
+        {
+            stream->clear();
+            stream->seekg(0);
+            return stream;
+        }
+
+        if (version == 0)
+            throw std::runtime_error("Truncated compressed saved game header");
+        if (version > sVersion)
+            throw std::runtime_error("Compressed saved game was written by a newer version (format "
+                + std::to_string(version) + ")");
+
+        // The zlib stream ends by itself, so the size behind it is never passed to the decompressor
+        std::uint64_t size = 0;
+        if (!stream->seekg(0, std::ios::end) || stream->tellg() < sHeaderSize + sTrailerSize)
+            throw std::runtime_error("Truncated compressed saved game");
+        stream->seekg(-sTrailerSize, std::ios::end);
+        if (!Misc::readBinary(*stream, size))
+            throw std::runtime_error("Truncated compressed saved game");
+
+        std::unique_ptr<std::streambuf> buf(new DecompressingStreamBuf(std::move(stream), size));
+        return Files::IStreamPtr(new Files::ConstrainedFileStream(std::move(buf)));
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef OPENMW_ESM_SAVEDGAMESTREAM_H
+#define OPENMW_ESM_SAVEDGAMESTREAM_H
+
+#include <components/files/constrainedfilestream.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace ESM
+{
+    /// @brief Writes ESM data in the compressed saved game format.
+    /// @par A compressed saved game starts with a header of its own, followed by the zlib stream of the ESM data and the
+    /// size of the uncompressed data. Files without this header are plain ESM files, which is how older versions wrote
+    /// saved games.
+    /// @par The data is compressed as it is passed in, and the compressed pieces are passed on to the sink right away,
+    /// so the size of the data doesn't need to be known in advance.
+    class SavedGameCompressor
+    {
+    public:
+        typedef std::function<void (const char* data, std::size_t size)> Sink;
+
+        /// Writes the header to \a sink.
+        explicit SavedGameCompressor(Sink sink);
+        ~SavedGameCompressor();
+
+        void write(const char* data, std::size_t size);
+
+        /// Flush the rest of the compressed data and the size of all data written to the sink.
+        void finish();
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> mImpl;
+    };
+
+    /// @return the stream of the ESM data, decompressed while it is read, if \a stream holds a compressed saved game,
+    /// or \a stream itself otherwise.
+    /// @note \a stream must be seekable. Seeking backwards in a compressed saved game decompresses it again from the start.
+    Files::IStreamPtr openSavedGameStream(Files::IStreamPtr stream);
+}
+
+#endif
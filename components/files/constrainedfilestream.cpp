@@ -2,13 +2,29 @@
 
 #include <streambuf>
 #include <algorithm>
+#include <stdexcept>
+
+#include <boost/iostreams/device/mapped_file.hpp>
 
 #include "lowlevelfile.hpp"
+#include "memorystream.hpp"
 
 namespace
 {
 // somewhat arbitrary though 64KB buffers didn't seem to improve performance any
 const size_t sBufferSize = 8192;
+
+size_t getRegionSize(const Files::MappedFile &file, size_t start, size_t length)
+{
+    if (start > file.size())
+        throw std::runtime_error("Stream start is outside of the mapped file");
+
+    size_t size = length != 0xFFFFFFFF ? length : file.size() - start;
+    if (size > file.size() - start)
+        throw std::runtime_error("Stream end is outside of the mapped file");
+
+    return size;
+}
 }
 
 namespace Files
@@ -103,6 +119,44 @@ namespace Files
 
     };
 
+    class MappedFileStreamBuf : public MemBuf
+    {
+        MappedFilePtr mFile;
+
+    public:
+        // getRegionSize throws for a region outside of the mapping before MemBuf is constructed
+        MappedFileStreamBuf(const MappedFilePtr &file, size_t start, size_t length)
+            : MemBuf(file->data() + std::min(start, file->size()), getRegionSize(*file, start, length))
+            , mFile(file)
+        {
+        }
+    };
+
+    struct MappedFile::Impl
+    {
+        boost::iostreams::mapped_file_source mSource;
+    };
+
+    MappedFile::MappedFile(const std::string &filename)
+        : mImpl(new Impl)
+    {
+        mImpl->mSource.open(filename);
+    }
+
+    MappedFile::~MappedFile()
+    {
+    }
+
+    const char *MappedFile::data() const
+    {
+        return mImpl->mSource.data();
+    }
+
+    size_t MappedFile::size() const
+    {
+        return mImpl->mSource.size();
+    }
+
     ConstrainedFileStream::ConstrainedFileStream(std::unique_ptr<std::streambuf> buf)
         : std::istream(buf.get())
         , mBuf(std::move(buf))
@@ -115,4 +169,10 @@ namespace Files
         auto buf = std::unique_ptr<std::streambuf>(new ConstrainedFileStreamBuf(filename, start, length));
         return IStreamPtr(new ConstrainedFileStream(std::move(buf)));
     }
+
+    IStreamPtr openConstrainedFileStream(const MappedFilePtr &file, size_t start, size_t length)
+    {
+        auto buf = std::unique_ptr<std::streambuf>(new MappedFileStreamBuf(file, start, length));
+        return IStreamPtr(new ConstrainedFileStream(std::move(buf)));
+    }
 }
@@ -3,6 +3,7 @@
 
 #include <istream>
 #include <memory>
+#include <string>
 
 namespace Files
 {
@@ -20,8 +21,31 @@ private:
 
 typedef std::shared_ptr<std::istream> IStreamPtr;
 
+/// A read-only memory mapping of a whole file. Any number of streams (and threads) can read from
+/// the same mapping, it stays alive for as long as there is a stream referencing it.
+class MappedFile
+{
+public:
+    /// @note Throws an exception if the file can not be mapped.
+    MappedFile(const std::string &filename);
+    ~MappedFile();
+
+    const char *data() const;
+    size_t size() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> mImpl;
+};
+
+typedef std::shared_ptr<const MappedFile> MappedFilePtr;
+
 IStreamPtr openConstrainedFileStream(const char *filename, size_t start=0, size_t length=0xFFFFFFFF);
 
+/// Open a stream over a region of a mapped file. The get area points directly into the mapping,
+/// so reading does neither copy into an intermediate buffer nor issue any system calls.
+IStreamPtr openConstrainedFileStream(const MappedFilePtr &file, size_t start=0, size_t length=0xFFFFFFFF);
+
 }
 
 #endif
@@ -1,11 +1,16 @@
 #ifndef OPENMW_COMPONENTS_FILES_MEMORYSTREAM_H
 #define OPENMW_COMPONENTS_FILES_MEMORYSTREAM_H
 
+#include <algorithm>
 #include <istream>
+#include <ostream>
+#include <string>
 
 namespace Files
 {
 
+    /// @brief Read-only std::streambuf over a constant in-memory buffer, seeking is bounds-checked.
+    /// @note Does not take ownership of the buffer, derived classes may keep the owner of the buffer alive.
     struct MemBuf : std::streambuf
     {
         MemBuf(char const* buffer, size_t size)
@@ -16,19 +21,42 @@ namespace Files
             this->setg(bufferStart, bufferStart, bufferEnd);
         }
 
+        std::streamsize showmanyc() override
+        {
+            return egptr() - gptr();
+        }
+
         pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
         {
-            if (dir == std::ios_base::cur)
-                gbump(off);
-            else
-                setg(bufferStart, (dir == std::ios_base::beg ? bufferStart : bufferEnd) + off, bufferEnd);
+            if ((which & std::ios_base::out) || !(which & std::ios_base::in))
+                return pos_type(off_type(-1));
+
+            off_type newPos;
+            switch (dir)
+            {
+                case std::ios_base::beg:
+                    newPos = off;
+                    break;
+                case std::ios_base::cur:
+                    newPos = (gptr() - bufferStart) + off;
+                    break;
+                case std::ios_base::end:
+                    newPos = (bufferEnd - bufferStart) + off;
+                    break;
+                default:
+                    return pos_type(off_type(-1));
+            }
+
+            if (newPos < 0 || newPos > bufferEnd - bufferStart)
+                return pos_type(off_type(-1));
 
-            return gptr() - bufferStart;
+            setg(bufferStart, bufferStart + newPos, bufferEnd);
+            return newPos;
         }
 
         pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
         {
-            return seekoff(pos, std::ios_base::beg, which);
+            return seekoff(off_type(pos), std::ios_base::beg, which);
         }
 
     protected:
@@ -46,6 +74,73 @@ namespace Files
         }
     };
 
+    /// @brief Output buffer writing into a std::string, which can be moved out without a copy, unlike the one
+    /// of std::stringstream.
+    struct StringBuf : std::streambuf
+    {
+        /// Take the written data, leaving the buffer empty.
+        std::string release()
+        {
+            std::string result;
+            result.swap(mData);
+            mPosition = 0;
+            return result;
+        }
+
+    protected:
+        std::streamsize xsputn(const char* data, std::streamsize size) override
+        {
+            const std::size_t count = static_cast<std::size_t>(size);
+            const std::size_t overwritten = std::min(count, mData.size() - mPosition);
+            mData.replace(mPosition, overwritten, data, overwritten);
+            mData.append(data + overwritten, count - overwritten);
+            mPosition += count;
+            return size;
+        }
+
+        int_type overflow(int_type c) override
+        {
+            if (traits_type::eq_int_type(c, traits_type::eof()))
+                return traits_type::not_eof(c);
+            const char value = traits_type::to_char_type(c);
+            xsputn(&value, 1);
+            return c;
+        }
+
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+        {
+            if (!(which & std::ios_base::out))
+                return pos_type(off_type(-1));
+
+            const off_type base = dir == std::ios_base::beg ? 0
+                : dir == std::ios_base::cur ? static_cast<off_type>(mPosition)
+                : static_cast<off_type>(mData.size());
+            if (base + off < 0 || base + off > static_cast<off_type>(mData.size()))
+                return pos_type(off_type(-1));
+
+            mPosition = static_cast<std::size_t>(base + off);
+            return static_cast<off_type>(mPosition);
+        }
+
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+        {
+            return seekoff(pos, std::ios_base::beg, which);
+        }
+
+    private:
+        std::string mData;
+        std::size_t mPosition = 0;
+    };
+
+    /// @brief A variant of std::ostream that writes into a std::string, see StringBuf::release.
+    struct OMemStream: virtual StringBuf, std::ostream
+    {
+        OMemStream()
+            : std::ostream(static_cast<std::streambuf*>(this))
+        {
+        }
+    };
+
 }
 
 #endif
@@ -18,12 +18,12 @@ namespace Interpreter
                 int opcode = code>>24;
                 unsigned int arg0 = code & 0xffffff;
 
-                std::map<int, Opcode1 *>::iterator iter = mSegment0.find (opcode);
+                Opcode1 *instruction = mSegment0.find (opcode);
 
-                if (iter==mSegment0.end())
+                if (!instruction)
                     abortUnknownCode (0, opcode);
 
-                iter->second->execute (mRuntime, arg0);
+                instruction->execute (mRuntime, arg0);
 
                 return;
             }
@@ -34,12 +34,12 @@ namespace Interpreter
                 unsigned int arg0 = (code>>16) & 0xfff;
                 unsigned int arg1 = code & 0xfff;
 
-                std::map<int, Opcode2 *>::iterator iter = mSegment1.find (opcode);
+                Opcode2 *instruction = mSegment1.find (opcode);
 
-                if (iter==mSegment1.end())
+                if (!instruction)
                     abortUnknownCode (1, opcode);
 
-                iter->second->execute (mRuntime, arg0, arg1);
+                instruction->execute (mRuntime, arg0, arg1);
 
                 return;
             }
@@ -49,12 +49,12 @@ namespace Interpreter
                 int opcode = (code>>20) & 0x3ff;
                 unsigned int arg0 = code & 0xfffff;
 
-                std::map<int, Opcode1 *>::iterator iter = mSegment2.find (opcode);
+                Opcode1 *instruction = mSegment2.find (opcode);
 
-                if (iter==mSegment2.end())
+                if (!instruction)
                     abortUnknownCode (2, opcode);
 
-                iter->second->execute (mRuntime, arg0);
+                instruction->execute (mRuntime, arg0);
 
                 return;
             }
@@ -69,12 +69,12 @@ namespace Interpreter
                 int opcode = (code>>8) & 0x3ffff;
                 unsigned int arg0 = code & 0xff;
 
-                std::map<int, Opcode1 *>::iterator iter = mSegment3.find (opcode);
+                Opcode1 *instruction = mSegment3.find (opcode);
 
-                if (iter==mSegment3.end())
+                if (!instruction)
                     abortUnknownCode (3, opcode);
 
-                iter->second->execute (mRuntime, arg0);
+                instruction->execute (mRuntime, arg0);
 
                 return;
             }
@@ -85,12 +85,12 @@ namespace Interpreter
                 unsigned int arg0 = (code>>8) & 0xff;
                 unsigned int arg1 = code & 0xff;
 
-                std::map<int, Opcode2 *>::iterator iter = mSegment4.find (opcode);
+                Opcode2 *instruction = mSegment4.find (opcode);
 
-                if (iter==mSegment4.end())
+                if (!instruction)
                     abortUnknownCode (4, opcode);
 
-                iter->second->execute (mRuntime, arg0, arg1);
+                instruction->execute (mRuntime, arg0, arg1);
 
                 return;
             }
@@ -99,12 +99,12 @@ namespace Interpreter
             {
                 int opcode = code & 0x3ffffff;
 
-                std::map<int, Opcode0 *>::iterator iter = mSegment5.find (opcode);
+                Opcode0 *instruction = mSegment5.find (opcode);
 
-                if (iter==mSegment5.end())
+                if (!instruction)
                     abortUnknownCode (5, opcode);
 
-                iter->second->execute (mRuntime);
+                instruction->execute (mRuntime);
 
                 return;
             }
@@ -156,74 +156,52 @@ namespace Interpreter
     {}
 
     Interpreter::~Interpreter()
-    {
-        for (std::map<int, Opcode1 *>::iterator iter (mSegment0.begin());
-            iter!=mSegment0.end(); ++iter)
-            delete iter->second;
-
-        for (std::map<int, Opcode2 *>::iterator iter (mSegment1.begin());
-            iter!=mSegment1.end(); ++iter)
-            delete iter->second;
-
-        for (std::map<int, Opcode1 *>::iterator iter (mSegment2.begin());
-            iter!=mSegment2.end(); ++iter)
-            delete iter->second;
-
-        for (std::map<int, Opcode1 *>::iterator iter (mSegment3.begin());
-            iter!=mSegment3.end(); ++iter)
-            delete iter->second;
-
-        for (std::map<int, Opcode2 *>::iterator iter (mSegment4.begin());
-            iter!=mSegment4.end(); ++iter)
-            delete iter->second;
-
-        for (std::map<int, Opcode0 *>::iterator iter (mSegment5.begin());
-            iter!=mSegment5.end(); ++iter)
-            delete iter->second;
-    }
+    {}
 
     void Interpreter::installSegment0 (int code, Opcode1 *opcode)
     {
-        assert(mSegment0.find(code) == mSegment0.end());
-        mSegment0.insert (std::make_pair (code, opcode));
+        assert(!mSegment0.find(code));
+        mSegment0.insert (code, opcode);
     }
 
     void Interpreter::installSegment1 (int code, Opcode2 *opcode)
     {
-        assert(mSegment1.find(code) == mSegment1.end());
-        mSegment1.insert (std::make_pair (code, opcode));
+        assert(!mSegment1.find(code));
+        mSegment1.insert (code, opcode);
     }
 
     void Interpreter::installSegment2 (int code, Opcode1 *opcode)
     {
-        assert(mSegment2.find(code) == mSegment2.end());
-        mSegment2.insert (std::make_pair (code, opcode));
+        assert(!mSegment2.find(code));
+        mSegment2.insert (code, opcode);
     }
 
     void Interpreter::installSegment3 (int code, Opcode1 *opcode)
     {
-        assert(mSegment3.find(code) == mSegment3.end());
-        mSegment3.insert (std::make_pair (code, opcode));
+        assert(!mSegment3.find(code));
+        mSegment3.insert (code, opcode);
     }
 
     void Interpreter::installSegment4 (int code, Opcode2 *opcode)
     {
-        assert(mSegment4.find(code) == mSegment4.end());
-        mSegment4.insert (std::make_pair (code, opcode));
+        assert(!mSegment4.find(code));
+        mSegment4.insert (code, opcode);
     }
 
     void Interpreter::installSegment5 (int code, Opcode0 *opcode)
     {
-        assert(mSegment5.find(code) == mSegment5.end());
-        mSegment5.insert (std::make_pair (code, opcode));
+        assert(!mSegment5.find(code));
+        mSegment5.insert (code, opcode);
     }
 
-    void Interpreter::run (const Type_Code *code, int codeSize, Context& context)
+    int Interpreter::run (const Type_Code *code, int codeSize, Context& context)
     {
         assert (codeSize>=4);
 
         begin();
 
+        int executed = 0;
+
         try
         {
             mRuntime.configure (code, codeSize, context);
@@ -237,6 +215,7 @@ namespace Interpreter
                 Type_Code runCode = codeBlock[mRuntime.getPC()];
                 mRuntime.setPC (mRuntime.getPC()+1);
                 execute (runCode);
+                ++executed;
             }
         }
         catch (...)
@@ -246,5 +225,7 @@ namespace Interpreter
         }
 
         end();
+
+        return executed;
     }
 }
@@ -1,9 +1,9 @@
 #ifndef INTERPRETER_INTERPRETER_H_INCLUDED
 #define INTERPRETER_INTERPRETER_H_INCLUDED
 
-#include <map>
 #include <stack>
 
+#include "opcodetable.hpp"
 #include "runtime.hpp"
 #include "types.hpp"
 
@@ -18,12 +18,12 @@ namespace Interpreter
             std::stack<Runtime> mCallstack;
             bool mRunning;
             Runtime mRuntime;
-            std::map<int, Opcode1 *> mSegment0;
-            std::map<int, Opcode2 *> mSegment1;
-            std::map<int, Opcode1 *> mSegment2;
-            std::map<int, Opcode1 *> mSegment3;
-            std::map<int, Opcode2 *> mSegment4;
-            std::map<int, Opcode0 *> mSegment5;
+            OpcodeTable<Opcode1> mSegment0;
+            OpcodeTable<Opcode2> mSegment1;
+            OpcodeTable<Opcode1> mSegment2;
+            OpcodeTable<Opcode1> mSegment3;
+            OpcodeTable<Opcode2> mSegment4;
+            OpcodeTable<Opcode0> mSegment5;
 
             // not implemented
             Interpreter (const Interpreter&);
@@ -63,7 +63,8 @@ namespace Interpreter
             void installSegment5 (int code, Opcode0 *opcode);
             ///< ownership of \a opcode is transferred to *this.
 
-            void run (const Type_Code *code, int codeSize, Context& context);
+            int run (const Type_Code *code, int codeSize, Context& context);
+            ///< \return number of executed instructions
     };
 }
 
@@ -0,0 +1,85 @@
+#ifndef INTERPRETER_OPCODETABLE_H_INCLUDED
+#define INTERPRETER_OPCODETABLE_H_INCLUDED
+
+#include <vector>
+
+namespace Interpreter
+{
+    /// \brief Opcodes of a segment, looked up by indexing instead of a tree search
+    ///
+    /// Opcodes of a segment are allocated in a few contiguous ranges (the ones of the interpreter itself
+    /// and the ones of the extensions), so codes are stored in dense blocks and a new block is started only
+    /// for a code far from all the existing ones.
+    template<class T>
+    class OpcodeTable
+    {
+            struct Block
+            {
+                int mBase;
+                std::vector<T *> mOpcodes;
+            };
+
+            static const int sMaxGap = 256;
+
+            std::vector<Block> mBlocks;
+
+            // not implemented
+            OpcodeTable (const OpcodeTable&);
+            OpcodeTable& operator= (const OpcodeTable&);
+
+        public:
+
+            OpcodeTable() {}
+
+            ~OpcodeTable()
+            {
+                for (const Block& block : mBlocks)
+                    for (T *opcode : block.mOpcodes)
+                        delete opcode;
+            }
+
+            T *find (int code) const
+            {
+                for (const Block& block : mBlocks)
+                {
+                    const unsigned int index = static_cast<unsigned int> (code - block.mBase);
+
+                    if (index<block.mOpcodes.size() && block.mOpcodes[index])
+                        return block.mOpcodes[index];
+                }
+
+                return nullptr;
+            }
+
+            bool insert (int code, T *opcode)
+            ///< ownership of \a opcode is transferred to *this, unless there already is an opcode for \a code.
+            {
+                if (find (code))
+                    return false;
+
+                for (Block& block : mBlocks)
+                {
+                    const int end = block.mBase + static_cast<int> (block.mOpcodes.size());
+
+                    if (code<block.mBase-sMaxGap || code>=end+sMaxGap)
+                        continue;
+
+                    if (code<block.mBase)
+                    {
+                        block.mOpcodes.insert (block.mOpcodes.begin(), block.mBase-code, nullptr);
+                        block.mBase = code;
+                    }
+                    else if (code>=end)
+                        block.mOpcodes.resize (code-block.mBase+1, nullptr);
+
+                    block.mOpcodes[code-block.mBase] = opcode;
+                    return true;
+                }
+
+                mBlocks.push_back (Block {code, std::vector<T *> (1, opcode)});
+                return true;
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,39 @@
+#include "binaryio.hpp"
+
+namespace Misc
+{
+    bool readBinary(std::istream& stream, std::string& value, std::uint64_t maxSize)
+    {
+        std::uint32_t size = 0;
+        if (!readBinary(stream, size) || size > maxSize)
+            return false;
+
+        value.resize(size);
+        return size == 0 || static_cast<bool>(stream.read(&value[0], size));
+    }
+
+    void writeBinary(std::ostream& stream, const std::string& value)
+    {
+        writeBinary(stream, static_cast<std::uint32_t>(value.size()));
+        stream.write(value.data(), value.size());
+    }
+
+    void writeFileHeader(std::ostream& stream, const FileMagic& magic, std::uint32_t version)
+    {
+        stream.write(magic.data(), magic.size());
+        writeBinary(stream, version);
+    }
+
+    bool readFileHeader(std::istream& stream, const FileMagic& magic, std::uint32_t& version)
+    {
+        version = 0;
+
+        FileMagic fileMagic;
+        if (!readBinary(stream, fileMagic) || fileMagic != magic)
+            return false;
+
+        if (!readBinary(stream, version))
+            version = 0;
+        return true;
+    }
+}
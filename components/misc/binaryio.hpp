@@ -0,0 +1,48 @@
+#ifndef OPENMW_COMPONENTS_MISC_BINARYIO_H
+#define OPENMW_COMPONENTS_MISC_BINARYIO_H
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+/// Reading and writing of the binary files the engine stores next to the user data, in the byte order of the machine.
+/// These files start with a magic number identifying the kind of file, followed by the version of its layout.
+namespace Misc
+{
+    typedef std::array<char, 8> FileMagic;
+
+    /// Size of the header written by writeFileHeader
+    const std::uint64_t sFileHeaderSize = sizeof(FileMagic) + sizeof(std::uint32_t);
+
+    template <class T>
+    bool readBinary(std::istream& stream, T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only values can be read as bytes");
+        return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+
+    template <class T>
+    void writeBinary(std::ostream& stream, const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only values can be written as bytes");
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    /// Read a string written by writeBinary, failing if it is longer than \a maxSize.
+    bool readBinary(std::istream& stream, std::string& value, std::uint64_t maxSize);
+
+    /// Write the size of \a value followed by its characters.
+    void writeBinary(std::ostream& stream, const std::string& value);
+
+    void writeFileHeader(std::ostream& stream, const FileMagic& magic, std::uint32_t version);
+
+    /// Read the header written by writeFileHeader.
+    /// @return false if \a stream doesn't start with \a magic. Otherwise \a version is the version of the file, or 0 if
+    /// the header is truncated.
+    bool readFileHeader(std::istream& stream, const FileMagic& magic, std::uint32_t& version);
+}
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef OPENMW_COMPONENTS_MISC_HASH_H
+#define OPENMW_COMPONENTS_MISC_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace Misc
+{
+    /// \brief 64-bit FNV-1a hash of the bytes added to it
+    ///
+    /// Used for the hashes stored in the engine's cache files, so the result must not change between versions.
+    class Hash
+    {
+    public:
+        void add(const void* data, std::size_t size)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i)
+                mValue = (mValue ^ bytes[i]) * 1099511628211ull;
+            mSize += size;
+        }
+
+        template <class T>
+        void add(const T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Only values can be hashed by their bytes");
+            add(&value, sizeof(value));
+        }
+
+        /// Add the number of values followed by the values, so different splits of the same values hash differently
+        template <class T>
+        void add(const std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Only values can be hashed by their bytes");
+            add(static_cast<std::uint64_t>(values.size()));
+            add(values.data(), values.size() * sizeof(T));
+        }
+
+        std::uint64_t getValue() const { return mValue; }
+
+        /// @return the number of bytes added
+        std::uint64_t getSize() const { return mSize; }
+
+    private:
+        std::uint64_t mValue = 14695981039346656037ull;
+        std::uint64_t mSize = 0;
+    };
+}
+
+#endif
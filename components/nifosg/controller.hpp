@@ -9,7 +9,11 @@
 #include <components/sceneutil/controller.hpp>
 #include <components/sceneutil/statesetupdater.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <memory>
 #include <set> //UVController
+#include <vector>
 
 // FlipController
 #include <osg/Texture2D>
@@ -34,27 +38,50 @@ namespace osgParticle
 namespace NifOsg
 {
 
+    /// Keys of a Nif::KeyMapT with times and values in separate contiguous arrays, so that finding the keys
+    /// around a time only touches the times and interpolating only touches the two values.
+    template <typename T>
+    struct KeyframeTrack
+    {
+        std::vector<float> mTimes;
+        std::vector<T> mValues;
+        unsigned int mInterpolationType = Nif::InterpolationType_Linear;
+
+        template <typename MapT>
+        explicit KeyframeTrack(const MapT& keys)
+            : mInterpolationType(keys.mInterpolationType)
+        {
+            mTimes.reserve(keys.mKeys.size());
+            mValues.reserve(keys.mKeys.size());
+            for (const auto& key : keys.mKeys)
+            {
+                mTimes.push_back(key.first);
+                mValues.push_back(key.second.mValue);
+            }
+        }
+    };
+
     // interpolation of keyframes
     template <typename MapT>
     class ValueInterpolator
     {
-        typename MapT::MapType::const_iterator retrieveKey(float time) const
+        std::size_t retrieveKey(float time) const
         {
-            // retrieve the current position in the map, optimized for the most common case
+            // retrieve the current position in the track, optimized for the most common case
             // where time moves linearly along the keyframe track
-            if (mLastHighKey != mKeys->mKeys.end())
+            const std::vector<float>& times = mTrack->mTimes;
+            if (mLastHighKey < times.size())
             {
-                if (time > mLastHighKey->first)
+                if (time > times[mLastHighKey])
                 {
                     // try if we're there by incrementing one
-                    ++mLastLowKey;
                     ++mLastHighKey;
                 }
-                if (mLastHighKey != mKeys->mKeys.end() && time >= mLastLowKey->first && time <= mLastHighKey->first)
+                if (mLastHighKey < times.size() && time >= times[mLastHighKey - 1] && time <= times[mLastHighKey])
                     return mLastHighKey;
             }
 
-            return mKeys->mKeys.lower_bound(time);
+            return std::lower_bound(times.begin(), times.end(), time) - times.begin();
         }
 
     public:
@@ -63,14 +90,11 @@ namespace NifOsg
         ValueInterpolator() = default;
 
         ValueInterpolator(std::shared_ptr<const MapT> keys, ValueT defaultVal = ValueT())
-            : mKeys(keys)
-            , mDefaultVal(defaultVal)
+            : mDefaultVal(defaultVal)
         {
-            if (keys)
-            {
-                mLastLowKey = mKeys->mKeys.end();
-                mLastHighKey = mKeys->mKeys.end();
-            }
+            // convert once at load time, copies of the controller share the track
+            if (keys && !keys->mKeys.empty())
+                mTrack = std::make_shared<const KeyframeTrack<ValueT>>(*keys);
         }
 
         ValueT interpKey(float time) const
@@ -78,64 +102,65 @@ namespace NifOsg
             if (empty())
                 return mDefaultVal;
 
-            const typename MapT::MapType & keys = mKeys->mKeys;
+            const std::vector<float>& times = mTrack->mTimes;
+            const std::vector<ValueT>& values = mTrack->mValues;
 
-            if(time <= keys.begin()->first)
-                return keys.begin()->second.mValue;
+            if(time <= times.front())
+                return values.front();
 
-            typename MapT::MapType::const_iterator it = retrieveKey(time);
+            // time is past the first key, so the key found is never the first one
+            const std::size_t high = retrieveKey(time);
 
             // now do the actual interpolation
-            if (it != keys.end())
+            if (high < times.size())
             {
                 // cache for next time
-                mLastHighKey = it;
-                mLastLowKey = --it;
+                mLastHighKey = high;
 
-                float a = (time - mLastLowKey->first) / (mLastHighKey->first - mLastLowKey->first);
+                const std::size_t low = high - 1;
+                float a = (time - times[low]) / (times[high] - times[low]);
 
-                return interpolate(mLastLowKey->second, mLastHighKey->second, a, mKeys->mInterpolationType);
+                return interpolate(values[low], values[high], a, mTrack->mInterpolationType);
             }
 
-            return keys.rbegin()->second.mValue;
+            return values.back();
         }
 
         bool empty() const
         {
-            return !mKeys || mKeys->mKeys.empty();
+            return !mTrack;
         }
 
     private:
         template <typename ValueType>
-        ValueType interpolate(const Nif::KeyT<ValueType>& a, const Nif::KeyT<ValueType>& b, float fraction, unsigned int type) const
+        static ValueType interpolate(const ValueType& a, const ValueType& b, float fraction, unsigned int type)
         {
             switch (type)
             {
                 case Nif::InterpolationType_Constant:
-                    return fraction > 0.5f ? b.mValue : a.mValue;
+                    return fraction > 0.5f ? b : a;
                 default:
-                    return a.mValue + ((b.mValue - a.mValue) * fraction);
+                    return a + ((b - a) * fraction);
             }
         }
-        osg::Quat interpolate(const Nif::KeyT<osg::Quat>& a, const Nif::KeyT<osg::Quat>& b, float fraction, unsigned int type) const
+        static osg::Quat interpolate(const osg::Quat& a, const osg::Quat& b, float fraction, unsigned int type)
         {
             switch (type)
             {
                 case Nif::InterpolationType_Constant:
-                    return fraction > 0.5f ? b.mValue : a.mValue;
+                    return fraction > 0.5f ? b : a;
                 default:
                 {
                     osg::Quat result;
-                    result.slerp(fraction, a.mValue, b.mValue);
+                    result.slerp(fraction, a, b);
                     return result;
                 }
             }
         }
 
-        mutable typename MapT::MapType::const_iterator mLastLowKey;
-        mutable typename MapT::MapType::const_iterator mLastHighKey;
+        mutable std::size_t mLastHighKey = std::numeric_limits<std::size_t>::max();
 
-        std::shared_ptr<const MapT> mKeys;
+        std::shared_ptr<const KeyframeTrack<ValueT>> mTrack;
 
         ValueT mDefaultVal = ValueT();
     };
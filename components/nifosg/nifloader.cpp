@@ -1874,6 +1874,7 @@ namespace NifOsg
     {
         LoaderImpl impl(kf->getFilename(), kf->getVersion(), kf->getUserVersion(), kf->getBethVersion());
         impl.loadKf(kf, target);
+        target.mTextKeyIndex = TextKeyIndex(target.mTextKeys);
     }
 
 }
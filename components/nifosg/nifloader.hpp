@@ -7,6 +7,7 @@
 #include <osg/Referenced>
 
 #include "controller.hpp"
+#include "textkeyindex.hpp"
 
 namespace osg
 {
@@ -20,8 +21,6 @@ namespace Resource
 
 namespace NifOsg
 {
-    typedef std::multimap<float,std::string> TextKeyMap;
-
     struct TextKeyMapHolder : public osg::Object
     {
     public:
@@ -43,11 +42,13 @@ namespace NifOsg
         KeyframeHolder() {}
         KeyframeHolder(const KeyframeHolder& copy, const osg::CopyOp& copyop)
             : mTextKeys(copy.mTextKeys)
+            , mTextKeyIndex(copy.mTextKeyIndex)
             , mKeyframeControllers(copy.mKeyframeControllers)
         {
         }
 
         TextKeyMap mTextKeys;
+        TextKeyIndex mTextKeyIndex;
 
         META_Object(OpenMW, KeyframeHolder)
 
@@ -0,0 +1,207 @@
+#include "textkeyindex.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+    void split(const std::string &s, char delim, std::vector<std::string> &elems)
+    {
+        std::stringstream ss(s);
+        std::string item;
+        while (std::getline(ss, item, delim))
+            elems.push_back(item);
+    }
+
+    void parseSound(NifOsg::TextKeyIndex::Key& key)
+    {
+        const std::string& text = key.mText;
+        if (text.compare(0, 7, "sound: ") == 0)
+        {
+            key.mSoundType = NifOsg::TextKeyIndex::Sound_Sound;
+            key.mSound = text.substr(7);
+        }
+        else if (text.compare(0, 10, "soundgen: ") == 0)
+        {
+            key.mSoundType = NifOsg::TextKeyIndex::Sound_SoundGen;
+            key.mSound = text.substr(10);
+
+            // The event can optionally contain volume and pitch modifiers
+            if (key.mSound.find(" ") != std::string::npos)
+            {
+                std::vector<std::string> tokens;
+                split(key.mSound, ' ', tokens);
+                key.mSound = tokens[0];
+                if (tokens.size() >= 2)
+                {
+                    std::stringstream stream;
+                    stream << tokens[1];
+                    stream >> key.mVolume;
+                }
+                if (tokens.size() >= 3)
+                {
+                    std::stringstream stream;
+                    stream << tokens[2];
+                    stream >> key.mPitch;
+                }
+            }
+        }
+    }
+}
+
+namespace NifOsg
+{
+    const std::size_t TextKeyIndex::sNone;
+
+    std::size_t TextKeyIndex::Group::findLast(const std::string& markerName) const
+    {
+        for (std::size_t i = mKeys.size(); i-- > 0;)
+        {
+            if (mKeys[i].mMarkerName == markerName)
+                return i;
+        }
+        return sNone;
+    }
+
+    std::size_t TextKeyIndex::Group::findLastPrefix(const std::string& prefix) const
+    {
+        for (std::size_t i = mKeys.size(); i-- > 0;)
+        {
+            if (mKeys[i].mMarkerName.compare(0, prefix.size(), prefix) == 0)
+                return i;
+        }
+        return sNone;
+    }
+
+    TextKeyIndex::TextKeyIndex(const TextKeyMap& keys)
+    {
+        mKeys.reserve(keys.size());
+        for (const auto& textKey : keys)
+        {
+            Key key;
+            key.mTime = textKey.first;
+            key.mText = textKey.second;
+            key.mGroup = sNone;
+            key.mMarker = Marker_None;
+            key.mHasHitKey = false;
+            key.mSoundType = Sound_None;
+            key.mVolume = 1.f;
+            key.mPitch = 1.f;
+            parseSound(key);
+
+            // The key belongs to the group named by the text before each ": ", the last one is its own group
+            const std::string& text = key.mText;
+            for (std::size_t pos = text.find(": "); pos != std::string::npos; pos = text.find(": ", pos + 1))
+            {
+                const std::string groupName = text.substr(0, pos);
+                auto found = mGroupIds.find(groupName);
+                if (found == mGroupIds.end())
+                {
+                    found = mGroupIds.emplace(groupName, mGroups.size()).first;
+                    mGroups.push_back(Group {mGroups.size(), {}});
+                }
+
+                GroupKey groupKey {mKeys.size(), text.substr(pos + 2), Marker_None};
+                groupKey.mMarker = parseMarker(groupKey.mMarkerName);
+
+                key.mGroupName = groupName;
+                key.mGroup = found->second;
+                key.mMarkerName = groupKey.mMarkerName;
+                key.mMarker = groupKey.mMarker;
+
+                mGroups[found->second].mKeys.push_back(std::move(groupKey));
+            }
+
+            mKeys.push_back(std::move(key));
+        }
+
+        // Not all attack animations have a hit key, without one the hit happens with the start key
+        for (const Group& group : mGroups)
+        {
+            bool hasHitKey = false;
+            for (auto it = group.mKeys.rbegin(); it != group.mKeys.rend(); ++it)
+            {
+                if (it->mMarker == Marker_Hit)
+                    hasHitKey = true;
+                else if (it->mMarker == Marker_Stop)
+                    hasHitKey = false;
+                else if (it->mMarker == Marker_Start)
+                    mKeys[it->mKey].mHasHitKey = hasHitKey;
+            }
+        }
+    }
+
+    const TextKeyIndex::Group* TextKeyIndex::findGroup(const std::string& name) const
+    {
+        const auto found = mGroupIds.find(name);
+        if (found == mGroupIds.end())
+            return nullptr;
+        return &mGroups[found->second];
+    }
+
+    const TextKeyIndex::Key* TextKeyIndex::findKey(const std::string& prefix) const
+    {
+        const std::size_t pos = prefix.find(": ");
+        if (pos == std::string::npos)
+        {
+            for (const Key& key : mKeys)
+            {
+                if (key.mText.compare(0, prefix.size(), prefix) == 0)
+                    return &key;
+            }
+            return nullptr;
+        }
+
+        const Group* group = findGroup(prefix.substr(0, pos));
+        if (!group)
+            return nullptr;
+
+        const std::size_t markerSize = prefix.size() - pos - 2;
+        for (const GroupKey& groupKey : group->mKeys)
+        {
+            if (groupKey.mMarkerName.compare(0, markerSize, prefix, pos + 2, markerSize) == 0)
+                return &mKeys[groupKey.mKey];
+        }
+        return nullptr;
+    }
+
+    std::size_t TextKeyIndex::lowerBound(float time) const
+    {
+        const auto it = std::lower_bound(mKeys.begin(), mKeys.end(), time,
+            [] (const Key& key, float value) { return key.mTime < value; });
+        return static_cast<std::size_t>(it - mKeys.begin());
+    }
+
+    std::size_t TextKeyIndex::upperBound(float time) const
+    {
+        const auto it = std::upper_bound(mKeys.begin(), mKeys.end(), time,
+            [] (float value, const Key& key) { return value < key.mTime; });
+        return static_cast<std::size_t>(it - mKeys.begin());
+    }
+
+    TextKeyIndex::Marker TextKeyIndex::parseMarker(const std::string& markerName)
+    {
+        static const std::map<std::string, Marker> markers {
+            {"start", Marker_Start},
+            {"loop start", Marker_LoopStart},
+            {"loop stop", Marker_LoopStop},
+            {"stop", Marker_Stop},
+            {"hit", Marker_Hit},
+            {"chop hit", Marker_ChopHit},
+            {"slash hit", Marker_SlashHit},
+            {"thrust hit", Marker_ThrustHit},
+            {"block hit", Marker_BlockHit},
+            {"equip attach", Marker_EquipAttach},
+            {"unequip detach", Marker_UnequipDetach},
+            {"shoot attach", Marker_ShootAttach},
+            {"shoot release", Marker_ShootRelease},
+            {"shoot follow attach", Marker_ShootFollowAttach},
+            {"loot", Marker_Loot},
+        };
+
+        const auto found = markers.find(markerName);
+        if (found == markers.end())
+            return Marker_None;
+        return found->second;
+    }
+}
@@ -0,0 +1,123 @@
+#ifndef OPENMW_COMPONENTS_NIFOSG_TEXTKEYINDEX_H
+#define OPENMW_COMPONENTS_NIFOSG_TEXTKEYINDEX_H
+
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace NifOsg
+{
+    typedef std::multimap<float,std::string> TextKeyMap;
+
+    /// @brief Parsed text keys of an animation, built once when the animation is loaded.
+    /// @par Text keys are named "<group>: <marker>", or "sound: <id>" and "soundgen: <type> [volume [pitch]]" for
+    /// sound events. Looking up a group, its markers and the sound to play does no string parsing at runtime.
+    class TextKeyIndex
+    {
+    public:
+        static const std::size_t sNone = std::numeric_limits<std::size_t>::max();
+
+        enum Marker
+        {
+            Marker_None, ///< Any marker not listed here
+            Marker_Start,
+            Marker_LoopStart,
+            Marker_LoopStop,
+            Marker_Stop,
+            Marker_Hit,
+            Marker_ChopHit,
+            Marker_SlashHit,
+            Marker_ThrustHit,
+            Marker_BlockHit,
+            Marker_EquipAttach,
+            Marker_UnequipDetach,
+            Marker_ShootAttach,
+            Marker_ShootRelease,
+            Marker_ShootFollowAttach,
+            Marker_Loot
+        };
+
+        enum SoundType
+        {
+            Sound_None,
+            Sound_Sound,
+            Sound_SoundGen
+        };
+
+        struct Key
+        {
+            float mTime;
+            std::string mText;
+
+            /// Text before the last ": ", and its group id, or sNone if there is no ": "
+            std::string mGroupName;
+            std::size_t mGroup;
+
+            /// Text after the last ": "
+            std::string mMarkerName;
+            Marker mMarker;
+
+            /// For Marker_Start keys, whether a "hit" key of the same group follows before its "stop" key
+            bool mHasHitKey;
+
+            SoundType mSoundType;
+            /// Sound id, or sound generator type for Sound_SoundGen
+            std::string mSound;
+            float mVolume;
+            float mPitch;
+        };
+
+        struct GroupKey
+        {
+            /// Index in getKeys()
+            std::size_t mKey;
+            /// Text after "<group>: "
+            std::string mMarkerName;
+            Marker mMarker;
+        };
+
+        struct Group
+        {
+            std::size_t mId;
+            /// Keys named "<group>: ...", in time order
+            std::vector<GroupKey> mKeys;
+
+            /// @return index in mKeys of the last key with this marker name, or sNone
+            std::size_t findLast(const std::string& markerName) const;
+
+            /// @return index in mKeys of the last key with a marker name starting with \a prefix, or sNone
+            std::size_t findLastPrefix(const std::string& prefix) const;
+        };
+
+        TextKeyIndex() = default;
+
+        explicit TextKeyIndex(const TextKeyMap& keys);
+
+        /// All keys, in time order.
+        const std::vector<Key>& getKeys() const { return mKeys; }
+
+        /// @return the group of the keys named "<name>: ...", or nullptr if there is none
+        const Group* findGroup(const std::string& name) const;
+
+        /// @return the first key with a text starting with \a prefix, or nullptr if there is none
+        const Key* findKey(const std::string& prefix) const;
+
+        /// @return index of the first key at or after \a time
+        std::size_t lowerBound(float time) const;
+
+        /// @return index of the first key after \a time
+        std::size_t upperBound(float time) const;
+
+        static Marker parseMarker(const std::string& markerName);
+
+    private:
+        std::vector<Key> mKeys;
+        std::vector<Group> mGroups;
+        std::unordered_map<std::string, std::size_t> mGroupIds;
+    };
+}
+
+#endif
@@ -109,42 +109,40 @@ BulletShapeManager::~BulletShapeManager()
 }
 
 osg::ref_ptr<const BulletShape> BulletShapeManager::getShape(const std::string &name)
+{
+    return osg::ref_ptr<const BulletShape>(static_cast<BulletShape*>(getObject(name).get()));
+}
+
+osg::ref_ptr<osg::Object> BulletShapeManager::getObject(const std::string &name)
 {
     std::string normalized = name;
     mVFS->normalizeFilename(normalized);
 
-    osg::ref_ptr<BulletShape> shape;
-    osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(normalized);
-    if (obj)
-        shape = osg::ref_ptr<BulletShape>(static_cast<BulletShape*>(obj.get()));
+    return getOrLoad(normalized, [&] { return loadShape(normalized); });
+}
+
+osg::ref_ptr<BulletShape> BulletShapeManager::loadShape(const std::string &normalized)
+{
+    size_t extPos = normalized.find_last_of('.');
+    std::string ext;
+    if (extPos != std::string::npos && extPos+1 < normalized.size())
+        ext = normalized.substr(extPos+1);
+
+    if (ext == "nif")
+    {
+        NifBullet::BulletNifLoader loader;
+        return loader.load(*mNifFileManager->get(normalized));
+    }
     else
     {
-        size_t extPos = normalized.find_last_of('.');
-        std::string ext;
-        if (extPos != std::string::npos && extPos+1 < normalized.size())
-            ext = normalized.substr(extPos+1);
-
-        if (ext == "nif")
-        {
-            NifBullet::BulletNifLoader loader;
-            shape = loader.load(*mNifFileManager->get(normalized));
-        }
-        else
-        {
-            // TODO: support .bullet shape files
-
-            osg::ref_ptr<const osg::Node> constNode (mSceneManager->getTemplate(normalized));
-            osg::ref_ptr<osg::Node> node (const_cast<osg::Node*>(constNode.get())); // const-trickery required because there is no const version of NodeVisitor
-            NodeToShapeVisitor visitor;
-            node->accept(visitor);
-            shape = visitor.getShape();
-            if (!shape)
-                return osg::ref_ptr<BulletShape>();
-        }
-
-        mCache->addEntryToObjectCache(normalized, shape);
+        // TODO: support .bullet shape files
+
+        osg::ref_ptr<const osg::Node> constNode (mSceneManager->getTemplate(normalized));
+        osg::ref_ptr<osg::Node> node (const_cast<osg::Node*>(constNode.get())); // const-trickery required because there is no const version of NodeVisitor
+        NodeToShapeVisitor visitor;
+        node->accept(visitor);
+        return visitor.getShape();
     }
-    return shape;
 }
 
 osg::ref_ptr<BulletShapeInstance> BulletShapeManager::cacheInstance(const std::string &name)
@@ -46,7 +46,13 @@ namespace Resource
 
         void reportStats(unsigned int frameNumber, osg::Stats *stats) const;
 
+    protected:
+        /// @note Returns a null pointer if the object has no shape, which is not cached.
+        osg::ref_ptr<osg::Object> getObject(const std::string& name) override;
+
     private:
+        osg::ref_ptr<BulletShape> loadShape(const std::string& normalized);
+
         osg::ref_ptr<BulletShapeInstance> createInstance(const std::string& name);
 
         osg::ref_ptr<MultiObjectCache> mInstanceCache;
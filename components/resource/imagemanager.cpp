@@ -82,77 +82,76 @@ namespace Resource
     }
 
     osg::ref_ptr<osg::Image> ImageManager::getImage(const std::string &filename)
+    {
+        return osg::ref_ptr<osg::Image>(static_cast<osg::Image*>(getObject(filename).get()));
+    }
+
+    osg::ref_ptr<osg::Object> ImageManager::getObject(const std::string &filename)
     {
         std::string normalized = filename;
         mVFS->normalizeFilename(normalized);
 
-        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(normalized);
-        if (obj)
-            return osg::ref_ptr<osg::Image>(static_cast<osg::Image*>(obj.get()));
-        else
+        return getOrLoad(normalized, [&] { return loadImage(normalized, filename); });
+    }
+
+    osg::ref_ptr<osg::Image> ImageManager::loadImage(const std::string &normalized, const std::string &filename)
+    {
+        Files::IStreamPtr stream;
+        try
         {
-            Files::IStreamPtr stream;
-            try
-            {
-                stream = mVFS->get(normalized.c_str());
-            }
-            catch (std::exception& e)
-            {
-                Log(Debug::Error) << "Failed to open image: " << e.what();
-                mCache->addEntryToObjectCache(normalized, mWarningImage);
-                return mWarningImage;
-            }
+            stream = mVFS->get(normalized.c_str());
+        }
+        catch (std::exception& e)
+        {
+            Log(Debug::Error) << "Failed to open image: " << e.what();
+            return mWarningImage;
+        }
 
-            size_t extPos = normalized.find_last_of('.');
-            std::string ext;
-            if (extPos != std::string::npos && extPos+1 < normalized.size())
-                ext = normalized.substr(extPos+1);
-            osgDB::ReaderWriter* reader = osgDB::Registry::instance()->getReaderWriterForExtension(ext);
-            if (!reader)
-            {
-                Log(Debug::Error) << "Error loading " << filename << ": no readerwriter for '" << ext << "' found";
-                mCache->addEntryToObjectCache(normalized, mWarningImage);
-                return mWarningImage;
-            }
+        size_t extPos = normalized.find_last_of('.');
+        std::string ext;
+        if (extPos != std::string::npos && extPos+1 < normalized.size())
+            ext = normalized.substr(extPos+1);
+        osgDB::ReaderWriter* reader = osgDB::Registry::instance()->getReaderWriterForExtension(ext);
+        if (!reader)
+        {
+            Log(Debug::Error) << "Error loading " << filename << ": no readerwriter for '" << ext << "' found";
+            return mWarningImage;
+        }
+
+        osgDB::ReaderWriter::ReadResult result = reader->readImage(*stream, mOptions);
+        if (!result.success())
+        {
+            Log(Debug::Error) << "Error loading " << filename << ": " << result.message() << " code " << result.status();
+            return mWarningImage;
+        }
 
-            osgDB::ReaderWriter::ReadResult result = reader->readImage(*stream, mOptions);
-            if (!result.success())
+        osg::ref_ptr<osg::Image> image = result.getImage();
+
+        image->setFileName(normalized);
+        if (!checkSupported(image, filename))
+        {
+            static bool uncompress = (getenv("OPENMW_DECOMPRESS_TEXTURES") != 0);
+            if (!uncompress)
             {
-                Log(Debug::Error) << "Error loading " << filename << ": " << result.message() << " code " << result.status();
-                mCache->addEntryToObjectCache(normalized, mWarningImage);
+                Log(Debug::Error) << "Error loading " << filename << ": no S3TC texture compression support installed";
                 return mWarningImage;
             }
-
-            osg::ref_ptr<osg::Image> image = result.getImage();
-
-            image->setFileName(normalized);
-            if (!checkSupported(image, filename))
+            else
             {
-                static bool uncompress = (getenv("OPENMW_DECOMPRESS_TEXTURES") != 0);
-                if (!uncompress)
-                {
-                    Log(Debug::Error) << "Error loading " << filename << ": no S3TC texture compression support installed";
-                    mCache->addEntryToObjectCache(normalized, mWarningImage);
-                    return mWarningImage;
-                }
-                else
-                {
-                    // decompress texture in software if not supported by GPU
-                    // requires update to getColor() to be released with OSG 3.6
-                    osg::ref_ptr<osg::Image> newImage = new osg::Image;
-                    newImage->setFileName(image->getFileName());
-                    newImage->allocateImage(image->s(), image->t(), image->r(), image->isImageTranslucent() ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE);
-                    for (int s=0; s<image->s(); ++s)
-                        for (int t=0; t<image->t(); ++t)
-                            for (int r=0; r<image->r(); ++r)
-                                newImage->setColor(image->getColor(s,t,r), s,t,r);
-                    image = newImage;
-                }
+                // decompress texture in software if not supported by GPU
+                // requires update to getColor() to be released with OSG 3.6
+                osg::ref_ptr<osg::Image> newImage = new osg::Image;
+                newImage->setFileName(image->getFileName());
+                newImage->allocateImage(image->s(), image->t(), image->r(), image->isImageTranslucent() ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE);
+                for (int s=0; s<image->s(); ++s)
+                    for (int t=0; t<image->t(); ++t)
+                        for (int r=0; r<image->r(); ++r)
+                            newImage->setColor(image->getColor(s,t,r), s,t,r);
+                image = newImage;
             }
-
-            mCache->addEntryToObjectCache(normalized, image);
-            return image;
         }
+
+        return image;
     }
 
     osg::Image *ImageManager::getWarningImage()
@@ -34,7 +34,12 @@ namespace Resource
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const;
 
+    protected:
+        osg::ref_ptr<osg::Object> getObject(const std::string& filename) override;
+
     private:
+        osg::ref_ptr<osg::Image> loadImage(const std::string& normalized, const std::string& filename);
+
         osg::ref_ptr<osg::Image> mWarningImage;
         osg::ref_ptr<osgDB::Options> mOptions;
 
@@ -44,16 +44,16 @@ namespace Resource
 
     Nif::NIFFilePtr NifFileManager::get(const std::string &name)
     {
-        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(name);
-        if (obj)
-            return static_cast<NifFileHolder*>(obj.get())->mNifFile;
-        else
-        {
+        osg::ref_ptr<osg::Object> obj = getObject(name);
+        return static_cast<NifFileHolder*>(obj.get())->mNifFile;
+    }
+
+    osg::ref_ptr<osg::Object> NifFileManager::getObject(const std::string &name)
+    {
+        return getOrLoad(name, [&] {
             Nif::NIFFilePtr file (new Nif::NIFFile(mVFS->get(name), name));
-            obj = new NifFileHolder(file);
-            mCache->addEntryToObjectCache(name, obj);
-            return file;
-        }
+            return osg::ref_ptr<NifFileHolder>(new NifFileHolder(file));
+        });
     }
 
     void NifFileManager::reportStats(unsigned int frameNumber, osg::Stats *stats) const
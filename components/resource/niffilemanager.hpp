@@ -24,6 +24,9 @@ namespace Resource
         Nif::NIFFilePtr get(const std::string& name);
 
         void reportStats(unsigned int frameNumber, osg::Stats *stats) const;
+
+    protected:
+        osg::ref_ptr<osg::Object> getObject(const std::string& name) override;
     };
 
 }
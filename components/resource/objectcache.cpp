@@ -0,0 +1,77 @@
+#include "objectcache.hpp"
+
+#include <osg/Geometry>
+#include <osg/Image>
+#include <osg/NodeVisitor>
+
+namespace
+{
+
+    /// Assumed size of objects we can not look into, and of the bookkeeping of each node in a scene graph.
+    const std::size_t sObjectOverhead = 256;
+
+    class EstimateSizeVisitor : public osg::NodeVisitor
+    {
+    public:
+        EstimateSizeVisitor()
+            : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            , mSize(0)
+        {
+        }
+
+        void apply(osg::Node& node) override
+        {
+            mSize += sObjectOverhead;
+            traverse(node);
+        }
+
+        void apply(osg::Drawable& drawable) override
+        {
+            mSize += sObjectOverhead;
+
+            osg::Geometry* geometry = drawable.asGeometry();
+            if (!geometry)
+                return;
+
+            osg::Geometry::ArrayList arrays;
+            geometry->getArrayList(arrays);
+            for (const osg::ref_ptr<osg::Array>& array : arrays)
+            {
+                if (array)
+                    mSize += array->getTotalDataSize();
+            }
+
+            for (unsigned int i = 0; i < geometry->getNumPrimitiveSets(); ++i)
+            {
+                const osg::DrawElements* elements = geometry->getPrimitiveSet(i)->getDrawElements();
+                if (elements)
+                    mSize += elements->getTotalDataSize();
+            }
+        }
+
+        std::size_t mSize;
+    };
+
+}
+
+namespace Resource
+{
+
+    std::size_t estimateObjectSize(const osg::Object& object)
+    {
+        if (const osg::Image* image = dynamic_cast<const osg::Image*>(&object))
+            return sObjectOverhead + image->getTotalSizeInBytesIncludingMipmaps();
+
+        if (const osg::Node* constNode = dynamic_cast<const osg::Node*>(&object))
+        {
+            // const-trickery required because there is no const version of NodeVisitor
+            osg::Node* node = const_cast<osg::Node*>(constNode);
+            EstimateSizeVisitor visitor;
+            node->accept(visitor);
+            return visitor.mSize;
+        }
+
+        return sObjectOverhead;
+    }
+
+}
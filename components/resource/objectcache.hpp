@@ -3,6 +3,9 @@
 // - removeExpiredObjectsInCache no longer keeps a lock while the unref happens.
 // - template allows customized KeyType.
 // - objects with uninitialized time stamp are not removed.
+// - the cache is split into shards with separate locks, so concurrent lookups of different keys rarely wait for each other.
+// - optional memory budget, least recently used objects without external references are evicted when it is exceeded.
+// - hit, miss and eviction counters.
 
 /* -*-c++-*- OpenSceneGraph - Copyright (C) 1998-2006 Robert Osfield
  *
@@ -24,8 +27,18 @@
 #include <osg/ref_ptr>
 #include <osg/Node>
 
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace osg
 {
@@ -36,13 +49,67 @@ namespace osg
 
 namespace Resource {
 
+/// Estimate the memory used by an object in a resource cache, in bytes.
+/// @note Counts vertex and index data of geometry and image data, other objects are assumed to be small.
+std::size_t estimateObjectSize(const osg::Object& object);
+
+/// Counters of one or more object caches.
+struct CacheStats
+{
+    std::size_t mHits = 0;
+    std::size_t mMisses = 0;
+    std::size_t mEvictions = 0;
+    /// Estimated memory used by the objects of caches that have a memory budget, in bytes.
+    std::size_t mSize = 0;
+};
+
+/// Selects the shard of a GenericObjectCache for a key by its hash.
+/// @note Specialize this for key types that std::hash does not support.
+template <typename KeyType>
+struct ObjectCacheShard
+{
+    static std::size_t get(const KeyType& key) { return std::hash<KeyType>()(key); }
+};
+
+template <typename First, typename Second>
+struct ObjectCacheShard<std::pair<First, Second> >
+{
+    static std::size_t get(const std::pair<First, Second>& key)
+    {
+        return ObjectCacheShard<First>::get(key.first) * 31 + ObjectCacheShard<Second>::get(key.second);
+    }
+};
+
+template <typename... Types>
+struct ObjectCacheShard<std::tuple<Types...> >
+{
+    static std::size_t get(const std::tuple<Types...>& key)
+    {
+        return combine(key, std::index_sequence_for<Types...>());
+    }
+
+private:
+    template <std::size_t... Indices>
+    static std::size_t combine(const std::tuple<Types...>& key, std::index_sequence<Indices...>)
+    {
+        std::size_t result = 0;
+        for (std::size_t hash : {ObjectCacheShard<Types>::get(std::get<Indices>(key))...})
+            result = result * 31 + hash;
+        return result;
+    }
+};
+
 template <typename KeyType>
 class GenericObjectCache : public osg::Referenced
 {
     public:
 
         GenericObjectCache()
-            : osg::Referenced(true) {}
+            : osg::Referenced(true)
+            , _memoryBudget(0)
+            , _size(0)
+            , _epoch(0)
+            , _evictions(0) {}
 
         /** For each object in the cache which has an reference count greater than 1
           * (and therefore referenced by elsewhere in the application) set the time stamp
@@ -52,14 +119,11 @@ class GenericObjectCache : public osg::Referenced
           * The time used should be taken from the FrameStamp::getReferenceTime().*/
         void updateTimeStampOfObjectsInCacheWithExternalReferences(double referenceTime)
         {
-            // look for objects with external references and update their time stamp.
-            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_objectCacheMutex);
-            for(typename ObjectCacheMap::iterator itr=_objectCache.begin(); itr!=_objectCache.end(); ++itr)
+            for (Shard& shard : _shards)
             {
-                // If ref count is greater than 1, the object has an external reference.
-                // If the timestamp is yet to be initialized, it needs to be updated too.
-                if (itr->second.first->referenceCount()>1 || itr->second.second == 0.0)
-                    itr->second.second = referenceTime;
+                OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard._mutex);
+                for (typename ObjectCacheMap::iterator itr = shard._objectCache.begin(); itr != shard._objectCache.end(); ++itr)
+                    updateTimeStamp(itr->second, referenceTime);
             }
         }
 
@@ -70,16 +134,16 @@ class GenericObjectCache : public osg::Referenced
         void removeExpiredObjectsInCache(double expiryTime)
         {
             std::vector<osg::ref_ptr<osg::Object> > objectsToRemove;
+            for (Shard& shard : _shards)
             {
-                OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_objectCacheMutex);
-                // Remove expired entries from object cache
-                typename ObjectCacheMap::iterator oitr = _objectCache.begin();
-                while(oitr != _objectCache.end())
+                OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard._mutex);
+                typename ObjectCacheMap::iterator oitr = shard._objectCache.begin();
+                while (oitr != shard._objectCache.end())
                 {
-                    if (oitr->second.second<=expiryTime)
+                    if (oitr->second._timeStamp <= expiryTime)
                     {
-                        objectsToRemove.push_back(oitr->second.first);
-                        _objectCache.erase(oitr++);
+                        objectsToRemove.push_back(oitr->second._object);
+                        shard._objectCache.erase(oitr++);
                     }
                     else
                         ++oitr;
@@ -89,46 +153,120 @@ class GenericObjectCache : public osg::Referenced
             objectsToRemove.clear();
         }
 
+        /** Update the time stamps of objects with external references and remove expired objects in one pass over each shard,
+          * then evict the least recently used objects without external references while the memory budget is exceeded.
+          * Only one shard is locked at a time. */
+        void updateCache(double referenceTime, double expiryTime)
+        {
+            std::vector<osg::ref_ptr<osg::Object> > objectsToRemove;
+            std::size_t size = 0;
+            ++_epoch;
+            for (Shard& shard : _shards)
+            {
+                OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard._mutex);
+                typename ObjectCacheMap::iterator oitr = shard._objectCache.begin();
+                while (oitr != shard._objectCache.end())
+                {
+                    Item& item = oitr->second;
+                    updateTimeStamp(item, referenceTime);
+                    if (item._timeStamp <= expiryTime)
+                    {
+                        objectsToRemove.push_back(item._object);
+                        shard._objectCache.erase(oitr++);
+                        continue;
+                    }
+
+                    if (_memoryBudget > 0)
+                    {
+                        if (item._size == 0)
+                            item._size = estimateObjectSize(*item._object);
+                        size += item._size;
+                    }
+                    ++oitr;
+                }
+            }
+
+            if (_memoryBudget > 0 && size > _memoryBudget)
+                evict(size, objectsToRemove);
+
+            _size = size;
+
+            // note, actual unref happens outside of the lock
+            objectsToRemove.clear();
+        }
+
         /** Remove all objects in the cache regardless of having external references or expiry times.*/
         void clear()
         {
-            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_objectCacheMutex);
-            _objectCache.clear();
+            for (Shard& shard : _shards)
+            {
+                OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard._mutex);
+                shard._objectCache.clear();
+            }
+            _size = 0;
         }
 
         /** Add a key,object,timestamp triple to the Registry::ObjectCache.*/
         void addEntryToObjectCache(const KeyType& key, osg::Object* object, double timestamp = 0.0)
         {
-            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_objectCacheMutex);
-            _objectCache[key]=ObjectTimeStampPair(object,timestamp);
+            Shard& shard = getShard(key);
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard._mutex);
+            shard._objectCache[key] = Item(object, timestamp, nextAccess(shard));
         }
 
         /** Remove Object from cache.*/
         void removeFromObjectCache(const KeyType& key)
         {
-            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_objectCacheMutex);
-            typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr!=_objectCache.end()) _objectCache.erase(itr);
+            Shard& shard = getShard(key);
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard._mutex);
+            typename ObjectCacheMap::iterator itr = shard._objectCache.find(key);
+            if (itr!=shard._objectCache.end()) shard._objectCache.erase(itr);
         }
 
         /** Get an ref_ptr<Object> from the object cache*/
         osg::ref_ptr<osg::Object> getRefFromObjectCache(const KeyType& key)
         {
-            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_objectCacheMutex);
-            typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr!=_objectCache.end())
-                return itr->second.first;
+            Shard& shard = getShard(key);
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard._mutex);
+            typename ObjectCacheMap::iterator itr = shard._objectCache.find(key);
+            if (itr!=shard._objectCache.end())
+            {
+                ++shard._hits;
+                itr->second._lastAccess = nextAccess(shard);
+                return itr->second._object;
+            }
+            else
+            {
+                ++shard._misses;
+                return 0;
+            }
+        }
+
+        /** Get an ref_ptr<Object> from the object cache without counting a hit or miss,
+          * for checking again after a miss was already counted. */
+        osg::ref_ptr<osg::Object> peekRefFromObjectCache(const KeyType& key)
+        {
+            Shard& shard = getShard(key);
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard._mutex);
+            typename ObjectCacheMap::iterator itr = shard._objectCache.find(key);
+            if (itr!=shard._objectCache.end())
+            {
+                itr->second._lastAccess = nextAccess(shard);
+                return itr->second._object;
+            }
             else return 0;
         }
 
         /** Check if an object is in the cache, and if it is, update its usage time stamp. */
         bool checkInObjectCache(const KeyType& key, double timeStamp)
         {
-            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_objectCacheMutex);
-            typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr!=_objectCache.end())
+            Shard& shard = getShard(key);
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard._mutex);
+            typename ObjectCacheMap::iterator itr = shard._objectCache.find(key);
+            if (itr!=shard._objectCache.end())
             {
-                itr->second.second = timeStamp;
+                itr->second._timeStamp = timeStamp;
+                itr->second._lastAccess = nextAccess(shard);
                 return true;
             }
             else return false;
@@ -137,26 +275,32 @@ class GenericObjectCache : public osg::Referenced
         /** call releaseGLObjects on all objects attached to the object cache.*/
         void releaseGLObjects(osg::State* state)
         {
-            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_objectCacheMutex);
-            for(typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
+            for (Shard& shard : _shards)
             {
-                osg::Object* object = itr->second.first.get();
-                object->releaseGLObjects(state);
+                OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard._mutex);
+                for (typename ObjectCacheMap::iterator itr = shard._objectCache.begin(); itr != shard._objectCache.end(); ++itr)
+                {
+                    osg::Object* object = itr->second._object.get();
+                    object->releaseGLObjects(state);
+                }
             }
         }
 
         /** call node->accept(nv); for all nodes in the objectCache. */
         void accept(osg::NodeVisitor& nv)
         {
-            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_objectCacheMutex);
-            for(typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
+            for (Shard& shard : _shards)
             {
-                osg::Object* object = itr->second.first.get();
-                if (object)
+                OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard._mutex);
+                for (typename ObjectCacheMap::iterator itr = shard._objectCache.begin(); itr != shard._objectCache.end(); ++itr)
                 {
-                    osg::Node* node = dynamic_cast<osg::Node*>(object);
-                    if (node)
-                        node->accept(nv);
+                    osg::Object* object = itr->second._object.get();
+                    if (object)
+                    {
+                        osg::Node* node = dynamic_cast<osg::Node*>(object);
+                        if (node)
+                            node->accept(nv);
+                    }
                 }
             }
         }
@@ -165,27 +309,149 @@ class GenericObjectCache : public osg::Referenced
         template <class Functor>
         void call(Functor& f)
         {
-            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_objectCacheMutex);
-            for (typename ObjectCacheMap::iterator it = _objectCache.begin(); it != _objectCache.end(); ++it)
-                f(it->second.first.get());
+            for (Shard& shard : _shards)
+            {
+                OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard._mutex);
+                for (typename ObjectCacheMap::iterator it = shard._objectCache.begin(); it != shard._objectCache.end(); ++it)
+                    f(it->second._object.get());
+            }
         }
 
         /** Get the number of objects in the cache. */
         unsigned int getCacheSize() const
         {
-            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_objectCacheMutex);
-            return _objectCache.size();
+            unsigned int size = 0;
+            for (const Shard& shard : _shards)
+            {
+                OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard._mutex);
+                size += shard._objectCache.size();
+            }
+            return size;
+        }
+
+        /** Set the estimated memory the objects in the cache may use, in bytes. 0 means no limit.
+          * @note The budget is enforced by updateCache(), and objects with external references are never evicted. */
+        void setMemoryBudget(std::size_t budget)
+        {
+            _memoryBudget = budget;
+        }
+
+        /** Add the counters of this cache to \a stats. */
+        void getStats(CacheStats& stats) const
+        {
+            for (const Shard& shard : _shards)
+            {
+                OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard._mutex);
+                stats.mHits += shard._hits;
+                stats.mMisses += shard._misses;
+            }
+            stats.mEvictions += _evictions;
+            stats.mSize += _size;
         }
 
     protected:
 
         virtual ~GenericObjectCache() {}
 
-        typedef std::pair<osg::ref_ptr<osg::Object>, double >           ObjectTimeStampPair;
-        typedef std::map<KeyType, ObjectTimeStampPair >             ObjectCacheMap;
+        struct Item
+        {
+            Item() : _timeStamp(0.0), _size(0), _lastAccess(0) {}
+            Item(osg::Object* object, double timeStamp, std::uint64_t lastAccess)
+                : _object(object), _timeStamp(timeStamp), _size(0), _lastAccess(lastAccess) {}
+
+            osg::ref_ptr<osg::Object> _object;
+            double _timeStamp;
+            /// Estimated memory used by the object, 0 until estimated by updateCache() with a memory budget.
+            std::size_t _size;
+            /// Value of nextAccess() when the object was last requested.
+            std::uint64_t _lastAccess;
+        };
+
+        typedef std::map<KeyType, Item> ObjectCacheMap;
+
+        /// The counters are guarded by _mutex, so lookups of different shards don't contend on them.
+        struct Shard
+        {
+            Shard() : _accessCount(0), _hits(0), _misses(0) {}
+
+            ObjectCacheMap _objectCache;
+            std::uint32_t _accessCount;
+            std::size_t _hits;
+            std::size_t _misses;
+            mutable OpenThreads::Mutex _mutex;
+        };
+
+        static const std::size_t sNumShards = 16;
+
+        Shard& getShard(const KeyType& key)
+        {
+            return _shards[ObjectCacheShard<KeyType>::get(key) % sNumShards];
+        }
+
+        /** Order of an access to \a shard, exact between calls of updateCache() and within a shard.
+          * @note Must be called with the lock of \a shard held. */
+        std::uint64_t nextAccess(Shard& shard) const
+        {
+            return (static_cast<std::uint64_t>(_epoch) << 32) | ++shard._accessCount;
+        }
+
+        static void updateTimeStamp(Item& item, double referenceTime)
+        {
+            // If ref count is greater than 1, the object has an external reference.
+            // If the timestamp is yet to be initialized, it needs to be updated too.
+            if (item._object->referenceCount()>1 || item._timeStamp == 0.0)
+                item._timeStamp = referenceTime;
+        }
+
+        /** Remove the least recently used objects without external references until \a size is within the memory budget. */
+        void evict(std::size_t& size, std::vector<osg::ref_ptr<osg::Object> >& objectsToRemove)
+        {
+            struct Candidate
+            {
+                std::uint64_t _lastAccess;
+                Shard* _shard;
+                KeyType _key;
+            };
+
+            std::vector<Candidate> candidates;
+            for (Shard& shard : _shards)
+            {
+                OpenThreads::ScopedLock<OpenThreads::Mutex> lock(shard._mutex);
+                for (typename ObjectCacheMap::const_iterator itr = shard._objectCache.begin(); itr != shard._objectCache.end(); ++itr)
+                {
+                    if (itr->second._object->referenceCount() <= 1)
+                        candidates.push_back(Candidate {itr->second._lastAccess, &shard, itr->first});
+                }
+            }
+
+            std::sort(candidates.begin(), candidates.end(),
+                [] (const Candidate& lhs, const Candidate& rhs) { return lhs._lastAccess < rhs._lastAccess; });
+
+            for (const Candidate& candidate : candidates)
+            {
+                if (size <= _memoryBudget)
+                    break;
+
+                OpenThreads::ScopedLock<OpenThreads::Mutex> lock(candidate._shard->_mutex);
+                typename ObjectCacheMap::iterator itr = candidate._shard->_objectCache.find(candidate._key);
+                // skip objects that were requested or replaced since we looked
+                if (itr == candidate._shard->_objectCache.end() || itr->second._lastAccess != candidate._lastAccess
+                        || itr->second._object->referenceCount() > 1)
+                    continue;
+
+                size -= std::min(size, itr->second._size);
+                objectsToRemove.push_back(itr->second._object);
+                candidate._shard->_objectCache.erase(itr);
+                ++_evictions;
+            }
+        }
 
-        ObjectCacheMap                          _objectCache;
-        mutable OpenThreads::Mutex              _objectCacheMutex;
+        Shard                                   _shards[sNumShards];
+        std::atomic<std::size_t>                _memoryBudget;
+        std::atomic<std::size_t>                _size;
+        /// Number of calls of updateCache(), only changed by the thread that updates the cache.
+        std::atomic<std::uint32_t>              _epoch;
+        std::atomic<std::size_t>                _evictions;
 
 };
 
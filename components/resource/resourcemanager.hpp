@@ -1,9 +1,15 @@
 #ifndef OPENMW_COMPONENTS_RESOURCE_MANAGER_H
 #define OPENMW_COMPONENTS_RESOURCE_MANAGER_H
 
+#include <future>
+
 #include <osg/ref_ptr>
+#include <osg/observer_ptr>
+
+#include <components/sceneutil/workqueue.hpp>
 
 #include "objectcache.hpp"
+#include "singleflight.hpp"
 
 namespace VFS
 {
@@ -28,6 +34,16 @@ namespace Resource
         virtual void setExpiryDelay(double expiryDelay) {}
         virtual void reportStats(unsigned int frameNumber, osg::Stats* stats) const {}
         virtual void releaseGLObjects(osg::State* state) {}
+        /// Queue for the loads started by getAsync(). Without one, getAsync() loads synchronously.
+        virtual void setWorkQueue(SceneUtil::WorkQueue* workQueue) {}
+        /// Number of resources that are being loaded right now.
+        virtual std::size_t getNumLoadsInFlight() const { return 0; }
+        /// Number of requests that waited for another thread's load of the same resource instead of loading it again.
+        virtual std::size_t getNumLoadsShared() const { return 0; }
+        /// Estimated memory the cached objects may use, in bytes. 0 means no limit.
+        virtual void setMemoryBudget(std::size_t budget) {}
+        /// Add the counters of the cache to \a stats.
+        virtual void getCacheStats(CacheStats& stats) const {}
     };
 
     /// @brief Base class for managers that require a virtual file system and object cache.
@@ -50,8 +66,7 @@ namespace Resource
         /// Clear cache entries that have not been referenced for longer than expiryDelay.
         virtual void updateCache(double referenceTime)
         {
-            mCache->updateTimeStampOfObjectsInCacheWithExternalReferences(referenceTime);
-            mCache->removeExpiredObjectsInCache(referenceTime - mExpiryDelay);
+            mCache->updateCache(referenceTime, referenceTime - mExpiryDelay);
         }
 
         /// Clear all cache entries.
@@ -66,10 +81,104 @@ namespace Resource
 
         virtual void releaseGLObjects(osg::State* state) { mCache->releaseGLObjects(state); }
 
+        virtual void setWorkQueue(SceneUtil::WorkQueue* workQueue) { mWorkQueue = workQueue; }
+
+        virtual std::size_t getNumLoadsInFlight() const { return mLoads.getNumInFlight(); }
+
+        virtual std::size_t getNumLoadsShared() const { return mLoads.getNumShared(); }
+
+        virtual void setMemoryBudget(std::size_t budget) { mCache->setMemoryBudget(budget); }
+
+        virtual void getCacheStats(CacheStats& stats) const { mCache->getStats(stats); }
+
+        /// Start loading the object for \a key on the work queue, and return a future for the loaded object.
+        /// @note A load of the same key that is already in flight is not repeated.
+        /// @note Pass the key in its cached (i.e. normalized) form, or the cache lookup on the calling thread misses.
+        std::shared_future<osg::ref_ptr<osg::Object> > getAsync(const KeyType& key)
+        {
+            std::promise<osg::ref_ptr<osg::Object> > promise;
+            std::shared_future<osg::ref_ptr<osg::Object> > future = promise.get_future().share();
+
+            osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(key);
+            osg::ref_ptr<SceneUtil::WorkQueue> workQueue;
+            if (!obj && mWorkQueue.lock(workQueue))
+            {
+                workQueue->addWorkItem(new LoadItem(this, key, std::move(promise)));
+                return future;
+            }
+
+            try
+            {
+                promise.set_value(obj ? obj : getObject(key));
+            }
+            catch (...)
+            {
+                promise.set_exception(std::current_exception());
+            }
+            return future;
+        }
+
     protected:
+        /// Get the object for \a key, loading it if it's not in the cache. Used by getAsync(), must be thread safe.
+        virtual osg::ref_ptr<osg::Object> getObject(const KeyType& key) { return mCache->getRefFromObjectCache(key); }
+
+        /// Return the cached object for \a key, or call \a load to create it and add it to the cache.
+        /// @par Concurrent requests for a key that is not cached yet share a single call of \a load.
+        /// If \a load returns nullptr, nothing is added to the cache.
+        template <class Load>
+        osg::ref_ptr<osg::Object> getOrLoad(const KeyType& key, Load&& load)
+        {
+            osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(key);
+            if (obj)
+                return obj;
+
+            return mLoads.run(key, [&] () -> osg::ref_ptr<osg::Object>
+            {
+                // another thread may have finished loading it since we looked
+                osg::ref_ptr<osg::Object> loaded = mCache->peekRefFromObjectCache(key);
+                if (!loaded)
+                {
+                    loaded = load();
+                    if (loaded)
+                        mCache->addEntryToObjectCache(key, loaded);
+                }
+                return loaded;
+            });
+        }
+
         const VFS::Manager* mVFS;
         osg::ref_ptr<CacheType> mCache;
         double mExpiryDelay;
+
+    private:
+        class LoadItem : public SceneUtil::WorkItem
+        {
+        public:
+            LoadItem(GenericResourceManager* manager, const KeyType& key, std::promise<osg::ref_ptr<osg::Object> >&& promise)
+                : mManager(manager), mKey(key), mPromise(std::move(promise))
+            {
+            }
+
+            virtual void doWork()
+            {
+                try
+                {
+                    mPromise.set_value(mManager->getObject(mKey));
+                }
+                catch (...)
+                {
+                    mPromise.set_exception(std::current_exception());
+                }
+            }
+
+        private:
+            GenericResourceManager* mManager;
+            KeyType mKey;
+            std::promise<osg::ref_ptr<osg::Object> > mPromise;
+        };
+
+        SingleFlight<KeyType, osg::ref_ptr<osg::Object> > mLoads;
+        osg::observer_ptr<SceneUtil::WorkQueue> mWorkQueue;
     };
 
 
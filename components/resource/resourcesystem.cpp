@@ -1,17 +1,71 @@
 #include "resourcesystem.hpp"
 
 #include <algorithm>
+#include <atomic>
+
+#include <osg/Stats>
+
+#include <components/debug/debuglog.hpp>
+#include <components/sceneutil/workqueue.hpp>
+#include <components/vfs/archive.hpp>
+#include <components/vfs/manager.hpp>
 
 #include "scenemanager.hpp"
 #include "imagemanager.hpp"
 #include "niffilemanager.hpp"
 #include "keyframemanager.hpp"
 
+namespace
+{
+    class PrefetchFilesWorkItem : public SceneUtil::WorkItem
+    {
+    public:
+        PrefetchFilesWorkItem(const VFS::Manager* vfs, std::vector<std::string> names)
+            : mVFS(vfs)
+            , mNames(std::move(names))
+            , mAbort(false)
+        {
+        }
+
+        virtual void doWork()
+        {
+            for (const std::string& name : mNames)
+            {
+                if (mAbort)
+                    return;
+                // Missing files are reported by the loader that needs them
+                if (!mVFS->exists(name))
+                    continue;
+                try
+                {
+                    // The stream itself is not needed, opening the file is enough to put it into the archive cache
+                    mVFS->get(name);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << "Warning: Failed to prefetch " << name << ": " << e.what();
+                }
+            }
+        }
+
+        virtual void abort()
+        {
+            mAbort = true;
+        }
+
+    private:
+        const VFS::Manager* mVFS;
+        const std::vector<std::string> mNames;
+        std::atomic<bool> mAbort;
+    };
+}
+
 namespace Resource
 {
 
     ResourceSystem::ResourceSystem(const VFS::Manager *vfs)
         : mVFS(vfs)
+        , mMemoryBudget(0)
     {
         mNifFileManager.reset(new NifFileManager(vfs));
         mKeyframeManager.reset(new KeyframeManager(vfs));
@@ -74,9 +128,28 @@ namespace Resource
             (*it)->clearCache();
     }
 
+    void ResourceSystem::setMemoryBudget(std::size_t budget)
+    {
+        mMemoryBudget = budget;
+        for (std::vector<BaseResourceManager*>::iterator it = mResourceManagers.begin(); it != mResourceManagers.end(); ++it)
+            (*it)->setMemoryBudget(budget);
+    }
+
+    void ResourceSystem::setWorkQueue(SceneUtil::WorkQueue *workQueue)
+    {
+        mWorkQueue = workQueue;
+        for (std::vector<BaseResourceManager*>::iterator it = mResourceManagers.begin(); it != mResourceManagers.end(); ++it)
+            (*it)->setWorkQueue(workQueue);
+    }
+
     void ResourceSystem::addResourceManager(BaseResourceManager *resourceMgr)
     {
         mResourceManagers.push_back(resourceMgr);
+        resourceMgr->setMemoryBudget(mMemoryBudget);
+
+        osg::ref_ptr<SceneUtil::WorkQueue> workQueue;
+        if (mWorkQueue.lock(workQueue))
+            resourceMgr->setWorkQueue(workQueue);
     }
 
     void ResourceSystem::removeResourceManager(BaseResourceManager *resourceMgr)
@@ -91,10 +164,52 @@ namespace Resource
         return mVFS;
     }
 
+    std::vector<osg::ref_ptr<SceneUtil::WorkItem>> ResourceSystem::prefetchFiles(const std::vector<std::string>& names) const
+    {
+        std::vector<osg::ref_ptr<SceneUtil::WorkItem>> items;
+        osg::ref_ptr<SceneUtil::WorkQueue> workQueue;
+        if (names.empty() || mVFS->getArchiveCacheSize() == 0 || !mWorkQueue.lock(workQueue))
+            return items;
+
+        // One item per thread, so the files are inflated in parallel without queueing an item for every file
+        const std::size_t numItems = std::min<std::size_t>(names.size(), workQueue->getNumThreads());
+        for (std::size_t i = 0; i < numItems; ++i)
+        {
+            std::vector<std::string> itemNames;
+            for (std::size_t j = i; j < names.size(); j += numItems)
+                itemNames.push_back(names[j]);
+            items.emplace_back(new PrefetchFilesWorkItem(mVFS, std::move(itemNames)));
+            workQueue->addWorkItem(items.back());
+        }
+        return items;
+    }
+
     void ResourceSystem::reportStats(unsigned int frameNumber, osg::Stats *stats) const
     {
+        std::size_t loadsInFlight = 0;
+        std::size_t loadsShared = 0;
+        CacheStats cacheStats;
         for (std::vector<BaseResourceManager*>::const_iterator it = mResourceManagers.begin(); it != mResourceManagers.end(); ++it)
+        {
             (*it)->reportStats(frameNumber, stats);
+            loadsInFlight += (*it)->getNumLoadsInFlight();
+            loadsShared += (*it)->getNumLoadsShared();
+            (*it)->getCacheStats(cacheStats);
+        }
+
+        stats->setAttribute(frameNumber, "Loading", loadsInFlight);
+        stats->setAttribute(frameNumber, "Loads Shared", loadsShared);
+        stats->setAttribute(frameNumber, "Cache Hits", cacheStats.mHits);
+        stats->setAttribute(frameNumber, "Cache Misses", cacheStats.mMisses);
+        stats->setAttribute(frameNumber, "Cache Evictions", cacheStats.mEvictions);
+        if (mMemoryBudget > 0)
+            stats->setAttribute(frameNumber, "Cache MB", cacheStats.mSize / (1024.0 * 1024.0));
+
+        VFS::ArchiveCacheStats archiveStats;
+        mVFS->getArchiveCacheStats(archiveStats);
+        stats->setAttribute(frameNumber, "Archive Cache Hits", archiveStats.mHits);
+        stats->setAttribute(frameNumber, "Archive Cache Misses", archiveStats.mMisses);
+        stats->setAttribute(frameNumber, "Archive Cache MB", archiveStats.mSize / (1024.0 * 1024.0));
     }
 
     void ResourceSystem::releaseGLObjects(osg::State *state)
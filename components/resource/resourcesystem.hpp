@@ -2,8 +2,12 @@
 #define OPENMW_COMPONENTS_RESOURCE_RESOURCESYSTEM_H
 
 #include <memory>
+#include <string>
 #include <vector>
 
+#include <osg/observer_ptr>
+#include <osg/ref_ptr>
+
 namespace VFS
 {
     class Manager;
@@ -15,6 +19,12 @@ namespace osg
     class State;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+    class WorkItem;
+}
+
 namespace Resource
 {
 
@@ -56,9 +66,22 @@ namespace Resource
         /// How long to keep objects in cache after no longer being referenced.
         void setExpiryDelay(double expiryDelay);
 
+        /// Estimated memory the objects in the cache of each resource manager may use, in bytes. 0 means no limit.
+        void setMemoryBudget(std::size_t budget);
+
+        /// Set the queue for asynchronous loads of each resource manager, see GenericResourceManager::getAsync.
+        void setWorkQueue(SceneUtil::WorkQueue* workQueue);
+
         /// @note May be called from any thread.
         const VFS::Manager* getVFS() const;
 
+        /// Open the given files on the work queue, spread over its threads, so the compressed ones among them are
+        /// inflated in parallel into the caches of their archives (see VFS::Manager::setArchiveCacheSize).
+        /// @return the work items, which may be waited for or aborted, or nothing if there is no work queue or the
+        /// archive caches are disabled.
+        /// @note May be called from any thread.
+        std::vector<osg::ref_ptr<SceneUtil::WorkItem>> prefetchFiles(const std::vector<std::string>& names) const;
+
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const;
 
         /// Call releaseGLObjects for each resource manager.
@@ -76,6 +99,9 @@ namespace Resource
 
         const VFS::Manager* mVFS;
 
+        osg::observer_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        std::size_t mMemoryBudget;
+
         ResourceSystem(const ResourceSystem&);
         void operator = (const ResourceSystem&);
     };
@@ -467,76 +467,79 @@ namespace Resource
     }
 
     osg::ref_ptr<const osg::Node> SceneManager::getTemplate(const std::string &name)
+    {
+        return osg::ref_ptr<const osg::Node>(static_cast<osg::Node*>(getObject(name).get()));
+    }
+
+    osg::ref_ptr<osg::Object> SceneManager::getObject(const std::string &name)
     {
         std::string normalized = name;
         mVFS->normalizeFilename(normalized);
 
-        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(normalized);
-        if (obj)
-            return osg::ref_ptr<const osg::Node>(static_cast<osg::Node*>(obj.get()));
-        else
+        return getOrLoad(normalized, [&] { return loadTemplate(normalized, name); });
+    }
+
+    osg::ref_ptr<osg::Node> SceneManager::loadTemplate(std::string normalized, const std::string &name)
+    {
+        osg::ref_ptr<osg::Node> loaded;
+        try
         {
-            osg::ref_ptr<osg::Node> loaded;
-            try
-            {
-                Files::IStreamPtr file = mVFS->get(normalized);
+            Files::IStreamPtr file = mVFS->get(normalized);
 
-                loaded = load(file, normalized, mImageManager, mNifFileManager);
-            }
-            catch (std::exception& e)
-            {
-                static const char * const sMeshTypes[] = { "nif", "osg", "osgt", "osgb", "osgx", "osg2" };
+            loaded = load(file, normalized, mImageManager, mNifFileManager);
+        }
+        catch (std::exception& e)
+        {
+            static const char * const sMeshTypes[] = { "nif", "osg", "osgt", "osgb", "osgx", "osg2" };
 
-                for (unsigned int i=0; i<sizeof(sMeshTypes)/sizeof(sMeshTypes[0]); ++i)
+            for (unsigned int i=0; i<sizeof(sMeshTypes)/sizeof(sMeshTypes[0]); ++i)
+            {
+                normalized = "meshes/marker_error." + std::string(sMeshTypes[i]);
+                if (mVFS->exists(normalized))
                 {
-                    normalized = "meshes/marker_error." + std::string(sMeshTypes[i]);
-                    if (mVFS->exists(normalized))
-                    {
-                        Log(Debug::Error) << "Failed to load '" << name << "': " << e.what() << ", using marker_error." << sMeshTypes[i] << " instead";
-                        Files::IStreamPtr file = mVFS->get(normalized);
-                        loaded = load(file, normalized, mImageManager, mNifFileManager);
-                        break;
-                    }
+                    Log(Debug::Error) << "Failed to load '" << name << "': " << e.what() << ", using marker_error." << sMeshTypes[i] << " instead";
+                    Files::IStreamPtr file = mVFS->get(normalized);
+                    loaded = load(file, normalized, mImageManager, mNifFileManager);
+                    break;
                 }
-
-                if (!loaded)
-                    throw;
             }
 
-            // set filtering settings
-            SetFilterSettingsVisitor setFilterSettingsVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
-            loaded->accept(setFilterSettingsVisitor);
-            SetFilterSettingsControllerVisitor setFilterSettingsControllerVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
-            loaded->accept(setFilterSettingsControllerVisitor);
+            if (!loaded)
+                throw;
+        }
 
-            osg::ref_ptr<Shader::ShaderVisitor> shaderVisitor (createShaderVisitor());
-            loaded->accept(*shaderVisitor);
+        // set filtering settings
+        SetFilterSettingsVisitor setFilterSettingsVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
+        loaded->accept(setFilterSettingsVisitor);
+        SetFilterSettingsControllerVisitor setFilterSettingsControllerVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
+        loaded->accept(setFilterSettingsControllerVisitor);
 
-            // share state
-            // do this before optimizing so the optimizer will be able to combine nodes more aggressively
-            // note, because StateSets will be shared at this point, StateSets can not be modified inside the optimizer
-            mSharedStateMutex.lock();
-            mSharedStateManager->share(loaded.get());
-            mSharedStateMutex.unlock();
+        osg::ref_ptr<Shader::ShaderVisitor> shaderVisitor (createShaderVisitor());
+        loaded->accept(*shaderVisitor);
 
-            if (canOptimize(normalized))
-            {
-                SceneUtil::Optimizer optimizer;
-                optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
-
-                static const unsigned int options = getOptimizationOptions();
+        // share state
+        // do this before optimizing so the optimizer will be able to combine nodes more aggressively
+        // note, because StateSets will be shared at this point, StateSets can not be modified inside the optimizer
+        mSharedStateMutex.lock();
+        mSharedStateManager->share(loaded.get());
+        mSharedStateMutex.unlock();
 
-                optimizer.optimize(loaded, options);
-            }
+        if (canOptimize(normalized))
+        {
+            SceneUtil::Optimizer optimizer;
+            optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
 
-            if (mIncrementalCompileOperation)
-                mIncrementalCompileOperation->add(loaded);
-            else
-                loaded->getBound();
+            static const unsigned int options = getOptimizationOptions();
 
-            mCache->addEntryToObjectCache(normalized, loaded);
-            return loaded;
+            optimizer.optimize(loaded, options);
         }
+
+        if (mIncrementalCompileOperation)
+            mIncrementalCompileOperation->add(loaded);
+        else
+            loaded->getBound();
+
+        return loaded;
     }
 
     osg::ref_ptr<osg::Node> SceneManager::cacheInstance(const std::string &name)
@@ -143,7 +143,12 @@ namespace Resource
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
+    protected:
+        osg::ref_ptr<osg::Object> getObject(const std::string& name) override;
+
     private:
+        /// @param normalized Taken by value, the error marker is loaded in its place if the scene fails to load.
+        osg::ref_ptr<osg::Node> loadTemplate(std::string normalized, const std::string& name);
 
         Shader::ShaderVisitor* createShaderVisitor();
 
@@ -0,0 +1,92 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_SINGLEFLIGHT_H
+#define OPENMW_COMPONENTS_RESOURCE_SINGLEFLIGHT_H
+
+#include <exception>
+#include <future>
+#include <map>
+#include <mutex>
+
+namespace Resource
+{
+
+    /// @brief Deduplicates concurrent loads of the same resource.
+    /// @par The first thread to request a key runs the load, any other thread requesting the same key while
+    /// that load is in flight waits for its result (or its exception) instead of loading the resource again.
+    /// @note Thread safe. Loads of different keys run concurrently.
+    template <class KeyType, class ValueType>
+    class SingleFlight
+    {
+    public:
+        SingleFlight()
+            : mNumShared(0)
+        {
+        }
+
+        /// Return load() for \a key, or the result of a load of \a key already in flight on another thread.
+        /// @note \a load must not request the same key from this SingleFlight again.
+        template <class Load>
+        ValueType run(const KeyType& key, Load&& load)
+        {
+            std::promise<ValueType> promise;
+            std::shared_future<ValueType> inFlight;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                typename InFlightMap::iterator found = mInFlight.find(key);
+                if (found != mInFlight.end())
+                {
+                    ++mNumShared;
+                    inFlight = found->second;
+                }
+                else
+                    mInFlight.emplace(key, promise.get_future().share());
+            }
+
+            if (inFlight.valid())
+                return inFlight.get();
+
+            try
+            {
+                ValueType value = load();
+                promise.set_value(value);
+                finish(key);
+                return value;
+            }
+            catch (...)
+            {
+                promise.set_exception(std::current_exception());
+                finish(key);
+                throw;
+            }
+        }
+
+        /// Number of keys currently being loaded.
+        std::size_t getNumInFlight() const
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mInFlight.size();
+        }
+
+        /// Number of requests that waited for a load in flight instead of loading the resource again.
+        std::size_t getNumShared() const
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mNumShared;
+        }
+
+    private:
+        typedef std::map<KeyType, std::shared_future<ValueType> > InFlightMap;
+
+        void finish(const KeyType& key)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mInFlight.erase(key);
+        }
+
+        InFlightMap mInFlight;
+        std::size_t mNumShared;
+        mutable std::mutex mMutex;
+    };
+
+}
+
+#endif
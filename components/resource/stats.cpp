@@ -285,6 +285,15 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "Image",
             "Nif",
             "Keyframe",
+            "Loading",
+            "Loads Shared",
+            "Cache Hits",
+            "Cache Misses",
+            "Cache Evictions",
+            "Cache MB",
+            "Archive Cache Hits",
+            "Archive Cache Misses",
+            "Archive Cache MB",
             "",
             "Terrain Chunk",
             "Terrain Texture",
@@ -293,10 +302,34 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "",
             "UnrefQueue",
             "",
+            "Light Lists",
+            "Light Tests",
+            "Light Cull ms",
+            "",
             "NavMesh UpdateJobs",
+            "NavMesh TilesPerSecond",
+            "NavMesh JobLatency50",
+            "NavMesh JobLatency95",
+            "NavMesh JobLatency99",
+            "NavMesh JobsCancelled",
+            "NavMesh JobsCoalesced",
             "NavMesh CacheSize",
             "NavMesh UsedTiles",
             "NavMesh CachedTiles",
+            "NavMesh DiskTiles",
+            "NavMesh DiskHits",
+            "NavMesh DiskMisses",
+            "NavMesh PathRequests",
+            "NavMesh PathRequestsDone",
+            "",
+            "Physics Actors",
+            "Physics Steps",
+            "Physics Solve ms",
+            "Physics Wait ms",
+            "",
+            "Script Runs",
+            "Script Instructions",
+            "Script Deferred",
         });
 
         static const auto longest = std::max_element(statNames.begin(), statNames.end(),
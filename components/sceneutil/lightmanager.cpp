@@ -1,5 +1,12 @@
 #include "lightmanager.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <osg/Stats>
+#include <osg/Timer>
+
 #include <osgUtil/CullVisitor>
 
 #include <components/sceneutil/util.hpp>
@@ -161,7 +168,13 @@ namespace SceneUtil
     };
 
     LightManager::LightManager()
-        : mStartLight(0)
+        : mNumLightLists(0)
+        , mNumLightTests(0)
+        , mLightListTime(0)
+        , mLastNumLightLists(0)
+        , mLastNumLightTests(0)
+        , mLastLightListTime(0)
+        , mStartLight(0)
         , mLightingMask(~0u)
     {
         setUpdateCallback(new LightManagerUpdateCallback);
@@ -171,6 +184,12 @@ namespace SceneUtil
 
     LightManager::LightManager(const LightManager &copy, const osg::CopyOp &copyop)
         : osg::Group(copy, copyop)
+        , mNumLightLists(0)
+        , mNumLightTests(0)
+        , mLightListTime(0)
+        , mLastNumLightLists(0)
+        , mLastNumLightTests(0)
+        , mLastLightListTime(0)
         , mStartLight(copy.mStartLight)
         , mLightingMask(copy.mLightingMask)
     {
@@ -192,6 +211,13 @@ namespace SceneUtil
         mLights.clear();
         mLightsInViewSpace.clear();
 
+        mLastNumLightLists = mNumLightLists;
+        mLastNumLightTests = mNumLightTests;
+        mLastLightListTime = mLightListTime;
+        mNumLightLists = 0;
+        mNumLightTests = 0;
+        mLightListTime = 0;
+
         // do an occasional cleanup for orphaned lights
         for (int i=0; i<2; ++i)
         {
@@ -262,14 +288,106 @@ namespace SceneUtil
         return mLights;
     }
 
-    const std::vector<LightManager::LightSourceViewBound>& LightManager::getLightsInViewSpace(osg::Camera *camera, const osg::RefMatrix* viewMatrix)
+    namespace
+    {
+        // Below this number of lights, testing all of them is faster than looking them up in the grid
+        const unsigned int sMinLightsForGrid = 16;
+        const int sMaxGridSize = 32;
+
+        /// Test \a bound against \a count light bounds given as arrays of their centers and radii.
+        /// Plain loop over arrays without branches, so that the compiler can vectorize it.
+        template <class T>
+        void intersectBounds(const T* x, const T* y, const T* z, const T* radius, std::size_t count,
+                             const osg::BoundingSphere& bound, unsigned char* hits)
+        {
+            const T cx = bound.center().x();
+            const T cy = bound.center().y();
+            const T cz = bound.center().z();
+            const T cr = bound.radius();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const T dx = x[i] - cx;
+                const T dy = y[i] - cy;
+                const T dz = z[i] - cz;
+                const T r = radius[i] + cr;
+                // same as osg::BoundingSphere::intersects, a negative radius marks an invalid bound
+                hits[i] = (radius[i] >= 0) & (dx*dx + dy*dy + dz*dz <= r*r);
+            }
+        }
+    }
+
+    void LightManager::ViewSpaceLights::buildGrid()
+    {
+        mGridSize = 0;
+        mCellStart.clear();
+        mCellLights.clear();
+
+        if (mBounds.size() < sMinLightsForGrid)
+            return;
+
+        osg::Vec2f min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+        osg::Vec2f max(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
+        for (std::size_t i = 0; i < mBounds.size(); ++i)
+        {
+            if (mRadius[i] < 0)
+                continue;
+            min.x() = std::min(min.x(), float(mX[i] - mRadius[i]));
+            min.y() = std::min(min.y(), float(mY[i] - mRadius[i]));
+            max.x() = std::max(max.x(), float(mX[i] + mRadius[i]));
+            max.y() = std::max(max.y(), float(mY[i] + mRadius[i]));
+        }
+        if (min.x() > max.x())
+            return;
+
+        mGridSize = std::min(sMaxGridSize, static_cast<int>(std::ceil(std::sqrt(static_cast<float>(mBounds.size())))));
+        mGridOrigin = min;
+        mCellSize = osg::Vec2f(std::max((max.x() - min.x()) / mGridSize, 1.f), std::max((max.y() - min.y()) / mGridSize, 1.f));
+
+        // count the lights per cell, then fill the cells
+        mCellStart.assign(mGridSize * mGridSize + 1, 0);
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            std::vector<unsigned int> fill;
+            if (pass == 1)
+            {
+                for (std::size_t cell = 1; cell < mCellStart.size(); ++cell)
+                    mCellStart[cell] += mCellStart[cell - 1];
+                mCellLights.resize(mCellStart.back());
+                fill.assign(mCellStart.begin(), mCellStart.end() - 1);
+            }
+
+            for (std::size_t i = 0; i < mBounds.size(); ++i)
+            {
+                if (mRadius[i] < 0)
+                    continue;
+                const int x0 = osg::clampBetween(int((mX[i] - mRadius[i] - mGridOrigin.x()) / mCellSize.x()), 0, mGridSize - 1);
+                const int x1 = osg::clampBetween(int((mX[i] + mRadius[i] - mGridOrigin.x()) / mCellSize.x()), 0, mGridSize - 1);
+                const int y0 = osg::clampBetween(int((mY[i] - mRadius[i] - mGridOrigin.y()) / mCellSize.y()), 0, mGridSize - 1);
+                const int y1 = osg::clampBetween(int((mY[i] + mRadius[i] - mGridOrigin.y()) / mCellSize.y()), 0, mGridSize - 1);
+                for (int y = y0; y <= y1; ++y)
+                {
+                    for (int x = x0; x <= x1; ++x)
+                    {
+                        const int cell = y * mGridSize + x;
+                        if (pass == 0)
+                            ++mCellStart[cell + 1];
+                        else
+                            mCellLights[fill[cell]++] = i;
+                    }
+                }
+            }
+        }
+    }
+
+    LightManager::ViewSpaceLights& LightManager::getViewSpaceLights(osg::Camera *camera, const osg::RefMatrix* viewMatrix)
     {
         osg::observer_ptr<osg::Camera> camPtr (camera);
-        std::map<osg::observer_ptr<osg::Camera>, LightSourceViewBoundCollection>::iterator it = mLightsInViewSpace.find(camPtr);
+        std::map<osg::observer_ptr<osg::Camera>, ViewSpaceLights>::iterator it = mLightsInViewSpace.find(camPtr);
 
         if (it == mLightsInViewSpace.end())
         {
-            it = mLightsInViewSpace.insert(std::make_pair(camPtr, LightSourceViewBoundCollection())).first;
+            it = mLightsInViewSpace.insert(std::make_pair(camPtr, ViewSpaceLights())).first;
+            ViewSpaceLights& lights = it->second;
 
             for (std::vector<LightSourceTransform>::iterator lightIt = mLights.begin(); lightIt != mLights.end(); ++lightIt)
             {
@@ -280,12 +398,111 @@ namespace SceneUtil
                 LightSourceViewBound l;
                 l.mLightSource = lightIt->mLightSource;
                 l.mViewBound = viewBound;
-                it->second.push_back(l);
+                lights.mBounds.push_back(l);
+
+                lights.mX.push_back(viewBound.center().x());
+                lights.mY.push_back(viewBound.center().y());
+                lights.mZ.push_back(viewBound.center().z());
+                lights.mRadius.push_back(viewBound.radius());
             }
+
+            lights.buildGrid();
         }
         return it->second;
     }
 
+    const std::vector<LightManager::LightSourceViewBound>& LightManager::getLightsInViewSpace(osg::Camera *camera, const osg::RefMatrix* viewMatrix)
+    {
+        return getViewSpaceLights(camera, viewMatrix).mBounds;
+    }
+
+    void LightManager::getLightsIntersecting(osg::Camera* camera, const osg::RefMatrix* viewMatrix, const osg::BoundingSphere& viewBound, LightList& lightList)
+    {
+        const ViewSpaceLights& lights = getViewSpaceLights(camera, viewMatrix);
+        if (!viewBound.valid() || lights.mBounds.empty())
+            return;
+
+        if (lights.mGridSize == 0)
+        {
+            mHits.resize(lights.mBounds.size());
+            intersectBounds(lights.mX.data(), lights.mY.data(), lights.mZ.data(), lights.mRadius.data(), lights.mBounds.size(), viewBound, mHits.data());
+            mNumLightTests += lights.mBounds.size();
+
+            for (std::size_t i = 0; i < lights.mBounds.size(); ++i)
+            {
+                if (mHits[i])
+                    lightList.push_back(&lights.mBounds[i]);
+            }
+            return;
+        }
+
+        const float minX = (viewBound.center().x() - viewBound.radius() - lights.mGridOrigin.x()) / lights.mCellSize.x();
+        const float maxX = (viewBound.center().x() + viewBound.radius() - lights.mGridOrigin.x()) / lights.mCellSize.x();
+        const float minY = (viewBound.center().y() - viewBound.radius() - lights.mGridOrigin.y()) / lights.mCellSize.y();
+        const float maxY = (viewBound.center().y() + viewBound.radius() - lights.mGridOrigin.y()) / lights.mCellSize.y();
+        if (maxX < 0 || maxY < 0 || minX >= lights.mGridSize || minY >= lights.mGridSize)
+            return;
+
+        // clamp before converting, huge bounds would overflow the int
+        const float maxCell = static_cast<float>(lights.mGridSize - 1);
+        const int x0 = static_cast<int>(std::max(0.f, minX));
+        const int x1 = static_cast<int>(std::min(maxCell, maxX));
+        const int y0 = static_cast<int>(std::max(0.f, minY));
+        const int y1 = static_cast<int>(std::min(maxCell, maxY));
+
+        mCandidates.clear();
+        for (int y = y0; y <= y1; ++y)
+        {
+            for (int x = x0; x <= x1; ++x)
+            {
+                const int cell = y * lights.mGridSize + x;
+                mCandidates.insert(mCandidates.end(), lights.mCellLights.begin() + lights.mCellStart[cell],
+                                   lights.mCellLights.begin() + lights.mCellStart[cell + 1]);
+            }
+        }
+
+        // a light can be in several cells, and the lights have to be returned in their original order
+        std::sort(mCandidates.begin(), mCandidates.end());
+        mCandidates.erase(std::unique(mCandidates.begin(), mCandidates.end()), mCandidates.end());
+        mNumLightTests += mCandidates.size();
+
+        const std::size_t count = mCandidates.size();
+        mCandidateX.resize(count);
+        mCandidateY.resize(count);
+        mCandidateZ.resize(count);
+        mCandidateRadius.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const unsigned int light = mCandidates[i];
+            mCandidateX[i] = lights.mX[light];
+            mCandidateY[i] = lights.mY[light];
+            mCandidateZ[i] = lights.mZ[light];
+            mCandidateRadius[i] = lights.mRadius[light];
+        }
+
+        mHits.resize(count);
+        intersectBounds(mCandidateX.data(), mCandidateY.data(), mCandidateZ.data(), mCandidateRadius.data(), count, viewBound, mHits.data());
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (mHits[i])
+                lightList.push_back(&lights.mBounds[mCandidates[i]]);
+        }
+    }
+
+    void LightManager::addLightListTime(double time)
+    {
+        ++mNumLightLists;
+        mLightListTime += time;
+    }
+
+    void LightManager::reportStats(unsigned int frameNumber, osg::Stats* stats) const
+    {
+        stats->setAttribute(frameNumber, "Light Lists", mLastNumLightLists);
+        stats->setAttribute(frameNumber, "Light Tests", mLastNumLightTests);
+        stats->setAttribute(frameNumber, "Light Cull ms", mLastLightListTime * 1000.0);
+    }
+
     class DisableLight : public osg::StateAttribute
     {
     public:
@@ -400,20 +617,16 @@ namespace SceneUtil
         if (!(cv->getTraversalMask() & mLightManager->getLightingMask()))
             return false;
 
-        // Possible optimizations:
-        // - cull list of lights by the camera frustum
-        // - organize lights in a quad tree
-
-
         // update light list if necessary
         // makes sure we don't update it more than once per frame when rendering with multiple cameras
         if (mLastFrameNumber != cv->getTraversalNumber())
         {
             mLastFrameNumber = cv->getTraversalNumber();
 
+            const osg::Timer_t startTick = osg::Timer::instance()->tick();
+
             // Don't use Camera::getViewMatrix, that one might be relative to another camera!
             const osg::RefMatrix* viewMatrix = cv->getCurrentRenderStage()->getInitialViewMatrix();
-            const std::vector<LightManager::LightSourceViewBound>& lights = mLightManager->getLightsInViewSpace(cv->getCurrentCamera(), viewMatrix);
 
             // get the node bounds in view space
             // NB do not node->getBound() * modelView, that would apply the node's transformation twice
@@ -430,16 +643,16 @@ namespace SceneUtil
             transformBoundingSphere(mat, nodeBound);
 
             mLightList.clear();
-            for (unsigned int i=0; i<lights.size(); ++i)
-            {
-                const LightManager::LightSourceViewBound& l = lights[i];
+            mLightManager->getLightsIntersecting(cv->getCurrentCamera(), viewMatrix, nodeBound, mLightList);
 
-                if (mIgnoredLightSources.count(l.mLightSource))
-                    continue;
-
-                if (l.mViewBound.intersects(nodeBound))
-                    mLightList.push_back(&l);
+            if (!mIgnoredLightSources.empty())
+            {
+                mLightList.erase(std::remove_if(mLightList.begin(), mLightList.end(),
+                    [this] (const LightManager::LightSourceViewBound* l) { return mIgnoredLightSources.count(l->mLightSource) != 0; }),
+                    mLightList.end());
             }
+
+            mLightManager->addLightListTime(osg::Timer::instance()->delta_s(startTick, osg::Timer::instance()->tick()));
         }
         if (!mLightList.empty())
         {
@@ -4,11 +4,17 @@
 #include <set>
 
 #include <osg/Light>
+#include <osg/Vec2f>
 
 #include <osg/Group>
 #include <osg/NodeVisitor>
 #include <osg/observer_ptr>
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace osgUtil
 {
     class CullVisitor;
@@ -127,14 +133,57 @@ namespace SceneUtil
 
         typedef std::vector<const LightSourceViewBound*> LightList;
 
+        /// Add the lights whose view space bounds intersect \a viewBound to \a lightList,
+        /// in the same order as they are returned by getLightsInViewSpace().
+        void getLightsIntersecting(osg::Camera* camera, const osg::RefMatrix* viewMatrix, const osg::BoundingSphere& viewBound, LightList& lightList);
+
         osg::ref_ptr<osg::StateSet> getLightListStateSet(const LightList& lightList, unsigned int frameNum);
 
+        /// Internal use only, called by the LightListCallback after updating its light list
+        void addLightListTime(double time);
+
+        void reportStats(unsigned int frameNumber, osg::Stats* stats) const;
+
     private:
         // Lights collected from the scene graph. Only valid during the cull traversal.
         std::vector<LightSourceTransform> mLights;
 
-        typedef std::vector<LightSourceViewBound> LightSourceViewBoundCollection;
-        std::map<osg::observer_ptr<osg::Camera>, LightSourceViewBoundCollection> mLightsInViewSpace;
+        /// The lights in view space of a camera, with a grid over the view space x/y plane
+        /// so that the lights near a node can be found without testing all of them.
+        struct ViewSpaceLights
+        {
+            std::vector<LightSourceViewBound> mBounds;
+
+            // The bounds in structure of arrays layout for the batched intersection test
+            std::vector<osg::BoundingSphere::value_type> mX, mY, mZ, mRadius;
+
+            // The lights in cell i are mCellLights[mCellStart[i]] to mCellLights[mCellStart[i+1]-1]. mGridSize is 0 if there is no grid.
+            int mGridSize;
+            osg::Vec2f mGridOrigin;
+            osg::Vec2f mCellSize;
+            std::vector<unsigned int> mCellStart;
+            std::vector<unsigned int> mCellLights;
+
+            void buildGrid();
+        };
+
+        ViewSpaceLights& getViewSpaceLights(osg::Camera* camera, const osg::RefMatrix* viewMatrix);
+
+        std::map<osg::observer_ptr<osg::Camera>, ViewSpaceLights> mLightsInViewSpace;
+
+        // Scratch space for getLightsIntersecting
+        std::vector<unsigned int> mCandidates;
+        // bounds of mCandidates gathered into contiguous arrays, to test them all in one go
+        std::vector<osg::BoundingSphere::value_type> mCandidateX, mCandidateY, mCandidateZ, mCandidateRadius;
+        std::vector<unsigned char> mHits;
+
+        // Statistics of the light lists updated since the last update()
+        unsigned int mNumLightLists;
+        unsigned int mNumLightTests;
+        double mLightListTime;
+        unsigned int mLastNumLightLists;
+        unsigned int mLastNumLightTests;
+        double mLastLightListTime;
 
         // < Light list hash , StateSet >
         typedef std::map<size_t, osg::ref_ptr<osg::StateSet> > LightStateSetMap;
@@ -1,12 +1,40 @@
 #include "morphgeometry.hpp"
 
+#include <algorithm>
 #include <cassert>
 
 #include <osg/Version>
 
+namespace
+{
+    // Works on the components of the vertices as a flat array, so the compiler can vectorize the loop
+    void accumulate(float* result, const float* offsets, float weight, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            result[i] += offsets[i] * weight;
+    }
+}
+
 namespace SceneUtil
 {
 
+void MorphGeometry::MorphTarget::setOffsets(osg::Vec3Array *offsets)
+{
+    mOffsets = offsets;
+    mBegin = 0;
+    mEnd = 0;
+    if (!offsets)
+        return;
+
+    // Morphs usually move just a part of the mesh, e.g. the mouth or the eyes of a head
+    const osg::Vec3f zero(0, 0, 0);
+    mEnd = offsets->size();
+    while (mBegin < mEnd && (*offsets)[mBegin] == zero)
+        ++mBegin;
+    while (mEnd > mBegin && (*offsets)[mEnd - 1] == zero)
+        --mEnd;
+}
+
 MorphGeometry::MorphGeometry()
     : mLastFrameNumber(0)
     , mDirty(true)
@@ -31,6 +59,8 @@ void MorphGeometry::setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeom)
 
     for (unsigned int i=0; i<2; ++i)
     {
+        mBlendedWeights[i].clear();
+
         mGeometry[i] = new osg::Geometry(*mSourceGeometry, osg::CopyOp::SHALLOW_COPY);
 
         const osg::Geometry& from = *mSourceGeometry;
@@ -160,31 +190,59 @@ void MorphGeometry::cull(osg::NodeVisitor *nv)
     mLastFrameNumber = nv->getTraversalNumber();
     osg::Geometry& geom = *getGeometry(mLastFrameNumber);
 
+    if (blend(mLastFrameNumber % 2))
+    {
+        geom.getVertexArray()->dirty();
+
+#if OSG_MIN_VERSION_REQUIRED(3, 5, 6)
+        geom.dirtyGLObjects();
+#endif
+    }
+
+    nv->pushOntoNodePath(&geom);
+    nv->apply(geom);
+    nv->popFromNodePath();
+}
+
+bool MorphGeometry::blend(unsigned int buffer)
+{
     const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
-    osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
+    osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(mGeometry[buffer]->getVertexArray());
     assert(positionSrc->size() == positionDst->size());
-    for (unsigned int vertex=0; vertex<positionSrc->size(); ++vertex)
-        (*positionDst)[vertex] = (*positionSrc)[vertex];
 
+    // Only the vertices moved by targets with a changed weight need to be blended again
+    std::vector<float>& blendedWeights = mBlendedWeights[buffer];
+    blendedWeights.resize(mMorphTargets.size(), 0.f);
+    unsigned int begin = positionSrc->size();
+    unsigned int end = 0;
     for (unsigned int i=0; i<mMorphTargets.size(); ++i)
     {
-        float weight = mMorphTargets[i].getWeight();
-        if (weight == 0.f)
+        const MorphTarget& target = mMorphTargets[i];
+        if (target.getWeight() == blendedWeights[i])
             continue;
-        const osg::Vec3Array* offsets = mMorphTargets[i].getOffsets();
-        for (unsigned int vertex=0; vertex<positionSrc->size(); ++vertex)
-            (*positionDst)[vertex] += (*offsets)[vertex] * weight;
+        blendedWeights[i] = target.getWeight();
+        begin = std::min(begin, target.getBegin());
+        end = std::max(end, target.getEnd());
     }
+    end = std::min(end, static_cast<unsigned int>(positionSrc->size()));
+    if (begin >= end)
+        return false;
 
-    positionDst->dirty();
+    std::copy(positionSrc->begin() + begin, positionSrc->begin() + end, positionDst->begin() + begin);
 
-#if OSG_MIN_VERSION_REQUIRED(3, 5, 6)
-    geom.dirtyGLObjects();
-#endif
+    for (unsigned int i=0; i<mMorphTargets.size(); ++i)
+    {
+        const MorphTarget& target = mMorphTargets[i];
+        const float weight = target.getWeight();
+        const unsigned int targetBegin = std::max(begin, target.getBegin());
+        const unsigned int targetEnd = std::min(end, target.getEnd());
+        if (weight == 0.f || targetBegin >= targetEnd)
+            continue;
+        accumulate((*positionDst)[targetBegin].ptr(), (*target.getOffsets())[targetBegin].ptr(), weight,
+                   3 * (targetEnd - targetBegin));
+    }
 
-    nv->pushOntoNodePath(&geom);
-    nv->apply(geom);
-    nv->popFromNodePath();
+    return true;
 }
 
 osg::Geometry* MorphGeometry::getGeometry(unsigned int frame) const
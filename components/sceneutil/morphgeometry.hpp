@@ -29,13 +29,19 @@ namespace SceneUtil
         protected:
             osg::ref_ptr<osg::Vec3Array> mOffsets;
             float mWeight;
+            unsigned int mBegin;
+            unsigned int mEnd;
         public:
-            MorphTarget(osg::Vec3Array* offsets, float w = 1.0) : mOffsets(offsets), mWeight(w) {}
+            MorphTarget(osg::Vec3Array* offsets, float w = 1.0) : mWeight(w) { setOffsets(offsets); }
             void setWeight(float weight) { mWeight = weight; }
             float getWeight() const { return mWeight; }
+            /// @note Call setOffsets again after modifying the offsets, to update the range of morphed vertices.
             osg::Vec3Array* getOffsets() { return mOffsets.get(); }
             const osg::Vec3Array* getOffsets() const { return mOffsets.get(); }
-            void setOffsets(osg::Vec3Array* offsets) { mOffsets = offsets; }
+            void setOffsets(osg::Vec3Array* offsets);
+            /// Range of the vertices this target moves, all offsets outside of it are zero.
+            unsigned int getBegin() const { return mBegin; }
+            unsigned int getEnd() const { return mEnd; }
         };
 
         typedef std::vector<MorphTarget> MorphTargetList;
@@ -68,6 +74,10 @@ namespace SceneUtil
     private:
         void cull(osg::NodeVisitor* nv);
 
+        /// Blend the vertices that differ between the weights last blended into \a buffer and the current weights.
+        /// @return false if the buffer is already up to date
+        bool blend(unsigned int buffer);
+
         MorphTargetList mMorphTargets;
 
         osg::ref_ptr<osg::Geometry> mSourceGeometry;
@@ -75,6 +85,9 @@ namespace SceneUtil
         osg::ref_ptr<osg::Geometry> mGeometry[2];
         osg::Geometry* getGeometry(unsigned int frame) const;
 
+        /// Weights of the morph targets last blended into each internal geometry
+        std::vector<float> mBlendedWeights[2];
+
         unsigned int mLastFrameNumber;
         bool mDirty; // Have any morph targets changed?
 
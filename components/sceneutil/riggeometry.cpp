@@ -6,6 +6,7 @@
 
 #include "skeleton.hpp"
 #include "util.hpp"
+#include "workqueue.hpp"
 
 namespace
 {
@@ -30,13 +31,135 @@ namespace
         ptrresult[13] += ptr[13] * weight;
         ptrresult[14] += ptr[14] * weight;
     }
+
+    // The skinning matrices are affine, so these give the same results as osg::Matrixf::preMult and transform3x3 without
+    // dividing by w. The source coordinates are read sequentially, the results are written to the vertices they belong to.
+    void transformPoints(const osg::Matrixf& m, const std::vector<float> (&source)[3], const std::vector<unsigned short>& vertices,
+                         std::size_t begin, std::size_t end, osg::Vec3Array& result)
+    {
+        const float m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+        const float m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+        const float m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+        const float m30 = m(3, 0), m31 = m(3, 1), m32 = m(3, 2);
+        const float* x = source[0].data();
+        const float* y = source[1].data();
+        const float* z = source[2].data();
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            result[vertices[i]].set(m00 * x[i] + m10 * y[i] + m20 * z[i] + m30,
+                                    m01 * x[i] + m11 * y[i] + m21 * z[i] + m31,
+                                    m02 * x[i] + m12 * y[i] + m22 * z[i] + m32);
+        }
+    }
+
+    void transformVectors(const osg::Matrixf& m, const std::vector<float> (&source)[3], const std::vector<unsigned short>& vertices,
+                          std::size_t begin, std::size_t end, osg::Vec3Array& result)
+    {
+        const float m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+        const float m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+        const float m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+        const float* x = source[0].data();
+        const float* y = source[1].data();
+        const float* z = source[2].data();
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            result[vertices[i]].set(m00 * x[i] + m10 * y[i] + m20 * z[i],
+                                    m01 * x[i] + m11 * y[i] + m21 * z[i],
+                                    m02 * x[i] + m12 * y[i] + m22 * z[i]);
+        }
+    }
+
+    void transformTangents(const osg::Matrixf& m, const std::vector<float> (&source)[4], const std::vector<unsigned short>& vertices,
+                           std::size_t begin, std::size_t end, osg::Vec4Array& result)
+    {
+        const float m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+        const float m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+        const float m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+        const float* x = source[0].data();
+        const float* y = source[1].data();
+        const float* z = source[2].data();
+        const float* w = source[3].data();
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            result[vertices[i]].set(m00 * x[i] + m10 * y[i] + m20 * z[i],
+                                    m01 * x[i] + m11 * y[i] + m21 * z[i],
+                                    m02 * x[i] + m12 * y[i] + m22 * z[i],
+                                    w[i]);
+        }
+    }
+
+    // Don't bother the work queue with rigs this small, handing them over costs more than skinning them.
+    const std::size_t sMinWorkQueueVertices = 256;
+
+    osg::ref_ptr<SceneUtil::WorkQueue> sWorkQueue;
 }
 
 namespace SceneUtil
 {
 
+/// Skins one of the double buffered geometries with the matrices of the frame it's drawn in, so drawing it doesn't wait
+/// for the skinning of the other geometry in the next frame.
+class RigGeometry::SkinningWorkItem : public WorkItem
+{
+public:
+    SkinningWorkItem(const RigGeometry* rig)
+        : mRig(rig)
+        , mGeometry(nullptr)
+    {
+        // an idle item counts as done, so waiting for it returns immediately
+        signalDone();
+    }
+
+    /// Weighted bone matrix of each vertex group in mBone2VertexVector. Must not be changed until the item is done.
+    std::vector<osg::Matrixf>& getMatrices() { return mMatrices; }
+
+    void setGeometry(osg::Geometry* geometry)
+    {
+        mGeometry = geometry;
+    }
+
+    void skin()
+    {
+        mRig->skin(*mGeometry, mMatrices);
+    }
+
+    void start()
+    {
+        mDone.exchange(0);
+    }
+
+    virtual void doWork()
+    {
+        skin();
+    }
+
+private:
+    const RigGeometry* mRig;
+    osg::Geometry* mGeometry;
+    std::vector<osg::Matrixf> mMatrices;
+};
+
+class WaitForSkinningCallback : public osg::Drawable::DrawCallback
+{
+public:
+    WaitForSkinningCallback(WorkItem* skinningWorkItem)
+        : mSkinningWorkItem(skinningWorkItem)
+    {
+    }
+
+    virtual void drawImplementation(osg::RenderInfo& renderInfo, const osg::Drawable* drawable) const
+    {
+        mSkinningWorkItem->waitTillDone();
+        drawable->drawImplementation(renderInfo);
+    }
+
+private:
+    osg::ref_ptr<WorkItem> mSkinningWorkItem;
+};
+
 RigGeometry::RigGeometry()
     : mSkeleton(nullptr)
+    , mSkinningWorkItems {{new SkinningWorkItem(this), new SkinningWorkItem(this)}}
     , mLastFrameNumber(0)
     , mBoundsFirstFrame(true)
 {
@@ -50,15 +173,41 @@ RigGeometry::RigGeometry(const RigGeometry &copy, const osg::CopyOp &copyop)
     , mInfluenceMap(copy.mInfluenceMap)
     , mBone2VertexVector(copy.mBone2VertexVector)
     , mBoneSphereVector(copy.mBoneSphereVector)
+    , mSkinningSource(copy.mSkinningSource)
+    , mSkinningWorkItems {{new SkinningWorkItem(this), new SkinningWorkItem(this)}}
     , mLastFrameNumber(0)
     , mBoundsFirstFrame(true)
 {
-    setSourceGeometry(copy.mSourceGeometry);
+    createGeometries(copy.mSourceGeometry);
     setNumChildrenRequiringUpdateTraversal(1);
 }
 
+RigGeometry::~RigGeometry()
+{
+    waitForSkinning();
+}
+
+void RigGeometry::setWorkQueue(osg::ref_ptr<WorkQueue> workQueue)
+{
+    sWorkQueue = workQueue;
+}
+
+void RigGeometry::waitForSkinning() const
+{
+    for (const osg::ref_ptr<SkinningWorkItem>& item : mSkinningWorkItems)
+        item->waitTillDone();
+}
+
 void RigGeometry::setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeometry)
 {
+    createGeometries(sourceGeometry);
+    initSkinningSource();
+}
+
+void RigGeometry::createGeometries(osg::ref_ptr<osg::Geometry> sourceGeometry)
+{
+    waitForSkinning();
+
     mSourceGeometry = sourceGeometry;
 
     for (unsigned int i=0; i<2; ++i)
@@ -71,6 +220,8 @@ void RigGeometry::setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeometry)
         to.setCullingActive(false); // make sure to disable culling since that's handled by this class
         to.setComputeBoundingBoxCallback(new CopyBoundingBoxCallback());
         to.setComputeBoundingSphereCallback(new CopyBoundingSphereCallback());
+        to.setDrawCallback(new WaitForSkinningCallback(mSkinningWorkItems[i]));
+        mSkinningWorkItems[i]->setGeometry(&to);
 
         // vertices and normals are modified every frame, so we need to deep copy them.
         // assign a dedicated VBO to make sure that modifications don't interfere with source geometry's VBO.
@@ -111,6 +262,39 @@ osg::ref_ptr<osg::Geometry> RigGeometry::getSourceGeometry()
     return mSourceGeometry;
 }
 
+void RigGeometry::initSkinningSource()
+{
+    mSkinningSource = nullptr;
+    if (!mSourceGeometry || !mBone2VertexVector)
+        return;
+
+    const osg::Vec3Array* positions = static_cast<const osg::Vec3Array*>(mSourceGeometry->getVertexArray());
+    const osg::Vec3Array* normals = static_cast<const osg::Vec3Array*>(mSourceGeometry->getNormalArray());
+    const osg::Vec4Array* tangents = mSourceTangents;
+
+    osg::ref_ptr<SkinningSource> source (new SkinningSource);
+    for (const auto& pair : mBone2VertexVector->mData)
+    {
+        for (unsigned short vertex : pair.second)
+        {
+            source->mVertices.push_back(vertex);
+            for (int i = 0; i < 3; ++i)
+                source->mPositions[i].push_back((*positions)[vertex][i]);
+            if (normals)
+            {
+                for (int i = 0; i < 3; ++i)
+                    source->mNormals[i].push_back((*normals)[vertex][i]);
+            }
+            if (tangents)
+            {
+                for (int i = 0; i < 4; ++i)
+                    source->mTangents[i].push_back((*tangents)[vertex][i]);
+            }
+        }
+    }
+    mSkinningSource = source;
+}
+
 bool RigGeometry::initFromParentSkeleton(osg::NodeVisitor* nv)
 {
     const osg::NodePath& path = nv->getNodePath();
@@ -192,25 +376,25 @@ void RigGeometry::cull(osg::NodeVisitor* nv)
     }
     mLastFrameNumber = traversalNumber;
     osg::Geometry& geom = *getGeometry(mLastFrameNumber);
+    SkinningWorkItem& skinning = *mSkinningWorkItems[mLastFrameNumber%2];
 
     mSkeleton->updateBoneMatrices(traversalNumber);
 
-    // skinning
-    const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
-    const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
-    const osg::Vec4Array* tangentSrc = mSourceTangents;
-
-    osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
-    osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
-    osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
+    // drawing this geometry in its last frame waited for its skinning, unless it wasn't drawn at all
+    skinning.waitTillDone();
 
+    // the matrices are computed here, so the skinning doesn't read the bones while the next update traversal moves them
+    std::vector<osg::Matrixf>& skinningMatrices = skinning.getMatrices();
+    skinningMatrices.resize(mBone2VertexVector->mData.size());
+    std::vector<osg::Matrixf>::iterator skinningMatrix = skinningMatrices.begin();
     int index = mBoneSphereVector->mData.size();
     for (auto &pair : mBone2VertexVector->mData)
     {
-        osg::Matrixf resultMat (0, 0, 0, 0,
-                                0, 0, 0, 0,
-                                0, 0, 0, 0,
-                                0, 0, 0, 1);
+        osg::Matrixf& resultMat = *skinningMatrix++;
+        resultMat.set(0, 0, 0, 0,
+                      0, 0, 0, 0,
+                      0, 0, 0, 0,
+                      0, 0, 0, 1);
 
         for (auto &weight : pair.first)
         {
@@ -224,27 +408,22 @@ void RigGeometry::cull(osg::NodeVisitor* nv)
 
         if (mGeomToSkelMatrix)
             resultMat *= (*mGeomToSkelMatrix);
+    }
 
-        for (auto &vertex : pair.second)
-        {
-            (*positionDst)[vertex] = resultMat.preMult((*positionSrc)[vertex]);
-            if (normalDst)
-                (*normalDst)[vertex] = osg::Matrixf::transform3x3((*normalSrc)[vertex], resultMat);
-
-            if (tangentDst)
-            {
-                const osg::Vec4f& srcTangent = (*tangentSrc)[vertex];
-                osg::Vec3f transformedTangent = osg::Matrixf::transform3x3(osg::Vec3f(srcTangent.x(), srcTangent.y(), srcTangent.z()), resultMat);
-                (*tangentDst)[vertex] = osg::Vec4f(transformedTangent, srcTangent.w());
-            }
-        }
+    if (sWorkQueue && mSkinningSource->mVertices.size() >= sMinWorkQueueVertices)
+    {
+        skinning.start();
+        sWorkQueue->addWorkItem(&skinning);
     }
+    else
+        skinning.skin();
 
-    positionDst->dirty();
-    if (normalDst)
-        normalDst->dirty();
-    if (tangentDst)
-        tangentDst->dirty();
+    // the arrays are uploaded when the geometry is drawn, which waits for the skinning
+    geom.getVertexArray()->dirty();
+    if (geom.getNormalArray())
+        geom.getNormalArray()->dirty();
+    if (osg::Array* tangents = geom.getTexCoordArray(7))
+        tangents->dirty();
 
 #if OSG_MIN_VERSION_REQUIRED(3, 5, 6)
     geom.dirtyGLObjects();
@@ -255,6 +434,31 @@ void RigGeometry::cull(osg::NodeVisitor* nv)
     nv->popFromNodePath();
 }
 
+void RigGeometry::skin(osg::Geometry& geom, const std::vector<osg::Matrixf>& skinningMatrices) const
+{
+    const SkinningSource& source = *mSkinningSource;
+
+    osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
+    osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
+    osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
+
+    std::size_t begin = 0;
+    std::vector<osg::Matrixf>::const_iterator skinningMatrix = skinningMatrices.begin();
+    for (auto &pair : mBone2VertexVector->mData)
+    {
+        const osg::Matrixf& resultMat = *skinningMatrix++;
+        const std::size_t end = begin + pair.second.size();
+
+        transformPoints(resultMat, source.mPositions, source.mVertices, begin, end, *positionDst);
+        if (normalDst)
+            transformVectors(resultMat, source.mNormals, source.mVertices, begin, end, *normalDst);
+        if (tangentDst)
+            transformTangents(resultMat, source.mTangents, source.mVertices, begin, end, *tangentDst);
+
+        begin = end;
+    }
+}
+
 void RigGeometry::updateBounds(osg::NodeVisitor *nv)
 {
     if (!mSkeleton)
@@ -364,6 +568,8 @@ void RigGeometry::setInfluenceMap(osg::ref_ptr<InfluenceMap> influenceMap)
 
     mBone2VertexVector->mData.reserve(bone2VertexMap.size());
     mBone2VertexVector->mData.assign(bone2VertexMap.begin(), bone2VertexMap.end());
+
+    initSkinningSource();
 }
 
 void RigGeometry::accept(osg::NodeVisitor &nv)
@@ -385,6 +591,7 @@ void RigGeometry::accept(osg::NodeVisitor &nv)
 
 void RigGeometry::accept(osg::PrimitiveFunctor& func) const
 {
+    mSkinningWorkItems[mLastFrameNumber%2]->waitTillDone();
     getGeometry(mLastFrameNumber)->accept(func);
 }
 
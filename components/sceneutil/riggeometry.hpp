@@ -4,16 +4,20 @@
 #include <osg/Geometry>
 #include <osg/Matrixf>
 
+#include <array>
+
 namespace SceneUtil
 {
     class Skeleton;
     class Bone;
+    class WorkQueue;
 
     /// @brief Mesh skinning implementation.
     /// @note A RigGeometry may be attached directly to a Skeleton, or somewhere below a Skeleton.
     /// Note though that the RigGeometry ignores any transforms below the Skeleton, so the attachment point is not that important.
     /// @note The internal Geometry used for rendering is double buffered, this allows updates to be done in a thread safe way while
     /// not compromising rendering performance. This is crucial when using osg's default threading model of DrawThreadPerContext.
+    /// @note Skinning may be done on a WorkQueue, see setWorkQueue().
     class RigGeometry : public osg::Drawable
     {
     public:
@@ -46,6 +50,14 @@ namespace SceneUtil
 
         osg::ref_ptr<osg::Geometry> getSourceGeometry();
 
+        /// Skin all RigGeometries on this work queue instead of the cull thread, or on the cull thread if nullptr.
+        /// @par The cull traversal hands the skinning over to the queue, and drawing the geometry waits until it is done.
+        /// @note Not thread safe, set it before any RigGeometry is culled.
+        static void setWorkQueue(osg::ref_ptr<WorkQueue> workQueue);
+
+        /// Wait until the skinning of both buffered geometries is done.
+        void waitForSkinning() const;
+
         virtual void accept(osg::NodeVisitor &nv);
         virtual bool supports(const osg::PrimitiveFunctor&) const { return true; }
         virtual void accept(osg::PrimitiveFunctor&) const;
@@ -64,10 +76,19 @@ namespace SceneUtil
             virtual osg::BoundingSphere computeBound(const osg::Node&) const override { return boundingSphere; }
         };
 
+    protected:
+        virtual ~RigGeometry();
+
     private:
         void cull(osg::NodeVisitor* nv);
         void updateBounds(osg::NodeVisitor* nv);
 
+        void createGeometries(osg::ref_ptr<osg::Geometry> sourceGeometry);
+        void initSkinningSource();
+
+        /// Transform the source vertices into \a geom by the weighted bone matrix of each vertex group in mBone2VertexVector.
+        void skin(osg::Geometry& geom, const std::vector<osg::Matrixf>& skinningMatrices) const;
+
         osg::ref_ptr<osg::Geometry> mGeometry[2];
         osg::Geometry* getGeometry(unsigned int frame) const;
 
@@ -100,6 +121,20 @@ namespace SceneUtil
         osg::ref_ptr<BoneSphereVector> mBoneSphereVector;
         std::vector<Bone*> mBoneNodesVector;
 
+        /// Source vertex data in the order of mBone2VertexVector, with a separate array per coordinate.
+        struct SkinningSource : public osg::Referenced
+        {
+            std::vector<unsigned short> mVertices;
+            std::vector<float> mPositions[3];
+            std::vector<float> mNormals[3];
+            std::vector<float> mTangents[4];
+        };
+        osg::ref_ptr<SkinningSource> mSkinningSource;
+
+        class SkinningWorkItem;
+        /// One per buffered geometry, each with the matrices computed by the cull traversal of its frame.
+        std::array<osg::ref_ptr<SkinningWorkItem>, 2> mSkinningWorkItems;
+
         unsigned int mLastFrameNumber;
         bool mBoundsFirstFrame;
 
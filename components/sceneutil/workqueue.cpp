@@ -52,14 +52,21 @@ WorkQueue::WorkQueue(int workerThreads)
 
 WorkQueue::~WorkQueue()
 {
+    std::deque<osg::ref_ptr<WorkItem> > dropped;
     {
         OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
-        while (!mQueue.empty())
-            mQueue.pop_back();
+        dropped.swap(mQueue);
         mIsReleased = true;
         mCondition.broadcast();
     }
 
+    // the items are never going to be done, don't leave anyone waiting for them
+    for (const osg::ref_ptr<WorkItem>& item : dropped)
+    {
+        item->abort();
+        item->signalDone();
+    }
+
     for (unsigned int i=0; i<mThreads.size(); ++i)
     {
         mThreads[i]->join();
@@ -106,6 +113,11 @@ unsigned int WorkQueue::getNumItems() const
     return mQueue.size();
 }
 
+unsigned int WorkQueue::getNumThreads() const
+{
+    return mThreads.size();
+}
+
 unsigned int WorkQueue::getNumActiveThreads() const
 {
     unsigned int count = 0;
@@ -50,6 +50,8 @@ namespace SceneUtil
     {
     public:
         WorkQueue(int numWorkerThreads=1);
+
+        /// Items that are not started yet are aborted and signalled done without doing their work.
         ~WorkQueue();
 
         /// Add a new work item to the back of the queue.
@@ -64,6 +66,8 @@ namespace SceneUtil
 
         unsigned int getNumItems() const;
 
+        unsigned int getNumThreads() const;
+
         unsigned int getNumActiveThreads() const;
 
     private:
@@ -3,6 +3,8 @@
 
 #include <tuple>
 
+#include <osg/Vec2f>
+
 #include <components/resource/resourcemanager.hpp>
 
 #include "buffercache.hpp"
@@ -16,6 +18,15 @@ namespace osg
 namespace Resource
 {
     class SceneManager;
+
+    template <>
+    struct ObjectCacheShard<osg::Vec2f>
+    {
+        static std::size_t get(const osg::Vec2f& key)
+        {
+            return std::hash<float>()(key.x()) * 31 + std::hash<float>()(key.y());
+        }
+    };
 }
 
 namespace Terrain
@@ -16,6 +16,14 @@ namespace VFS
         virtual Files::IStreamPtr open() = 0;
     };
 
+    struct ArchiveCacheStats
+    {
+        std::size_t mHits = 0;
+        std::size_t mMisses = 0;
+        /// Size of the decompressed files in the caches, in bytes.
+        std::size_t mSize = 0;
+    };
+
     class Archive
     {
     public:
@@ -23,6 +31,12 @@ namespace VFS
 
         /// List all resources contained in this archive, and run the resource names through the given normalize function.
         virtual void listResources(std::map<std::string, File*>& out, char (*normalize_function) (char)) = 0;
+
+        /// Keep up to \a size bytes of recently decompressed files in memory, if files in this archive are compressed.
+        virtual void setCacheSize(std::size_t size) {}
+
+        /// Add the statistics of the cache of decompressed files to \a stats.
+        virtual void getCacheStats(ArchiveCacheStats& stats) const {}
     };
 
 }
@@ -6,14 +6,17 @@ namespace VFS
 {
 
 BsaArchive::BsaArchive(const std::string &filename)
+    : mCompressedFile(nullptr)
 {
     Bsa::BsaVersion bsaVersion = Bsa::CompressedBSAFile::detectVersion(filename);
 
     if (bsaVersion == Bsa::BSAVER_COMPRESSED) {
-        mFile = std::make_unique<Bsa::CompressedBSAFile>(Bsa::CompressedBSAFile());
+        std::unique_ptr<Bsa::CompressedBSAFile> compressedFile = std::make_unique<Bsa::CompressedBSAFile>();
+        mCompressedFile = compressedFile.get();
+        mFile = std::move(compressedFile);
     }
     else {
-        mFile = std::make_unique<Bsa::BSAFile>(Bsa::BSAFile());
+        mFile = std::make_unique<Bsa::BSAFile>();
     }
 
     mFile->open(filename);
@@ -39,6 +42,22 @@ void BsaArchive::listResources(std::map<std::string, File *> &out, char (*normal
     }
 }
 
+void BsaArchive::setCacheSize(std::size_t size)
+{
+    if (mCompressedFile)
+        mCompressedFile->setCacheSize(size);
+}
+
+void BsaArchive::getCacheStats(ArchiveCacheStats& stats) const
+{
+    if (!mCompressedFile)
+        return;
+    const Bsa::CompressedBSAFile::CacheStats fileStats = mCompressedFile->getCacheStats();
+    stats.mHits += fileStats.mHits;
+    stats.mMisses += fileStats.mMisses;
+    stats.mSize += fileStats.mSize;
+}
+
 // ------------------------------------------------------------------------------
 
 BsaArchiveFile::BsaArchiveFile(const Bsa::BSAFile::FileStruct *info, Bsa::BSAFile* bsa)
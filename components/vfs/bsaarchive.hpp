@@ -5,6 +5,11 @@
 
 #include <components/bsa/bsa_file.hpp>
 
+namespace Bsa
+{
+    class CompressedBSAFile;
+}
+
 namespace VFS
 {
     class BsaArchiveFile : public File
@@ -25,8 +30,14 @@ namespace VFS
         virtual ~BsaArchive();
         virtual void listResources(std::map<std::string, File*>& out, char (*normalize_function) (char));
 
+        virtual void setCacheSize(std::size_t size);
+
+        virtual void getCacheStats(ArchiveCacheStats& stats) const;
+
     private:
         std::unique_ptr<Bsa::BSAFile> mFile;
+        /// mFile, if it is a compressed archive
+        Bsa::CompressedBSAFile* mCompressedFile;
         std::vector<BsaArchiveFile> mResources;
     };
 }
@@ -2,6 +2,7 @@
 
 #include <stdexcept>
 
+#include <components/misc/hash.hpp>
 #include <components/misc/stringops.hpp>
 
 #include "archive.hpp"
@@ -32,6 +33,7 @@ namespace VFS
 
     Manager::Manager(bool strict)
         : mStrict(strict)
+        , mArchiveCacheSize(0)
     {
 
     }
@@ -44,6 +46,8 @@ namespace VFS
     void Manager::reset()
     {
         mIndex.clear();
+        mHashIndex.clear();
+        mNames.clear();
         for (std::vector<Archive*>::iterator it = mArchives.begin(); it != mArchives.end(); ++it)
             delete *it;
         mArchives.clear();
@@ -52,6 +56,20 @@ namespace VFS
     void Manager::addArchive(Archive *archive)
     {
         mArchives.push_back(archive);
+        archive->setCacheSize(mArchiveCacheSize);
+    }
+
+    void Manager::setArchiveCacheSize(std::size_t size)
+    {
+        mArchiveCacheSize = size;
+        for (std::vector<Archive*>::const_iterator it = mArchives.begin(); it != mArchives.end(); ++it)
+            (*it)->setCacheSize(size);
+    }
+
+    void Manager::getArchiveCacheStats(ArchiveCacheStats& stats) const
+    {
+        for (std::vector<Archive*>::const_iterator it = mArchives.begin(); it != mArchives.end(); ++it)
+            (*it)->getCacheStats(stats);
     }
 
     void Manager::buildIndex()
@@ -60,30 +78,106 @@ namespace VFS
 
         for (std::vector<Archive*>::const_iterator it = mArchives.begin(); it != mArchives.end(); ++it)
             (*it)->listResources(mIndex, mStrict ? &strict_normalize_char : &nonstrict_normalize_char);
+
+        // keep the load factor at or below 1/2 so that probe sequences stay short
+        std::size_t capacity = 16;
+        while (capacity < mIndex.size() * 2)
+            capacity *= 2;
+
+        std::size_t namesSize = 0;
+        for (const auto& entry : mIndex)
+            namesSize += entry.first.size();
+
+        mHashIndex.assign(capacity, HashEntry {0, 0, 0, nullptr});
+        mNames.clear();
+        mNames.reserve(namesSize);
+
+        const std::size_t mask = capacity - 1;
+        for (const auto& entry : mIndex)
+        {
+            const std::string& name = entry.first;
+
+            Misc::Hash nameHash;
+            nameHash.add(name.data(), name.size());
+            const std::uint64_t hash = nameHash.getValue();
+
+            std::size_t slot = hash & mask;
+            while (mHashIndex[slot].mFile != nullptr)
+                slot = (slot + 1) & mask;
+
+            HashEntry& hashEntry = mHashIndex[slot];
+            hashEntry.mHash = hash;
+            hashEntry.mNameOffset = static_cast<std::uint32_t>(mNames.size());
+            hashEntry.mNameSize = static_cast<std::uint32_t>(name.size());
+            hashEntry.mFile = entry.second;
+
+            mNames.insert(mNames.end(), name.begin(), name.end());
+        }
+    }
+
+    File* Manager::lookup(const char* name, std::size_t size) const
+    {
+        if (mHashIndex.empty())
+            return nullptr;
+
+        char (*normalize_char)(char) = mStrict ? &strict_normalize_char : &nonstrict_normalize_char;
+
+        Misc::Hash nameHash;
+        for (std::size_t i = 0; i < size; ++i)
+            nameHash.add(normalize_char(name[i]));
+        const std::uint64_t hash = nameHash.getValue();
+
+        const std::size_t mask = mHashIndex.size() - 1;
+        for (std::size_t slot = hash & mask; mHashIndex[slot].mFile != nullptr; slot = (slot + 1) & mask)
+        {
+            const HashEntry& entry = mHashIndex[slot];
+            if (entry.mHash != hash || entry.mNameSize != size)
+                continue;
+
+            const char* stored = mNames.data() + entry.mNameOffset;
+            std::size_t i = 0;
+            while (i < size && stored[i] == normalize_char(name[i]))
+                ++i;
+            if (i == size)
+                return entry.mFile;
+        }
+
+        return nullptr;
     }
 
     Files::IStreamPtr Manager::get(const std::string &name) const
     {
-        std::string normalized = name;
-        normalize_path(normalized, mStrict);
+        return get(name.data(), name.size());
+    }
 
-        return getNormalized(normalized);
+    Files::IStreamPtr Manager::get(const char* name, std::size_t size) const
+    {
+        File* file = lookup(name, size);
+        if (!file)
+        {
+            std::string normalized(name, size);
+            normalize_path(normalized, mStrict);
+            throw std::runtime_error("Resource '" + normalized + "' not found");
+        }
+        return file->open();
     }
 
     Files::IStreamPtr Manager::getNormalized(const std::string &normalizedName) const
     {
-        std::map<std::string, File*>::const_iterator found = mIndex.find(normalizedName);
-        if (found == mIndex.end())
+        File* file = lookup(normalizedName.data(), normalizedName.size());
+        if (!file)
             throw std::runtime_error("Resource '" + normalizedName + "' not found");
-        return found->second->open();
+        return file->open();
     }
 
     bool Manager::exists(const std::string &name) const
     {
-        std::string normalized = name;
-        normalize_path(normalized, mStrict);
+        return lookup(name.data(), name.size()) != nullptr;
+    }
 
-        return mIndex.find(normalized) != mIndex.end();
+    bool Manager::exists(const char* name, std::size_t size) const
+    {
+        return lookup(name, size) != nullptr;
     }
 
     const std::map<std::string, File*>& Manager::getIndex() const
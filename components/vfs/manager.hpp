@@ -3,6 +3,7 @@
 
 #include <components/files/constrainedfilestream.hpp>
 
+#include <cstdint>
 #include <vector>
 #include <map>
 
@@ -11,6 +12,7 @@ namespace VFS
 
     class Archive;
     class File;
+    struct ArchiveCacheStats;
 
     /// @brief The main class responsible for loading files from a virtual file system.
     /// @par Various archive types (e.g. directories on the filesystem, or compressed archives)
@@ -36,11 +38,26 @@ namespace VFS
         /// Build the file index. Should be called when all archives have been registered.
         void buildIndex();
 
+        /// Keep up to \a size bytes of recently decompressed files in memory for each compressed archive.
+        /// 0 (the default) disables these caches.
+        void setArchiveCacheSize(std::size_t size);
+
+        std::size_t getArchiveCacheSize() const { return mArchiveCacheSize; }
+
+        /// Sum up the statistics of the caches of decompressed files of all archives.
+        /// @note May be called from any thread.
+        void getArchiveCacheStats(ArchiveCacheStats& stats) const;
+
         /// Does a file with this name exist?
         /// @note May be called from any thread once the index has been built.
         bool exists(const std::string& name) const;
 
-        /// Get a complete list of files from all archives
+        /// Does a file with this name exist?
+        /// @param name Not necessarily null-terminated, normalization is done on the fly without allocating.
+        /// @note May be called from any thread once the index has been built.
+        bool exists(const char* name, std::size_t size) const;
+
+        /// Get a complete list of files from all archives, sorted by normalized name
         /// @note May be called from any thread once the index has been built.
         const std::map<std::string, File*>& getIndex() const;
 
@@ -53,6 +70,12 @@ namespace VFS
         /// @note May be called from any thread once the index has been built.
         Files::IStreamPtr get(const std::string& name) const;
 
+        /// Retrieve a file by name.
+        /// @param name Not necessarily null-terminated, normalization is done on the fly without allocating.
+        /// @note Throws an exception if the file can not be found.
+        /// @note May be called from any thread once the index has been built.
+        Files::IStreamPtr get(const char* name, std::size_t size) const;
+
         /// Retrieve a file by name (name is already normalized).
         /// @note Throws an exception if the file can not be found.
         /// @note May be called from any thread once the index has been built.
@@ -63,7 +86,27 @@ namespace VFS
 
         std::vector<Archive*> mArchives;
 
+        std::size_t mArchiveCacheSize;
+
         std::map<std::string, File*> mIndex;
+
+        /// Find a file by name, normalizing the name on the fly. Returns nullptr if not found.
+        File* lookup(const char* name, std::size_t size) const;
+
+        struct HashEntry
+        {
+            std::uint64_t mHash;
+            std::uint32_t mNameOffset;
+            std::uint32_t mNameSize;
+            File* mFile; ///< nullptr marks an empty slot
+        };
+
+        /// Open addressing hash table with linear probing over the normalized names of mIndex,
+        /// the size is always a power of two.
+        std::vector<HashEntry> mHashIndex;
+
+        /// Normalized names referenced by mHashIndex, stored back to back.
+        std::vector<char> mNames;
     };
 
 }